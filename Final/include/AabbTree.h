@@ -0,0 +1,256 @@
+/**
+ * @file AabbTree.h
+ * @brief Dynamic bounding volume hierarchy over axis-aligned boxes
+ */
+#ifndef AABB_TREE_H
+#define AABB_TREE_H
+
+#include "Vector2D.h"
+#include <algorithm>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+/**
+ * @struct BasicAabb
+ * @brief Axis-aligned box given by its min and max corners
+ */
+template <typename Scalar>
+struct BasicAabb {
+    using Vec = BasicVector2D<Scalar>;
+
+    Vec min;
+    Vec max;
+
+    static BasicAabb fromSegment(const Vec& a, const Vec& b) {
+        return {Vec(std::min(a.x, b.x), std::min(a.y, b.y)), Vec(std::max(a.x, b.x), std::max(a.y, b.y))};
+    }
+    static BasicAabb fromCircle(const Vec& center, Scalar radius) {
+        return {Vec(center.x - radius, center.y - radius), Vec(center.x + radius, center.y + radius)};
+    }
+
+    BasicAabb merged(const BasicAabb& other) const {
+        return {Vec(std::min(min.x, other.min.x), std::min(min.y, other.min.y)),
+                Vec(std::max(max.x, other.max.x), std::max(max.y, other.max.y))};
+    }
+    Scalar perimeter() const {
+        return Scalar(2) * ((max.x - min.x) + (max.y - min.y));
+    }
+    bool overlaps(const BasicAabb& other) const {
+        return min.x <= other.max.x && other.min.x <= max.x &&
+               min.y <= other.max.y && other.min.y <= max.y;
+    }
+    // Squared distance from a point to the box (0 inside)
+    Scalar distanceSquaredTo(const Vec& point) const {
+        Scalar dx = std::max(std::max(min.x - point.x, point.x - max.x), Scalar(0));
+        Scalar dy = std::max(std::max(min.y - point.y, point.y - max.y), Scalar(0));
+        return dx * dx + dy * dy;
+    }
+    // Does origin + t * delta enter the box for some t in [0, maxFraction]?
+    bool isHitByRay(const Vec& origin, const Vec& delta, Scalar maxFraction) const;
+};
+
+/**
+ * @class BasicAabbTree
+ * @brief Binary tree of boxes whose leaves carry a caller-chosen value
+ *
+ * Leaves are inserted incrementally (cheapest-sibling descent on the
+ * perimeter heuristic) and can be moved with update(), which only stores
+ * the new leaf box. refit() then recomputes every internal box in one
+ * bottom-up pass. Moving leaves this way never restructures the tree, so
+ * refit() also measures how much the internal boxes have grown since the
+ * last rebuild and rebuilds top-down (median split on the longer axis)
+ * once the tree has degraded past kRebuildRatio.
+ *
+ * Queries walk the tree with a fixed-size stack and allocate nothing; the
+ * exact test against the object behind a leaf is left to the callback.
+ */
+template <typename Scalar>
+class BasicAabbTree {
+public:
+    using Vec = BasicVector2D<Scalar>;
+    using Aabb = BasicAabb<Scalar>;
+
+    static constexpr int32_t kNullNode = -1;
+    static constexpr double kRebuildRatio = 1.5;   // Internal perimeter growth that triggers rebuild()
+
+    explicit BasicAabbTree(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    // Leaves (the returned id stays valid until the leaf is removed or clear() is called)
+    int32_t insert(uint32_t value, const Aabb& box);
+    void remove(int32_t leaf);
+    void update(int32_t leaf, const Aabb& box);    // Takes effect for queries after refit()
+    void clear();
+
+    // Recompute the internal boxes after update(); rebuilds if the tree has degraded
+    void refit();
+    void rebuild();
+
+    // Call visit(value) for every leaf whose box overlaps the given box
+    template <typename Visitor>
+    void query(const Aabb& box, Visitor&& visit) const;
+
+    // Leaf closest to point. distance(value) returns the exact distance to the
+    // object behind a leaf; leaves whose box is farther than the best so far are
+    // skipped. Returns false if the tree is empty.
+    template <typename DistanceFunction>
+    bool findClosest(const Vec& point, DistanceFunction&& distance, uint32_t& closestValue,
+                     Scalar& closestDistance) const;
+
+    // Cast the segment from -> to. hit(value, maxFraction) returns the fraction
+    // (0..1 along the segment) at which the object behind a leaf is hit, or
+    // maxFraction if it is missed; later leaves are clipped to the nearest hit.
+    // Returns the nearest hit fraction (1 if nothing was hit before 'to').
+    template <typename HitFunction>
+    Scalar rayCast(const Vec& from, const Vec& to, HitFunction&& hit) const;
+
+    // Getters
+    size_t size() const;
+    Scalar getDegradation() const;    // Internal perimeter relative to the last rebuild
+    const Aabb& getLeafBox(int32_t leaf) const;
+    uint32_t getLeafValue(int32_t leaf) const;
+
+private:
+    static constexpr int32_t kMaxHeight = 64;      // Deeper trees are rebuilt on insert
+    static constexpr int32_t kStackSize = kMaxHeight + 2;
+
+    struct Node {
+        Aabb box;
+        int32_t parent;
+        int32_t left;       // kNullNode for leaves
+        int32_t right;
+        uint32_t value;     // Leaves only
+        bool isLeaf() const { return left == kNullNode; }
+    };
+
+    int32_t allocateNode();
+    void freeNode(int32_t node);
+    int32_t buildTopDown(int32_t* leaves, size_t count, int32_t parent);
+    Scalar internalPerimeter() const;
+
+    std::pmr::vector<Node> nodes;
+    std::pmr::vector<int32_t> freeNodes;
+    std::pmr::vector<int32_t> scratch;      // Leaf list / traversal order for rebuild() and refit()
+    int32_t root;
+    size_t leafCount;
+    Scalar rebuiltPerimeter;                // internalPerimeter() right after the last rebuild
+    Scalar currentPerimeter;                // ... after the last refit()
+};
+
+template <typename Scalar>
+bool BasicAabb<Scalar>::isHitByRay(const Vec& origin, const Vec& delta, Scalar maxFraction) const {
+    // Slab test, one axis at a time
+    Scalar enter = Scalar(0);
+    Scalar exit = maxFraction;
+    const Scalar origins[2] = {origin.x, origin.y};
+    const Scalar deltas[2] = {delta.x, delta.y};
+    const Scalar mins[2] = {min.x, min.y};
+    const Scalar maxs[2] = {max.x, max.y};
+    for (int axis = 0; axis < 2; axis++) {
+        if (deltas[axis] == Scalar(0)) {
+            if (origins[axis] < mins[axis] || origins[axis] > maxs[axis]) {
+                return false;
+            }
+            continue;
+        }
+        Scalar inverse = Scalar(1) / deltas[axis];
+        Scalar t1 = (mins[axis] - origins[axis]) * inverse;
+        Scalar t2 = (maxs[axis] - origins[axis]) * inverse;
+        enter = std::max(enter, std::min(t1, t2));
+        exit = std::min(exit, std::max(t1, t2));
+        if (enter > exit) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Scalar>
+template <typename Visitor>
+void BasicAabbTree<Scalar>::query(const Aabb& box, Visitor&& visit) const {
+    int32_t stack[kStackSize];
+    int32_t top = 0;
+    if (root != kNullNode) {
+        stack[top++] = root;
+    }
+    while (top > 0) {
+        const Node& node = nodes[stack[--top]];
+        if (!node.box.overlaps(box)) {
+            continue;
+        }
+        if (node.isLeaf()) {
+            visit(node.value);
+        } else {
+            stack[top++] = node.left;
+            stack[top++] = node.right;
+        }
+    }
+}
+
+template <typename Scalar>
+template <typename DistanceFunction>
+bool BasicAabbTree<Scalar>::findClosest(const Vec& point, DistanceFunction&& distance, uint32_t& closestValue,
+                                        Scalar& closestDistance) const {
+    if (root == kNullNode) {
+        return false;
+    }
+
+    bool found = false;
+    int32_t stack[kStackSize];
+    int32_t top = 0;
+    stack[top++] = root;
+    while (top > 0) {
+        const Node& node = nodes[stack[--top]];
+        if (found && node.box.distanceSquaredTo(point) >= closestDistance * closestDistance) {
+            continue;
+        }
+        if (node.isLeaf()) {
+            Scalar d = distance(node.value);
+            if (!found || d < closestDistance) {
+                found = true;
+                closestValue = node.value;
+                closestDistance = d;
+            }
+            continue;
+        }
+        // Push the farther child first so the nearer one is searched first
+        Scalar leftDistance = nodes[node.left].box.distanceSquaredTo(point);
+        Scalar rightDistance = nodes[node.right].box.distanceSquaredTo(point);
+        bool leftFirst = leftDistance <= rightDistance;
+        stack[top++] = leftFirst ? node.right : node.left;
+        stack[top++] = leftFirst ? node.left : node.right;
+    }
+    return found;
+}
+
+template <typename Scalar>
+template <typename HitFunction>
+Scalar BasicAabbTree<Scalar>::rayCast(const Vec& from, const Vec& to, HitFunction&& hit) const {
+    Vec delta = to - from;
+    Scalar maxFraction = Scalar(1);
+
+    int32_t stack[kStackSize];
+    int32_t top = 0;
+    if (root != kNullNode) {
+        stack[top++] = root;
+    }
+    while (top > 0) {
+        const Node& node = nodes[stack[--top]];
+        if (!node.box.isHitByRay(from, delta, maxFraction)) {
+            continue;
+        }
+        if (node.isLeaf()) {
+            maxFraction = std::min(maxFraction, hit(node.value, maxFraction));
+        } else {
+            stack[top++] = node.left;
+            stack[top++] = node.right;
+        }
+    }
+    return maxFraction;
+}
+
+// Simulation precision (see Precision.h)
+using Aabb = BasicAabb<Real>;
+using AabbTree = BasicAabbTree<Real>;
+
+#endif // AABB_TREE_H
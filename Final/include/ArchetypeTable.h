@@ -0,0 +1,221 @@
+/**
+ * @file ArchetypeTable.h
+ * @brief Chunked component storage for entities that share one set of components
+ */
+#ifndef ARCHETYPE_TABLE_H
+#define ARCHETYPE_TABLE_H
+
+#include "Handle.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory_resource>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @class ArchetypeTable
+ * @brief Entities with the same components, packed into fixed-size chunks
+ *
+ * A chunk holds kChunkCapacity entities as one array per component, laid
+ * out back to back in a single allocation from the table's memory
+ * resource. Entities are packed: entity i lives at slot i % kChunkCapacity
+ * of chunk i / kChunkCapacity, and destroying one moves the last entity
+ * into its place. A system reads only the component arrays it asks for,
+ * chunk by chunk (forEachChunk), so a pass over many entities streams
+ * through contiguous memory instead of chasing a pointer per entity.
+ *
+ * Handles go through a slot table (index + generation) to the packed
+ * position, as HandlePool's do. Components must be trivially copyable.
+ */
+template <typename Tag, typename... Components>
+class ArchetypeTable {
+    static_assert(sizeof...(Components) > 0, "an archetype needs at least one component");
+    static_assert((std::is_trivially_copyable_v<Components> && ...), "components are moved with memcpy");
+
+public:
+    static constexpr size_t kChunkCapacity = 256;
+
+    explicit ArchetypeTable(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : chunks(resource), denseToSlot(resource), slotToDense(resource), slotGenerations(resource),
+          freeSlots(resource), count(0) {}
+
+    ~ArchetypeTable() {
+        std::pmr::polymorphic_allocator<std::byte> allocator(chunks.get_allocator());
+        for (std::byte* chunk : chunks) {
+            allocator.deallocate_bytes(chunk, kChunkBytes, kChunkAlignment);
+        }
+    }
+
+    ArchetypeTable(const ArchetypeTable&) = delete;
+    ArchetypeTable& operator=(const ArchetypeTable&) = delete;
+
+    Handle<Tag> create(const Components&... components) {
+        uint32_t slot;
+        if (!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            slot = static_cast<uint32_t>(slotToDense.size());
+            slotToDense.push_back(kNoDense);
+            slotGenerations.push_back(1);
+        }
+        if (count == chunks.size() * kChunkCapacity) {
+            std::pmr::polymorphic_allocator<std::byte> allocator(chunks.get_allocator());
+            chunks.push_back(static_cast<std::byte*>(allocator.allocate_bytes(kChunkBytes, kChunkAlignment)));
+        }
+
+        size_t index = count++;
+        (std::memcpy(&get<Components>(index), &components, sizeof(Components)), ...);
+        slotToDense[slot] = static_cast<uint32_t>(index);
+        denseToSlot.push_back(slot);
+        return Handle<Tag>{slot, slotGenerations[slot]};
+    }
+
+    bool destroy(Handle<Tag> handle) {
+        if (!contains(handle)) {
+            return false;
+        }
+
+        // Move the last entity into the hole
+        size_t index = slotToDense[handle.index];
+        size_t last = count - 1;
+        if (index != last) {
+            (std::memcpy(&get<Components>(index), &get<Components>(last), sizeof(Components)), ...);
+            denseToSlot[index] = denseToSlot[last];
+            slotToDense[denseToSlot[index]] = static_cast<uint32_t>(index);
+        }
+        denseToSlot.pop_back();
+        count--;
+
+        // Retire the slot
+        slotToDense[handle.index] = kNoDense;
+        uint32_t& generation = slotGenerations[handle.index];
+        generation = (generation == UINT32_MAX) ? 1 : generation + 1;
+        freeSlots.push_back(handle.index);
+        return true;
+    }
+
+    bool contains(Handle<Tag> handle) const {
+        return handle.index < slotToDense.size() && slotGenerations[handle.index] == handle.generation &&
+               slotToDense[handle.index] != kNoDense;
+    }
+
+    // Packed index, size() if not contained
+    size_t getIndex(Handle<Tag> handle) const {
+        return contains(handle) ? slotToDense[handle.index] : count;
+    }
+
+    Handle<Tag> handleAt(size_t index) const {
+        uint32_t slot = denseToSlot[index];
+        return Handle<Tag>{slot, slotGenerations[slot]};
+    }
+
+    size_t size() const { return count; }
+    size_t getChunkCount() const { return (count + kChunkCapacity - 1) / kChunkCapacity; }
+
+    // One component of the entity at a packed index (index < size())
+    template <typename C>
+    C& get(size_t index) {
+        return getArray<C>(index / kChunkCapacity)[index % kChunkCapacity];
+    }
+
+    template <typename C>
+    const C& get(size_t index) const {
+        return getArray<C>(index / kChunkCapacity)[index % kChunkCapacity];
+    }
+
+    // A chunk's array of one component (kChunkCapacity entries, the first
+    // getChunkSize(chunk) of them live)
+    template <typename C>
+    C* getArray(size_t chunk) {
+        static_assert(kIndexOf<C> < sizeof...(Components), "not a component of this archetype");
+        return std::launder(reinterpret_cast<C*>(chunks[chunk] + kOffsets[kIndexOf<C>]));
+    }
+
+    template <typename C>
+    const C* getArray(size_t chunk) const {
+        static_assert(kIndexOf<C> < sizeof...(Components), "not a component of this archetype");
+        return std::launder(reinterpret_cast<const C*>(chunks[chunk] + kOffsets[kIndexOf<C>]));
+    }
+
+    size_t getChunkSize(size_t chunk) const {
+        return std::min(kChunkCapacity, count - chunk * kChunkCapacity);
+    }
+
+    // Call visit(entityCount, Selected*...) once per chunk, in packed order
+    template <typename... Selected, typename Visitor>
+    void forEachChunk(Visitor&& visit) {
+        forEachChunk<Selected...>(0, getChunkCount(), visit);
+    }
+
+    template <typename... Selected, typename Visitor>
+    void forEachChunk(Visitor&& visit) const {
+        forEachChunk<Selected...>(0, getChunkCount(), visit);
+    }
+
+    // The same over chunks [firstChunk, lastChunk), so disjoint ranges can
+    // be visited on different threads
+    template <typename... Selected, typename Visitor>
+    void forEachChunk(size_t firstChunk, size_t lastChunk, Visitor&& visit) {
+        for (size_t chunk = firstChunk; chunk < lastChunk; chunk++) {
+            visit(getChunkSize(chunk), getArray<Selected>(chunk)...);
+        }
+    }
+
+    template <typename... Selected, typename Visitor>
+    void forEachChunk(size_t firstChunk, size_t lastChunk, Visitor&& visit) const {
+        for (size_t chunk = firstChunk; chunk < lastChunk; chunk++) {
+            visit(getChunkSize(chunk), getArray<Selected>(chunk)...);
+        }
+    }
+
+private:
+    static constexpr uint32_t kNoDense = UINT32_MAX;
+
+    template <typename C>
+    static constexpr size_t findIndex() {
+        constexpr bool matches[] = {std::is_same_v<C, Components>...};
+        size_t found = sizeof...(Components);
+        for (size_t i = 0; i < sizeof...(Components); i++) {
+            if (matches[i]) {
+                found = i;
+            }
+        }
+        return found;
+    }
+
+    template <typename C>
+    static constexpr size_t kIndexOf = findIndex<C>();
+
+    // Byte offset of each component array within a chunk, then the chunk's size
+    static constexpr std::array<size_t, sizeof...(Components) + 1> computeOffsets() {
+        constexpr size_t sizes[] = {sizeof(Components)...};
+        constexpr size_t alignments[] = {alignof(Components)...};
+        std::array<size_t, sizeof...(Components) + 1> offsets{};
+        size_t offset = 0;
+        for (size_t i = 0; i < sizeof...(Components); i++) {
+            size_t alignment = std::max<size_t>(alignments[i], 64);   // Each array starts on a cache line
+            offset = (offset + alignment - 1) / alignment * alignment;
+            offsets[i] = offset;
+            offset += sizes[i] * kChunkCapacity;
+        }
+        offsets.back() = (offset + 63) / 64 * 64;
+        return offsets;
+    }
+
+    static constexpr std::array<size_t, sizeof...(Components) + 1> kOffsets = computeOffsets();
+    static constexpr size_t kChunkAlignment = std::max({size_t(64), alignof(Components)...});
+    static constexpr size_t kChunkBytes = kOffsets.back();
+
+    std::pmr::vector<std::byte*> chunks;
+    std::pmr::vector<uint32_t> denseToSlot;
+
+    // Slot table behind the handles
+    std::pmr::vector<uint32_t> slotToDense;
+    std::pmr::vector<uint32_t> slotGenerations;
+    std::pmr::vector<uint32_t> freeSlots;
+    size_t count;
+};
+
+#endif // ARCHETYPE_TABLE_H
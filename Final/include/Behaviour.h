@@ -0,0 +1,227 @@
+/**
+ * @file Behaviour.h
+ * @brief Coroutine behaviours written as sequential code over simulation ticks
+ */
+#ifndef BEHAVIOUR_H
+#define BEHAVIOUR_H
+
+#include "Handle.h"
+#include "TimingWheel.h"
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+class BehaviourScheduler;
+
+/**
+ * @class Behaviour
+ * @brief A coroutine that co_awaits ticks, durations, conditions and other behaviours
+ *
+ * A behaviour is a function returning Behaviour whose body uses co_await
+ * on the awaitables of a BehaviourScheduler:
+ *
+ *     Behaviour patrol(BehaviourScheduler& scheduler, Body& body) {
+ *         while (true) {
+ *             body.moveBaseTo(body.getBasePosition() + Vector2D(5.0, 0.0));
+ *             co_await scheduler.nextTick();
+ *             co_await scheduler.until([&] { return isDone(body); });
+ *             co_await scheduler.seconds(2.0);
+ *         }
+ *     }
+ *
+ * It does nothing until spawned on a scheduler, or co_awaited by a running
+ * behaviour, which then carries on when the awaited one returns. The
+ * Behaviour object owns the coroutine frame.
+ *
+ * Frames come from the scheduler's pool when the coroutine takes the
+ * BehaviourScheduler& as its first parameter, or its second (which covers
+ * the object of a member function), and from the default resource
+ * otherwise.
+ */
+class Behaviour {
+public:
+    struct promise_type;
+    using FrameHandle = std::coroutine_handle<promise_type>;
+
+    // Hands control back to the awaiting behaviour, or tells the scheduler
+    // a spawned behaviour has finished
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+        std::coroutine_handle<> await_suspend(FrameHandle frame) noexcept;
+        void await_resume() const noexcept {}
+    };
+
+    struct promise_type {
+        std::coroutine_handle<> continuation;       // The behaviour awaiting this one, if any
+        BehaviourScheduler* scheduler = nullptr;    // Set once spawned
+
+        Behaviour get_return_object() { return Behaviour(FrameHandle::from_promise(*this)); }
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        FinalAwaiter final_suspend() const noexcept { return {}; }
+        void return_void() const {}
+        void unhandled_exception() const { std::terminate(); }   // Behaviours must not throw
+
+        template <typename... Args>
+        static void* operator new(size_t size, BehaviourScheduler& scheduler, Args&&...);
+        template <typename Object, typename... Args>
+        static void* operator new(size_t size, Object&, BehaviourScheduler& scheduler, Args&&...);
+        static void* operator new(size_t size);
+        static void operator delete(void* frame, size_t size);
+    };
+
+    Behaviour() = default;
+    ~Behaviour();
+    Behaviour(Behaviour&& other) noexcept;
+    Behaviour& operator=(Behaviour&& other) noexcept;
+    Behaviour(const Behaviour&) = delete;
+    Behaviour& operator=(const Behaviour&) = delete;
+
+    // co_await: run it to completion as part of the awaiting behaviour
+    bool await_ready() const noexcept { return !frame || frame.done(); }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept;
+    void await_resume() const noexcept {}
+
+    bool isDone() const;
+
+private:
+    friend class BehaviourScheduler;
+
+    explicit Behaviour(FrameHandle frame) : frame(frame) {}
+    FrameHandle release();
+
+    FrameHandle frame;
+};
+
+// A spawned behaviour, as the scheduler tracks it
+struct BehaviourState {
+    std::coroutine_handle<> frame;          // The spawned behaviour's own frame
+    std::coroutine_handle<> resumePoint;    // The innermost behaviour awaiting, while suspended
+    bool (*condition)(void*);               // Polled with conditionState each tick, if set
+    void* conditionState;
+    TimerHandle timer;                      // While waiting on ticks
+    bool finished;
+};
+
+using BehaviourHandle = Handle<BehaviourState>;
+
+/**
+ * @class BehaviourScheduler
+ * @brief Resumes spawned behaviours when what they wait for comes round
+ *
+ * Waits on ticks and durations go into a TimingWheel keyed by the
+ * behaviour's handle, so a tick only touches the behaviours that fall due;
+ * durations are rounded up to whole time steps. Conditions are polled once
+ * per tick, after the timed waits, in the order they were awaited (a
+ * condition that already holds does not suspend at all). A behaviour that
+ * co_awaits another runs it in place: the scheduler resumes whichever
+ * behaviour in the chain is waiting.
+ *
+ * Frames are allocated from an unsynchronized pool over the scheduler's
+ * memory resource, so spawning and finishing behaviours of the same
+ * shapes reuses the same blocks instead of going to the heap. Not
+ * thread-safe: spawn, cancel and tick from one thread.
+ */
+class BehaviourScheduler {
+public:
+    explicit BehaviourScheduler(double timeStep,
+                                std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+    ~BehaviourScheduler();
+
+    BehaviourScheduler(const BehaviourScheduler&) = delete;
+    BehaviourScheduler& operator=(const BehaviourScheduler&) = delete;
+
+    // Runs the behaviour up to its first wait, then on the scheduler's ticks
+    BehaviourHandle spawn(Behaviour behaviour);
+    // Destroys the behaviour where it waits (with any it is awaiting)
+    bool cancel(BehaviourHandle handle);
+    bool isRunning(BehaviourHandle handle) const;
+
+    // Advance one time step, resuming the behaviours whose wait is over
+    void tick();
+
+    class TickAwaiter {
+    public:
+        TickAwaiter(BehaviourScheduler& scheduler, uint64_t ticks) : scheduler(&scheduler), ticks(ticks) {}
+        bool await_ready() const noexcept { return ticks == 0; }
+        bool await_suspend(std::coroutine_handle<> point) { return scheduler->waitTicks(point, ticks); }
+        void await_resume() const noexcept {}
+
+    private:
+        BehaviourScheduler* scheduler;
+        uint64_t ticks;
+    };
+
+    template <typename Predicate>
+    class ConditionAwaiter {
+    public:
+        ConditionAwaiter(BehaviourScheduler& scheduler, Predicate predicate)
+            : scheduler(&scheduler), predicate(std::move(predicate)) {}
+        bool await_ready() { return predicate(); }
+        bool await_suspend(std::coroutine_handle<> point) { return scheduler->waitUntil(point, &test, this); }
+        void await_resume() const noexcept {}
+
+    private:
+        static bool test(void* self) { return static_cast<ConditionAwaiter*>(self)->predicate(); }
+
+        BehaviourScheduler* scheduler;
+        Predicate predicate;
+    };
+
+    // Awaitables
+    TickAwaiter nextTick() { return TickAwaiter(*this, 1); }
+    TickAwaiter ticks(uint64_t count) { return TickAwaiter(*this, count); }
+    TickAwaiter seconds(double duration);   // Whole time steps, rounded up
+    template <typename Predicate>
+    ConditionAwaiter<Predicate> until(Predicate predicate) {
+        return ConditionAwaiter<Predicate>(*this, std::move(predicate));
+    }
+
+    // Getters
+    size_t size() const;                        // Behaviours running
+    uint64_t getTickCount() const;
+    double getTimeStep() const;
+    size_t getResumeCount() const;              // Since construction
+    std::pmr::memory_resource* getFrameResource();
+
+private:
+    friend struct Behaviour::FinalAwaiter;
+
+    bool waitTicks(std::coroutine_handle<> point, uint64_t ticks);
+    bool waitUntil(std::coroutine_handle<> point, bool (*condition)(void*), void* state);
+    BehaviourState* getCurrent(std::coroutine_handle<> point);
+    void resume(BehaviourHandle handle);
+    void finish(BehaviourHandle handle);
+
+    static uint64_t pack(BehaviourHandle handle);
+    static BehaviourHandle unpack(uint64_t payload);
+
+    std::pmr::unsynchronized_pool_resource framePool;
+    HandlePool<BehaviourState> behaviours;
+    TimingWheel timers;
+    std::pmr::vector<BehaviourHandle> conditionWaiters;     // In the order they began waiting
+    BehaviourHandle current;    // Being resumed
+    double timeStep;
+    uint64_t tickCount;
+    size_t resumeCount;
+};
+
+namespace detail {
+// Frames carry their resource in front of them, for operator delete
+void* allocateBehaviourFrame(std::pmr::memory_resource* resource, size_t size);
+}
+
+template <typename... Args>
+void* Behaviour::promise_type::operator new(size_t size, BehaviourScheduler& scheduler, Args&&...) {
+    return detail::allocateBehaviourFrame(scheduler.getFrameResource(), size);
+}
+
+template <typename Object, typename... Args>
+void* Behaviour::promise_type::operator new(size_t size, Object&, BehaviourScheduler& scheduler, Args&&...) {
+    return detail::allocateBehaviourFrame(scheduler.getFrameResource(), size);
+}
+
+#endif // BEHAVIOUR_H
@@ -7,37 +7,79 @@
 
 #include "Segment.h"  // Already includes M_PI definition
 #include "Circle.h"
+#include "AabbTree.h"
 #include <vector>
 #include <memory>
+#include <memory_resource>
 #include <map>
+#include <span>
 #include <string>
+#include <string_view>
+#include <cstdint>
 
 // Forward declarations
 class Simulation;
 
-class Body {
+// Orders segment names and lets any string type be looked up without a temporary
+struct SegmentNameLess {
+    using is_transparent = void;
+    bool operator()(std::string_view a, std::string_view b) const { return a < b; }
+};
+
+template <typename Scalar>
+class BasicBody {
 public:
-    // Initialize body with its base position
-    Body(const Vector2D& basePosition, double groundLevel);
-    virtual ~Body() = default;
+    using Vec = BasicVector2D<Scalar>;
+    using SegmentType = BasicSegment<Scalar>;
+    
+    using SegmentPair = std::pair<size_t, size_t>;
+    
+    // Bit i stands for the segment with index i (only the first 64 segments fit)
+    using SegmentMask = std::uint64_t;
+    static constexpr size_t kMaxMaskSegments = 64;
+    static constexpr size_t kNoSegment = static_cast<size_t>(-1);
+    static constexpr size_t kDefaultTreeThreshold = 32;   // Segment count from which queries use the BVH
+    
+    // The default humanoid's legs hang from the top of its torso, so its
+    // feet are this far below the base: a body standing on the ground has
+    // its base this far above it
+    static constexpr Scalar kStandingHeight = Scalar(40);
+    
+    // Initialize body with its base position; segments, names and caches are
+    // allocated from the given memory resource (e.g. a ScenarioArena)
+    BasicBody(const Vec& basePosition, Scalar groundLevel,
+              std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+    virtual ~BasicBody() = default;
+    
+    // The index caches point into the segment map, so bodies are not copied
+    BasicBody(const BasicBody&) = delete;
+    BasicBody& operator=(const BasicBody&) = delete;
+    
+    // Copy the skeleton and pose of a body with another scalar type
+    template <typename OtherScalar>
+    explicit BasicBody(const BasicBody<OtherScalar>& other);
     
     // Add and access segments
-    void addSegment(const std::string& name, double length, double angle, 
-                   double minAngle = -M_PI, double maxAngle = M_PI);
-    void connectSegment(const std::string& parentName, const std::string& childName);
-    Segment* getSegment(const std::string& name);
-    const Segment* getSegment(const std::string& name) const;
+    void addSegment(std::string_view name, Scalar length, Scalar angle, 
+                   Scalar minAngle = -M_PI, Scalar maxAngle = M_PI);
+    void connectSegment(std::string_view parentName, std::string_view childName);
+    SegmentType* getSegment(std::string_view name);
+    const SegmentType* getSegment(std::string_view name) const;
     
     // Getters
-    const Vector2D& getBasePosition() const;
-    double getGroundLevel() const;
+    const Vec& getBasePosition() const;
+    Scalar getGroundLevel() const;                      // Ground height under the base
+    const BasicTerrain<Scalar>& getTerrain() const;
+    void setTerrain(const BasicTerrain<Scalar>& terrain);
     std::vector<std::string> getSegmentNames() const;
     size_t getSegmentCount() const;
+    std::pmr::memory_resource* getMemoryResource() const;
     
     // Body movement and constraints
-    bool rotateSegment(const std::string& name, double deltaAngle);
-    bool rotateSegmentTo(const std::string& name, double targetAngle);
-    void moveBaseTo(const Vector2D& newBase);
+    bool rotateSegment(std::string_view name, Scalar deltaAngle);
+    bool rotateSegment(std::string_view name, const BasicRotation2D<Scalar>& delta);
+    bool rotateSegmentTo(std::string_view name, Scalar targetAngle);
+    void moveBaseTo(const Vec& newBase);
     
     // Ground contact checks
     bool hasMinimumGroundContacts(int minContacts = 2) const;
@@ -45,27 +87,122 @@ public:
     std::vector<std::string> getSegmentsContactingGround() const;
     
     // Object interaction
-    bool canReachObject(const Circle& object, int minTouchingPoints = 3) const;
-    std::vector<std::string> getSegmentsTouchingObject(const Circle& object) const;
+    bool canReachObject(const BasicCircle<Scalar>& object, int minTouchingPoints = 3) const;
+    std::vector<std::string> getSegmentsTouchingObject(const BasicCircle<Scalar>& object) const;
+    
+    // Nearest segment to a point / first segment crossed going from -> to
+    // (kNoSegment if there is none; hitFraction receives 0..1 along from -> to)
+    size_t findClosestSegment(const Vec& point) const;
+    size_t rayCastSegments(const Vec& from, const Vec& to, Scalar* hitFraction = nullptr) const;
+    
+    // Rigs with at least this many segments answer the queries above through
+    // a bounding volume tree over the segments (refit lazily after pose changes)
+    size_t getSegmentTreeThreshold() const;
+    void setSegmentTreeThreshold(size_t threshold);
     
     // Update segments after position changes
     void updateSegments();
     
     // For visualization
-    std::vector<std::pair<Vector2D, Vector2D>> getSegmentLines() const;
+    std::vector<std::pair<Vec, Vec>> getSegmentLines() const;
     
     // Check if a segment is an endpoint (not connected to any children)
-    bool isEndPoint(const std::string& segmentName) const;
+    bool isEndPoint(std::string_view segmentName) const;
+    
+    // Allocation-free queries. Segment indices run from 0 to getSegmentCount() - 1
+    // in getSegmentNames() order and stay valid until a segment is added.
+    size_t getSegmentIndex(std::string_view name) const;     // kNoSegment if not found
+    std::string_view getSegmentName(size_t index) const;
+    const SegmentType& getSegmentAt(size_t index) const;
+    bool isEndPoint(size_t index) const;
+    
+    // Call visit(name, segment) for every segment in index order (name is a std::string_view)
+    template <typename Visitor>
+    void forEachSegment(Visitor&& visit) const;
+    
+    // Write (start, end) of the first out.size() segments; returns the number written
+    size_t getSegmentLines(std::span<std::pair<Vec, Vec>> out) const;
+    
+    // Segments with an endpoint on the ground / end segments touching the object
+    SegmentMask getGroundContactMask() const;
+    SegmentMask getTouchingObjectMask(const BasicCircle<Scalar>& object) const;
+    
+    // Segments from the root down to (and including) the given segment
+    std::vector<std::string> getSegmentChain(std::string_view segmentName) const;
+    size_t getParentIndex(size_t index) const;    // kNoSegment for segments attached to the base
+    
+    // Self-collision between segments that do not share a joint (a parent and
+    // its child, siblings and the base segments always touch at the joint).
+    // Pairs closer than clearance count as colliding. findSelfCollisions writes
+    // the first out.size() pairs and returns how many there are in total.
+    bool hasSelfCollision(Scalar clearance = 0) const;
+    size_t findSelfCollisions(std::span<SegmentPair> out, Scalar clearance = 0) const;
     
 protected:
-    Vector2D basePosition;               // Base position of the body
-    double groundLevel;                  // Ground level (y-coordinate)
+    template <typename OtherScalar>
+    friend class BasicBody;
+    
+    Vec basePosition;                    // Base position of the body
+    BasicTerrain<Scalar> terrain;        // Ground (flat at the constructor's groundLevel unless set)
     
-    std::map<std::string, std::unique_ptr<Segment>> segments;  // Named segments
-    std::map<std::string, std::vector<std::string>> connections;  // Parent-to-children connections
+    // Named segments (stored in the map nodes) and parent-to-children connections
+    std::pmr::map<std::pmr::string, SegmentType, SegmentNameLess> segments;
+    std::pmr::map<std::pmr::string, std::pmr::vector<std::pmr::string>, SegmentNameLess> connections;
+    
+    // Index caches over the map, rebuilt whenever the skeleton changes
+    std::pmr::vector<SegmentType*> segmentsByIndex;
+    std::pmr::vector<const std::pmr::string*> namesByIndex;
+    std::pmr::vector<size_t> rootIndices;              // Segments attached to the base
+    std::pmr::vector<unsigned char> endPointFlags;     // Segments without children
+    std::pmr::vector<std::pmr::vector<size_t>> childIndices;   // Same order as connections
+    std::pmr::vector<size_t> parentIndices;            // kNoSegment for root segments
+    
+    // Sweep-and-prune state for the self-collision checks. The segment order
+    // along x is kept between calls: poses change little from one check to
+    // the next, so insertion sort restores it in close to linear time.
+    struct SelfCollisionState {
+        explicit SelfCollisionState(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+            : order(resource), boxes(resource), endpoints(resource), pairs(resource),
+              pairEndpoints(resource), distances(resource) {}
+        
+        std::pmr::vector<uint32_t> order;           // Segments by the left edge of their box
+        std::pmr::vector<BasicAabb<Scalar>> boxes;  // Per segment, widened by the clearance
+        std::pmr::vector<Vec> endpoints;            // Start and end per segment
+        std::pmr::vector<SegmentPair> pairs;        // Candidates from the sweep
+        std::pmr::vector<Scalar> pairEndpoints;     // Candidates' coordinates, 8 blocks of pairs.size()
+        std::pmr::vector<Scalar> distances;         // Squared, per candidate
+    };
+    mutable SelfCollisionState selfCollision;
+    
+    // Segment BVH, leaf segmentLeaves[i] holds segment i. Refitted on first use
+    // after a pose change, so const queries on one body must not run concurrently
+    mutable BasicAabbTree<Scalar> segmentTree;
+    mutable std::pmr::vector<int32_t> segmentLeaves;
+    mutable bool segmentTreeStale;
+    size_t segmentTreeThreshold;
     
     // Helper methods
-    void updateChildSegments(const std::string& parentName);
+    void updateChildSegments(std::string_view parentName);
+    void updateChildSegments(size_t parentIndex);
+    void rebuildSegmentIndex();
+    bool isContactingGround(size_t index) const;
+    bool isTouchingObject(size_t index, const BasicCircle<Scalar>& object) const;
+    bool usesSegmentTree() const;
+    bool sharesJoint(size_t a, size_t b) const;
+    size_t sweepSelfCollisions(std::span<SegmentPair> out, Scalar clearance, bool stopAtFirst) const;
+    const BasicAabbTree<Scalar>& getSegmentTree() const;
+    Scalar rayCastSegment(size_t index, const Vec& from, const Vec& delta, Scalar maxFraction) const;
 };
 
+template <typename Scalar>
+template <typename Visitor>
+void BasicBody<Scalar>::forEachSegment(Visitor&& visit) const {
+    for (size_t i = 0; i < segmentsByIndex.size(); i++) {
+        visit(std::string_view(*namesByIndex[i]), *segmentsByIndex[i]);
+    }
+}
+
+// Simulation precision (see Precision.h)
+using Body = BasicBody<Real>;
+
 #endif // BODY_H
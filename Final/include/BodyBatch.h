@@ -0,0 +1,85 @@
+/**
+ * @file BodyBatch.h
+ * @brief Structure-of-arrays pose storage for many bodies sharing one skeleton
+ */
+#ifndef BODY_BATCH_H
+#define BODY_BATCH_H
+
+#include "Body.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @class BodyBatch
+ * @brief Poses of many bodies laid out one lane per body
+ *
+ * Every per-joint quantity is stored as a contiguous row of laneCount
+ * values, so loops over lanes run the same instruction stream for every
+ * body and vectorize. Joints are kept in parent-before-child order so the
+ * forward kinematics is a single pass over the rows.
+ */
+class BodyBatch {
+public:
+    // All bodies must share the skeleton of the first one
+    explicit BodyBatch(const std::vector<std::shared_ptr<Body>>& bodies);
+    
+    // Copy poses between the bodies and the batch (same order as construction)
+    void loadPoses(const std::vector<std::shared_ptr<Body>>& bodies);
+    void storePoses(const std::vector<std::shared_ptr<Body>>& bodies) const;
+    
+    // Recompute every segment start/end from the base positions and angles
+    void forwardKinematics();
+    
+    // Clamp every angle of every lane to its joint limits in one vectorized pass
+    void applyJointLimits();
+    
+    // Skeleton layout
+    size_t getLaneCount() const;
+    size_t getJointCount() const;
+    int getJointIndex(const std::string& name) const;
+    const std::string& getJointName(size_t joint) const;
+    int getParentIndex(size_t joint) const;
+    bool isAncestorOrSelf(size_t ancestor, size_t joint) const;
+    
+    // Per-lane access
+    Real getAngle(size_t joint, size_t lane) const;
+    void setAngle(size_t joint, size_t lane, Real angle);   // Applies the joint limits
+    Vector2D getStart(size_t joint, size_t lane) const;
+    Vector2D getEnd(size_t joint, size_t lane) const;
+    
+    // Rows of laneCount values for lane-parallel kernels
+    Real* getAngles(size_t joint);
+    const Real* getAngles(size_t joint) const;
+    const Real* getLimitCenters(size_t joint) const;      // See Segment.h (BasicJointLimits)
+    const Real* getLimitHalfWidths(size_t joint) const;
+    const Real* getStartX(size_t joint) const;
+    const Real* getStartY(size_t joint) const;
+    const Real* getEndX(size_t joint) const;
+    const Real* getEndY(size_t joint) const;
+    
+private:
+    size_t laneCount;
+    std::vector<std::string> jointNames;   // Parent-before-child order
+    std::vector<int> parentIndices;        // -1 for segments attached to the base
+    
+    // Per-lane base position
+    std::vector<Real> baseX;
+    std::vector<Real> baseY;
+    
+    // Per-joint rows (index = joint * laneCount + lane)
+    std::vector<Real> lengths;
+    std::vector<Real> angles;
+    std::vector<Real> limitCenters;
+    std::vector<Real> limitHalfWidths;
+    std::vector<Real> startX;
+    std::vector<Real> startY;
+    std::vector<Real> endX;
+    std::vector<Real> endY;
+    
+    // Scratch rows for the sin/cos of every angle (one vectorized pass per update)
+    std::vector<Real> sines;
+    std::vector<Real> cosines;
+};
+
+#endif // BODY_BATCH_H
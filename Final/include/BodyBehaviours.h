@@ -0,0 +1,33 @@
+/**
+ * @file BodyBehaviours.h
+ * @brief Walker and thrower behaviours written as coroutines
+ */
+#ifndef BODY_BEHAVIOURS_H
+#define BODY_BEHAVIOURS_H
+
+#include "Behaviour.h"
+#include "World.h"
+
+// The walker's catch, one move per tick as WalkerStrategy makes them, but
+// decided on the spot instead of planned up front: each step is aimed at
+// where the target is now, so it may move. Results go through the
+// pointers (which may be null), which must outlive the behaviour.
+
+// Step along the ground towards the target until it is within
+// reachDistance of the base horizontally
+Behaviour walkTo(BehaviourScheduler& scheduler, World& world, BodyHandle body, CircleHandle target, double walkSpeed,
+                 double reachDistance);
+// Reach for the target with each arm, one per tick, as WalkerStrategy
+// does (an arm that would collide stays where it was)
+Behaviour reachFor(BehaviourScheduler& scheduler, World& world, BodyHandle body, CircleHandle target);
+// Walk to arm's reach, reach, then grab (both hands on the target)
+Behaviour walkAndCatch(BehaviourScheduler& scheduler, World& world, BodyHandle body, CircleHandle target,
+                       double walkSpeed, bool* caught);
+
+// Throw at the target, wait for the snowball to come down, rest, and again
+// (the world must be stepped between the scheduler's ticks, and landed
+// projectiles left in it until the tick after)
+Behaviour throwVolleys(BehaviourScheduler& scheduler, World& world, BodyHandle thrower, CircleHandle target,
+                       int volleys, double restSeconds, size_t* hits);
+
+#endif // BODY_BEHAVIOURS_H
@@ -3,7 +3,9 @@
 
 #include "Body.h"
 #include "Vector2D.h"
+#include "World.h"
 #include <memory>
+#include <memory_resource>
 #include <string>
 #include <map>
 
@@ -31,13 +33,20 @@ public:
     BodyBuilder& buildHumanoidBody();
     BodyBuilder& buildSimpleBody();
     
-    // Build method to create the final Body object
-    std::shared_ptr<Body> build();
+    // Build method to create the final Body object (body and its segments are
+    // allocated from the given resource, e.g. a ScenarioArena)
+    std::shared_ptr<Body> build(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+    
+    // Build the body inside a world and return its handle
+    BodyHandle build(World& world);
     
     // Reset builder for reuse
     void reset();
     
 private:
+    // Add the specified segments and connections to a body
+    void configure(Body& body) const;
+    
     Vector2D basePosition;
     double groundLevel;
     
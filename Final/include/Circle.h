@@ -7,48 +7,54 @@
 
 #include "Vector2D.h"
 
-class Circle {
+template <typename Scalar>
+class BasicCircle {
 public:
+    using Vec = BasicVector2D<Scalar>;
+    
     // Constructors
-    Circle(const Vector2D& center = Vector2D(0, 0), double radius = 10.0);
-    Circle(double x, double y, double radius);
+    BasicCircle(const Vec& center = Vec(0, 0), Scalar radius = 10.0);
+    BasicCircle(Scalar x, Scalar y, Scalar radius);
     
     // Getters
-    Vector2D getCenter() const;
-    double getRadius() const;
-    double getArea() const;
-    double getCircumference() const;
+    Vec getCenter() const;
+    Scalar getRadius() const;
+    Scalar getArea() const;
+    Scalar getCircumference() const;
     
     // Setters
-    void setCenter(const Vector2D& center);
-    void setCenter(double x, double y);
-    void setRadius(double radius);
+    void setCenter(const Vec& center);
+    void setCenter(Scalar x, Scalar y);
+    void setRadius(Scalar radius);
     
     // Movement
-    void move(const Vector2D& displacement);
-    void updatePosition(double timeStep);
+    void move(const Vec& displacement);
+    void updatePosition(Scalar timeStep);
     
     // Physics
-    void setBallistics(const Vector2D& initialVelocity, double gravity);
-    Vector2D getVelocity() const;
+    void setBallistics(const Vec& initialVelocity, Scalar gravity);
+    Vec getVelocity() const;
     
     // Collision detection
-    bool contains(const Vector2D& point) const;
-    bool intersects(const Circle& other) const;
-    bool isOnGround(double groundLevel) const;
+    bool contains(const Vec& point) const;
+    bool intersects(const BasicCircle& other) const;
+    bool isOnGround(Scalar groundLevel) const;
     
     // Math utilities
-    double distanceTo(const Circle& other) const;
-    double distanceToCenter(const Circle& other) const;
+    Scalar distanceTo(const BasicCircle& other) const;
+    Scalar distanceToCenter(const BasicCircle& other) const;
     
 private:
-    Vector2D center;          // Center position
-    double radius;            // Radius
+    Vec center;               // Center position
+    Scalar radius;            // Radius
     
     // Physics properties (for ballistics)
-    Vector2D velocity;        // Current velocity
-    double gravity;           // Gravity value (for ballistics)
+    Vec velocity;             // Current velocity
+    Scalar gravity;           // Gravity value (for ballistics)
     bool hasPhysics;          // Whether this circle has physics enabled
 };
 
+// Simulation precision (see Precision.h)
+using Circle = BasicCircle<Real>;
+
 #endif // CIRCLE_H
\ No newline at end of file
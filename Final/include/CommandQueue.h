@@ -0,0 +1,142 @@
+/**
+ * @file CommandQueue.h
+ * @brief Bounded lock-free queue carrying commands from input threads to the simulation
+ */
+#ifndef COMMAND_QUEUE_H
+#define COMMAND_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+
+/**
+ * @class CommandQueue
+ * @brief Multi-producer, single-consumer ring of fixed capacity
+ *
+ * Each slot carries a sequence number that says whose turn it is: a
+ * producer claims the slot at the tail with one compare-and-swap, writes
+ * the value and publishes it by bumping the sequence; the consumer takes
+ * the slot at the head once it is published and hands it back a lap
+ * ahead. No locks and no allocation after construction, so tryPush costs
+ * the same however long the consumer takes between drains. A full queue
+ * refuses the push (and counts it) rather than waiting.
+ *
+ * Any number of threads may push; only one may pop. With a single
+ * producer the compare-and-swap never retries. The capacity is rounded up
+ * to a power of two; values must be trivially copyable.
+ */
+template <typename T>
+class CommandQueue {
+    static_assert(std::is_trivially_copyable_v<T>, "commands are copied in and out of the slots");
+
+public:
+    explicit CommandQueue(size_t capacity, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : resource(resource), capacity(roundUpToPowerOfTwo(capacity)), mask(this->capacity - 1),
+          head(0), tail(0), droppedCount(0) {
+        slots = static_cast<Slot*>(resource->allocate(sizeof(Slot) * this->capacity, alignof(Slot)));
+        for (size_t i = 0; i < this->capacity; i++) {
+            new (&slots[i]) Slot{};
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~CommandQueue() {
+        for (size_t i = 0; i < capacity; i++) {
+            slots[i].~Slot();
+        }
+        resource->deallocate(slots, sizeof(Slot) * capacity, alignof(Slot));
+    }
+
+    CommandQueue(const CommandQueue&) = delete;
+    CommandQueue& operator=(const CommandQueue&) = delete;
+
+    // Any thread; false (and counted as dropped) when the queue is full
+    bool tryPush(const T& value) {
+        size_t position = tail.load(std::memory_order_relaxed);
+        while (true) {
+            Slot& slot = slots[position & mask];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            if (sequence == position) {
+                // Free for this lap: claim it, or retry from where another producer left the tail
+                if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    slot.value = value;
+                    slot.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (sequence < position) {
+                // Still holding last lap's value
+                droppedCount.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                position = tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // The consumer thread only; false when nothing is published yet
+    bool tryPop(T& value) {
+        size_t position = head.load(std::memory_order_relaxed);
+        Slot& slot = slots[position & mask];
+        if (slot.sequence.load(std::memory_order_acquire) != position + 1) {
+            return false;
+        }
+        value = slot.value;
+        slot.sequence.store(position + capacity, std::memory_order_release);
+        head.store(position + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Pop at most maxCount values into handle(value), in push order; the
+    // consumer thread only
+    template <typename Handler>
+    size_t drain(Handler&& handle, size_t maxCount = SIZE_MAX) {
+        size_t count = 0;
+        T value;
+        while (count < maxCount && tryPop(value)) {
+            handle(value);
+            count++;
+        }
+        return count;
+    }
+
+    // Getters
+    size_t getCapacity() const { return capacity; }
+    // A snapshot: producers and the consumer may move it straight away
+    size_t size() const {
+        size_t pushed = tail.load(std::memory_order_relaxed);
+        size_t popped = head.load(std::memory_order_relaxed);
+        return pushed > popped ? pushed - popped : 0;
+    }
+    size_t getDroppedCount() const { return droppedCount.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr size_t kCacheLine = 64;
+
+    struct alignas(kCacheLine) Slot {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    static size_t roundUpToPowerOfTwo(size_t value) {
+        size_t rounded = 2;
+        while (rounded < value) {
+            rounded <<= 1;
+        }
+        return rounded;
+    }
+
+    std::pmr::memory_resource* resource;
+    Slot* slots;
+    size_t capacity;
+    size_t mask;
+
+    // Producers and the consumer each write their own line
+    alignas(kCacheLine) std::atomic<size_t> head;
+    alignas(kCacheLine) std::atomic<size_t> tail;
+    alignas(kCacheLine) std::atomic<size_t> droppedCount;
+};
+
+#endif // COMMAND_QUEUE_H
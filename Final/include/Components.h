@@ -0,0 +1,38 @@
+/**
+ * @file Components.h
+ * @brief Plain component types stored in ArchetypeTables
+ */
+#ifndef COMPONENTS_H
+#define COMPONENTS_H
+
+#include "EntityHandles.h"
+
+// Flight state of a projectile
+enum class ProjectileStatus : unsigned char {
+    FLYING,
+    HIT_TARGET,
+    HIT_GROUND
+};
+
+// Where an entity is
+struct Transform {
+    Vector2D position;
+};
+
+// Ballistic motion; integration reads only this and Transform (and the status)
+struct ProjectilePhysics {
+    Vector2D velocity;
+};
+
+// Read when resolving impacts, not while integrating
+struct ProjectileShape {
+    Real radius;
+    Real groundLevel;
+};
+
+struct ProjectileLinks {
+    CircleHandle target;
+    BodyHandle thrower;
+};
+
+#endif // COMPONENTS_H
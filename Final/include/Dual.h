@@ -0,0 +1,153 @@
+/**
+ * @file Dual.h
+ * @brief Forward-mode dual numbers for exact derivatives of the kinematics
+ */
+#ifndef DUAL_H
+#define DUAL_H
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+
+/**
+ * @class Dual
+ * @brief A value together with its partial derivatives w.r.t. N variables
+ *
+ * Arithmetic and the elementary functions used by the kinematics
+ * (sin, cos, sqrt, atan2, fmod, nearbyint, abs) propagate the derivatives by the
+ * chain rule, so running Vector2D/Segment/Body code with this scalar type
+ * yields the exact gradient of every result in a single forward pass.
+ * Comparisons only look at the value part.
+ */
+template <typename T, std::size_t N>
+class Dual {
+public:
+    T value;                        // Real part
+    std::array<T, N> derivatives;   // Partial derivatives, one slot per variable
+
+    // Constants have zero derivatives (implicit so literals mix freely)
+    constexpr Dual(T value = T(0)) : value(value), derivatives{} {}
+
+    // Create an independent variable seeded in derivative slot 'index'
+    static Dual variable(T value, std::size_t index) {
+        Dual result(value);
+        if (index < N) {
+            result.derivatives[index] = T(1);
+        }
+        return result;
+    }
+
+    // Arithmetic operators
+    friend Dual operator+(const Dual& a, const Dual& b) {
+        Dual result(a.value + b.value);
+        for (std::size_t i = 0; i < N; i++) {
+            result.derivatives[i] = a.derivatives[i] + b.derivatives[i];
+        }
+        return result;
+    }
+
+    friend Dual operator-(const Dual& a, const Dual& b) {
+        Dual result(a.value - b.value);
+        for (std::size_t i = 0; i < N; i++) {
+            result.derivatives[i] = a.derivatives[i] - b.derivatives[i];
+        }
+        return result;
+    }
+
+    friend Dual operator*(const Dual& a, const Dual& b) {
+        Dual result(a.value * b.value);
+        for (std::size_t i = 0; i < N; i++) {
+            result.derivatives[i] = a.derivatives[i] * b.value + a.value * b.derivatives[i];
+        }
+        return result;
+    }
+
+    friend Dual operator/(const Dual& a, const Dual& b) {
+        Dual result(a.value / b.value);
+        T inverseSquared = T(1) / (b.value * b.value);
+        for (std::size_t i = 0; i < N; i++) {
+            result.derivatives[i] = (a.derivatives[i] * b.value - a.value * b.derivatives[i]) * inverseSquared;
+        }
+        return result;
+    }
+
+    friend Dual operator-(const Dual& a) {
+        return Dual(T(0)) - a;
+    }
+
+    Dual& operator+=(const Dual& other) { return *this = *this + other; }
+    Dual& operator-=(const Dual& other) { return *this = *this - other; }
+    Dual& operator*=(const Dual& other) { return *this = *this * other; }
+    Dual& operator/=(const Dual& other) { return *this = *this / other; }
+
+    // Comparison operators (value part only)
+    friend bool operator==(const Dual& a, const Dual& b) { return a.value == b.value; }
+    friend bool operator!=(const Dual& a, const Dual& b) { return a.value != b.value; }
+    friend bool operator<(const Dual& a, const Dual& b) { return a.value < b.value; }
+    friend bool operator<=(const Dual& a, const Dual& b) { return a.value <= b.value; }
+    friend bool operator>(const Dual& a, const Dual& b) { return a.value > b.value; }
+    friend bool operator>=(const Dual& a, const Dual& b) { return a.value >= b.value; }
+
+    // Elementary functions (found by argument-dependent lookup)
+    friend Dual sin(const Dual& a) {
+        return a.chain(std::sin(a.value), std::cos(a.value));
+    }
+
+    friend Dual cos(const Dual& a) {
+        return a.chain(std::cos(a.value), -std::sin(a.value));
+    }
+
+    friend Dual sqrt(const Dual& a) {
+        T root = std::sqrt(a.value);
+        return a.chain(root, root > T(0) ? T(0.5) / root : T(0));
+    }
+
+    friend Dual abs(const Dual& a) {
+        return a.value < T(0) ? -a : a;
+    }
+
+    friend Dual nearbyint(const Dual& a) {
+        // Piecewise constant: zero derivative
+        return Dual(std::nearbyint(a.value));
+    }
+
+    friend Dual fmod(const Dual& a, const Dual& b) {
+        // d/da fmod(a, b) = 1 (b is treated as a constant period)
+        return a.chain(std::fmod(a.value, b.value), T(1));
+    }
+
+    friend Dual atan2(const Dual& y, const Dual& x) {
+        Dual result(std::atan2(y.value, x.value));
+        T denominator = x.value * x.value + y.value * y.value;
+        if (denominator > T(0)) {
+            for (std::size_t i = 0; i < N; i++) {
+                result.derivatives[i] = (x.value * y.derivatives[i] - y.value * x.derivatives[i]) / denominator;
+            }
+        }
+        return result;
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const Dual& a) {
+        os << a.value;
+        return os;
+    }
+
+private:
+    // Apply f(value) with derivative f'(value) to every slot
+    Dual chain(T newValue, T slope) const {
+        Dual result(newValue);
+        for (std::size_t i = 0; i < N; i++) {
+            result.derivatives[i] = derivatives[i] * slope;
+        }
+        return result;
+    }
+};
+
+// Maximum number of joint angles differentiated in a single forward pass
+constexpr std::size_t kMaxKinematicJoints = 16;
+
+// Scalar type used for differentiable kinematics
+using KinematicDual = Dual<double, kMaxKinematicJoints>;
+
+#endif // DUAL_H
@@ -0,0 +1,22 @@
+/**
+ * @file EntityHandles.h
+ * @brief Handle types for the entities owned by a World
+ */
+#ifndef ENTITY_HANDLES_H
+#define ENTITY_HANDLES_H
+
+#include "Body.h"
+#include "Circle.h"
+#include "Handle.h"
+
+struct ProjectileState;
+struct Obstacle;
+class WalkerStrategy;
+
+using BodyHandle = Handle<Body>;
+using CircleHandle = Handle<Circle>;
+using ProjectileHandle = Handle<ProjectileState>;
+using WalkerHandle = Handle<WalkerStrategy>;
+using ObstacleHandle = Handle<Obstacle>;
+
+#endif // ENTITY_HANDLES_H
@@ -0,0 +1,69 @@
+/**
+ * @file EventQueue.h
+ * @brief Priority queue of predicted events, one pending event per id
+ */
+#ifndef EVENT_QUEUE_H
+#define EVENT_QUEUE_H
+
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+/**
+ * @class EventQueue
+ * @brief Indexed binary min-heap on the tick an event falls due
+ *
+ * Every id (a projectile slot and the kind of contact, say) has at most
+ * one pending event. schedule() on an id that already has one moves it
+ * up or down the heap in place (decrease- or increase-key) instead of
+ * adding another, so the queue never holds more than one entry per id
+ * and re-predicting costs O(log n).
+ *
+ * Each event carries the generation of whatever it was predicted for.
+ * When the owner is destroyed and its slot reused, the generation no
+ * longer matches and the consumer drops the event when it pops, without
+ * the queue having been told.
+ *
+ * Events due on the same tick come out in id order, so a run is
+ * reproducible however the heap was built.
+ */
+class EventQueue {
+public:
+    static constexpr uint32_t kNotQueued = UINT32_MAX;
+
+    struct Event {
+        uint64_t tick;
+        uint32_t id;
+        uint32_t generation;
+    };
+
+    explicit EventQueue(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    // Replaces the id's pending event, if it has one
+    void schedule(uint32_t id, uint32_t generation, uint64_t tick);
+    void cancel(uint32_t id);
+    void clear();
+
+    // Earliest event; only valid when not empty()
+    const Event& top() const;
+    Event pop();
+
+    // Getters
+    bool empty() const;
+    size_t size() const;
+    bool isScheduled(uint32_t id) const;
+    uint64_t getTick(uint32_t id) const;    // Of the pending event, UINT64_MAX if none
+    uint64_t getNextTick() const;           // UINT64_MAX when empty
+
+private:
+    static bool isBefore(const Event& a, const Event& b);
+    void siftUp(size_t position);
+    void siftDown(size_t position);
+    void place(size_t position, const Event& event);
+    void removeAt(size_t position);
+
+    std::pmr::vector<Event> heap;
+    std::pmr::vector<uint32_t> positionOf;  // Id -> index in heap, kNotQueued if none
+};
+
+#endif // EVENT_QUEUE_H
@@ -0,0 +1,191 @@
+/**
+ * @file Handle.h
+ * @brief Generation-checked handles and the pool that hands them out
+ */
+#ifndef HANDLE_H
+#define HANDLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <utility>
+#include <vector>
+
+/**
+ * @struct Handle
+ * @brief Non-owning reference to an object in a HandlePool
+ *
+ * A slot index plus the generation the slot had when the object was
+ * created. Destroying the object bumps the slot's generation, so an old
+ * handle stops resolving instead of dangling. Copying a handle is copying
+ * two integers: no reference counts, no atomics.
+ */
+template <typename T>
+struct Handle {
+    uint32_t index = 0;
+    uint32_t generation = 0;    // 0 never matches a live slot (null handle)
+
+    bool isNull() const { return generation == 0; }
+    explicit operator bool() const { return generation != 0; }
+
+    bool operator==(const Handle& other) const {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const Handle& other) const { return !(*this == other); }
+};
+
+/**
+ * @class HandlePool
+ * @brief Owns objects of one type in fixed-size chunks of slots
+ *
+ * Objects are constructed in place and never move, so T does not need to
+ * be copyable or movable and a resolved pointer stays valid until the
+ * object is destroyed. Freed slots are reused (newest first); chunks are
+ * allocated from the pool's memory resource and kept until destruction.
+ */
+template <typename T>
+class HandlePool {
+public:
+    static constexpr size_t kChunkSize = 64;
+
+    explicit HandlePool(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : chunks(resource), freeSlots(resource), slotCount(0), liveCount(0) {}
+
+    ~HandlePool() {
+        clear();
+        std::pmr::polymorphic_allocator<Slot> allocator(chunks.get_allocator());
+        for (Slot* chunk : chunks) {
+            allocator.deallocate(chunk, kChunkSize);
+        }
+    }
+
+    HandlePool(const HandlePool&) = delete;
+    HandlePool& operator=(const HandlePool&) = delete;
+
+    // Construct an object in a free slot
+    template <typename... Args>
+    Handle<T> create(Args&&... args) {
+        uint32_t index;
+        if (!freeSlots.empty()) {
+            index = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            if (slotCount == chunks.size() * kChunkSize) {
+                addChunk();
+            }
+            index = slotCount++;
+        }
+
+        Slot& slot = slotAt(index);
+        ::new (static_cast<void*>(slot.storage)) T(std::forward<Args>(args)...);
+        slot.alive = true;
+        liveCount++;
+        return Handle<T>{index, slot.generation};
+    }
+
+    // Destroy the object; false if the handle was already stale
+    bool destroy(Handle<T> handle) {
+        T* object = get(handle);
+        if (!object) {
+            return false;
+        }
+
+        Slot& slot = slotAt(handle.index);
+        object->~T();
+        slot.alive = false;
+        slot.generation = (slot.generation == UINT32_MAX) ? 1 : slot.generation + 1;
+        liveCount--;
+        freeSlots.push_back(handle.index);
+        return true;
+    }
+
+    // Destroy every object (outstanding handles become stale)
+    void clear() {
+        for (uint32_t i = 0; i < slotCount; i++) {
+            Slot& slot = slotAt(i);
+            if (slot.alive) {
+                destroy(Handle<T>{i, slot.generation});
+            }
+        }
+    }
+
+    // Resolve a handle (nullptr if null or stale)
+    T* get(Handle<T> handle) {
+        if (handle.index >= slotCount) {
+            return nullptr;
+        }
+        Slot& slot = slotAt(handle.index);
+        return (slot.alive && slot.generation == handle.generation) ? objectIn(slot) : nullptr;
+    }
+
+    const T* get(Handle<T> handle) const {
+        return const_cast<HandlePool*>(this)->get(handle);
+    }
+
+    bool contains(Handle<T> handle) const {
+        return get(handle) != nullptr;
+    }
+
+    // Handle of the live object in a slot (null handle if the slot is empty)
+    Handle<T> handleAt(uint32_t index) const {
+        if (index >= slotCount || !slotAt(index).alive) {
+            return Handle<T>{};
+        }
+        return Handle<T>{index, slotAt(index).generation};
+    }
+
+    size_t size() const { return liveCount; }
+    size_t capacity() const { return chunks.size() * kChunkSize; }
+
+    // Call visit(handle, object) for every live object in slot order
+    template <typename Visitor>
+    void forEach(Visitor&& visit) {
+        for (uint32_t i = 0; i < slotCount; i++) {
+            Slot& slot = slotAt(i);
+            if (slot.alive) {
+                visit(Handle<T>{i, slot.generation}, *objectIn(slot));
+            }
+        }
+    }
+
+    template <typename Visitor>
+    void forEach(Visitor&& visit) const {
+        for (uint32_t i = 0; i < slotCount; i++) {
+            const Slot& slot = slotAt(i);
+            if (slot.alive) {
+                visit(Handle<T>{i, slot.generation}, *objectIn(slot));
+            }
+        }
+    }
+
+private:
+    struct Slot {
+        alignas(T) unsigned char storage[sizeof(T)];
+        uint32_t generation;
+        bool alive;
+    };
+
+    void addChunk() {
+        std::pmr::polymorphic_allocator<Slot> allocator(chunks.get_allocator());
+        Slot* chunk = allocator.allocate(kChunkSize);
+        for (size_t i = 0; i < kChunkSize; i++) {
+            chunk[i].generation = 1;
+            chunk[i].alive = false;
+        }
+        chunks.push_back(chunk);
+    }
+
+    Slot& slotAt(uint32_t index) { return chunks[index / kChunkSize][index % kChunkSize]; }
+    const Slot& slotAt(uint32_t index) const { return chunks[index / kChunkSize][index % kChunkSize]; }
+
+    static T* objectIn(Slot& slot) { return std::launder(reinterpret_cast<T*>(slot.storage)); }
+    static const T* objectIn(const Slot& slot) { return std::launder(reinterpret_cast<const T*>(slot.storage)); }
+
+    std::pmr::vector<Slot*> chunks;
+    std::pmr::vector<uint32_t> freeSlots;
+    uint32_t slotCount;     // Slots ever handed out (live or free)
+    size_t liveCount;
+};
+
+#endif // HANDLE_H
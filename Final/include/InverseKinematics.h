@@ -0,0 +1,69 @@
+/**
+ * @file InverseKinematics.h
+ * @brief Damped-least-squares IK on the analytic Jacobian of body end effectors
+ */
+#ifndef INVERSE_KINEMATICS_H
+#define INVERSE_KINEMATICS_H
+
+#include "Body.h"
+#include "BodyBatch.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+// Drive the end point of a segment to a position
+struct IKTarget {
+    std::string segmentName;   // End effector segment
+    Vector2D position;         // Desired position of its end point
+};
+
+// Outcome of one IK problem
+struct IKResult {
+    bool converged;            // Every target reached within the tolerance
+    int iterations;            // Iterations used
+    double maxError;           // Largest remaining target distance
+};
+
+/**
+ * @class IKSolver
+ * @brief Solves several simultaneous end-effector targets with joint limits
+ *
+ * Segment angles are absolute, so the Jacobian column of joint j for an
+ * effector in its subtree is the segment vector rotated by 90 degrees.
+ * It is assembled from one forward-kinematics pass per iteration. The
+ * update is dθ = Jᵀ (J Jᵀ + λ² I)⁻¹ e, followed by clamping to the limits;
+ * a joint at a limit that the error pulls further out is left out of the
+ * iteration so the others take its share. Batches solve one problem per
+ * BodyBatch lane with lane-parallel loops.
+ *
+ * The method is local: goals near the current pose (tracking) converge,
+ * but a goal that needs, say, the torso turned half around can stall with
+ * the hands pinned at their limits. Start from a nearby pose (the previous
+ * solution) and check IKResult::converged.
+ */
+class IKSolver {
+public:
+    IKSolver(double damping = 10.0, int maxIterations = 50, double tolerance = 0.5);
+    
+    // Restrict the joints the solver may move (default: every ancestor of a target)
+    void setActiveJoints(const std::vector<std::string>& jointNames);
+    void setMaxStepAngle(double maxStep);
+    
+    // Solve for a single body and write the resulting pose back
+    IKResult solve(const std::shared_ptr<Body>& body, const std::vector<IKTarget>& targets) const;
+    
+    // Solve one problem per lane; targetPositions[lane * effectorNames.size() + t]
+    // is the goal of effector t in that lane
+    std::vector<IKResult> solveBatch(BodyBatch& batch,
+                                     const std::vector<std::string>& effectorNames,
+                                     const std::vector<Vector2D>& targetPositions) const;
+    
+private:
+    double damping;                          // λ in (J Jᵀ + λ² I)
+    int maxIterations;
+    double tolerance;                        // Target distance considered reached
+    double maxStepAngle;                     // Largest joint change per iteration
+    std::vector<std::string> activeJoints;   // Empty = all ancestors of the targets
+};
+
+#endif // INVERSE_KINEMATICS_H
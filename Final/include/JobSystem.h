@@ -0,0 +1,131 @@
+/**
+ * @file JobSystem.h
+ * @brief Work-stealing job system shared by the simulation subsystems
+ */
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+// A unit of work; finished once its function has returned
+struct Job {
+    std::function<void()> work;
+    std::atomic<size_t> unfinishedDependencies{0};
+    std::atomic<bool> finished{false};
+    std::mutex continuationLock;
+    std::vector<std::shared_ptr<Job>> continuations;    // Submitted when this finishes
+};
+
+using JobHandle = std::shared_ptr<Job>;
+
+/**
+ * @class JobSystem
+ * @brief Worker threads with one job deque each, stealing from each other
+ *
+ * A worker pushes and pops its own jobs at the back of its deque (newest
+ * first, still warm in cache) and, when it runs dry, steals the oldest
+ * job from the front of another's. Threads outside the system submit to
+ * a deque of their own that the workers steal from. Idle workers sleep
+ * until something is submitted.
+ *
+ * wait() never just blocks: the waiting thread runs queued jobs (its own
+ * first) until the one it waits for is done, so jobs may wait on jobs
+ * they submitted without tying up a worker, and a system with no workers
+ * still runs everything, on the waiting thread.
+ *
+ * The subsystems share one instance, shared(), sized to the hardware.
+ * Jobs must not throw.
+ */
+class JobSystem {
+public:
+    // One worker per hardware thread besides the caller's
+    static size_t getDefaultWorkerCount();
+    static JobSystem& shared();
+
+    explicit JobSystem(size_t workerCount = getDefaultWorkerCount());
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    JobHandle submit(std::function<void()> work);
+    // Runs once every dependency has finished (a continuation)
+    JobHandle submitAfter(std::span<const JobHandle> dependencies, std::function<void()> work);
+    void wait(const JobHandle& job);
+
+    // body(first, last) over [begin, end) in ranges of about grain indices,
+    // on the workers and the calling thread; returns when all have run
+    template <typename Body>
+    void parallelFor(size_t begin, size_t end, size_t grain, Body&& body);
+
+    // Getters
+    size_t getWorkerCount() const;
+    size_t getExecutedCount() const;    // Jobs run since construction
+    size_t getStolenCount() const;      // Of those, taken from another thread's deque
+
+private:
+    struct Queue {
+        std::mutex lock;
+        std::deque<JobHandle> jobs;
+    };
+
+    void push(JobHandle job);
+    JobHandle findJob();
+    void execute(const JobHandle& job);
+    void workerLoop(size_t index);
+    size_t getQueueIndex() const;   // The calling thread's deque
+
+    std::vector<std::unique_ptr<Queue>> queues;     // 0: threads outside the system
+    std::vector<std::thread> workers;
+    std::mutex sleepLock;
+    std::condition_variable wake;
+    std::atomic<size_t> queuedCount;
+    std::atomic<size_t> executedCount;
+    std::atomic<size_t> stolenCount;
+    bool running;
+};
+
+template <typename Body>
+void JobSystem::parallelFor(size_t begin, size_t end, size_t grain, Body&& body) {
+    if (begin >= end) {
+        return;
+    }
+    grain = grain > 0 ? grain : 1;
+    size_t rangeCount = (end - begin + grain - 1) / grain;
+    if (rangeCount == 1 || workers.empty()) {
+        body(begin, end);
+        return;
+    }
+
+    // Ranges are handed out from a shared counter, so a helper that starts
+    // late (or never gets stolen) just finds nothing left; the caller takes
+    // ranges too and then waits on the helpers, running them if need be
+    std::atomic<size_t> nextRange{0};
+    auto runRanges = [&]() {
+        for (size_t range = nextRange++; range < rangeCount; range = nextRange++) {
+            size_t first = begin + range * grain;
+            body(first, std::min(first + grain, end));
+        }
+    };
+    size_t helperCount = std::min(workers.size(), rangeCount - 1);
+    std::vector<JobHandle> helpers;
+    helpers.reserve(helperCount);
+    for (size_t i = 0; i < helperCount; i++) {
+        helpers.push_back(submit(runRanges));
+    }
+    runRanges();
+    for (const JobHandle& helper : helpers) {
+        wait(helper);
+    }
+}
+
+#endif // JOB_SYSTEM_H
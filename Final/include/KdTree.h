@@ -0,0 +1,75 @@
+/**
+ * @file KdTree.h
+ * @brief Static 2-d tree over points, for nearest-neighbour queries
+ */
+#ifndef KD_TREE_H
+#define KD_TREE_H
+
+#include "Vector2D.h"
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+/**
+ * @class KdTree
+ * @brief Points split at the median of their wider axis, stored implicitly
+ *
+ * build() sorts the points in place into the tree: the node of a range
+ * [begin, end) is the point at its middle, with the smaller half to its
+ * left. There are no child pointers and nothing is allocated per node;
+ * ranges of a few points are left unsplit and scanned.
+ *
+ * Points can be removed (and restored) one at a time. Each node keeps a
+ * count of the points left in its subtree, so a query skips emptied
+ * subtrees outright: nearest-unvisited stays logarithmic while a greedy
+ * tour removes points one by one.
+ */
+class KdTree {
+public:
+    static constexpr uint32_t kNone = UINT32_MAX;
+
+    explicit KdTree(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    // Point i is reported as i
+    void build(std::span<const Vector2D> points);
+
+    // Closest point left in the tree, or kNone if it is empty
+    uint32_t findNearest(const Vector2D& point) const;
+    // Up to out.size() closest points left, nearest first, skipping
+    // 'exclude'; returns how many were written
+    size_t findNearest(const Vector2D& point, std::span<uint32_t> out, uint32_t exclude = kNone) const;
+
+    void remove(uint32_t point);
+    void restore(uint32_t point);
+    void restoreAll();
+
+    // Getters
+    size_t size() const;            // Points built
+    size_t getRemaining() const;    // Points not removed
+    bool isRemoved(uint32_t point) const;
+
+private:
+    struct Node {
+        Vector2D position;
+        uint32_t point;
+        uint8_t axis;       // 0: split on x, 1: on y
+        bool removed;
+        uint32_t remaining; // Points left in this subtree
+    };
+    struct Best {
+        Real distanceSquared;
+        uint32_t point;
+    };
+
+    void buildRange(size_t begin, size_t end);
+    void adjustCounts(uint32_t point, int32_t delta);
+    void searchNearest(size_t begin, size_t end, const Vector2D& point, Best& best) const;
+    void searchNearest(size_t begin, size_t end, const Vector2D& point, std::span<Best> best, size_t& found,
+                       uint32_t exclude) const;
+
+    std::pmr::vector<Node> nodes;           // In tree order
+    std::pmr::vector<uint32_t> slotOf;      // Point -> index in nodes
+};
+
+#endif // KD_TREE_H
@@ -0,0 +1,34 @@
+/**
+ * @file Kinematics.h
+ * @brief Exact end-effector gradients from a single dual-number forward pass
+ */
+#ifndef KINEMATICS_H
+#define KINEMATICS_H
+
+#include "Body.h"
+#include "Dual.h"
+#include <string>
+#include <vector>
+
+/**
+ * @struct EndEffectorGradient
+ * @brief Position of a segment end and its derivative w.r.t. every joint angle
+ *
+ * jointGradients[i] is d(position)/d(angle of jointNames[i]). Joints are
+ * listed in the same order as Body::getSegmentNames().
+ */
+struct EndEffectorGradient {
+    std::string segmentName;               // End effector segment
+    Vector2D position;                     // Current end point of the segment
+    std::vector<std::string> jointNames;   // Differentiated joints
+    std::vector<Vector2D> jointGradients;  // d(position)/d(joint angle)
+};
+
+// Evaluate the body in dual numbers once and read the gradients of several end effectors
+std::vector<EndEffectorGradient> computeEndEffectorGradients(const Body& body,
+                                                             const std::vector<std::string>& segmentNames);
+
+// Convenience overload for a single end effector
+EndEffectorGradient computeEndEffectorGradient(const Body& body, const std::string& segmentName);
+
+#endif // KINEMATICS_H
@@ -5,9 +5,12 @@
 #include <fstream>
 #include <memory>
 #include <mutex>
+#include "Precision.h"
 
 // Forward declaration
-class Vector2D;
+template <typename Scalar>
+class BasicVector2D;
+using Vector2D = BasicVector2D<Real>;
 
 /**
  * @class Logger
@@ -39,6 +42,7 @@ private:
     std::string getTimestamp() const;
     
     std::ofstream logFile;
+    std::mutex writeLock;   // Walkers may log from several job threads at once
     bool initialized;
 };
 
@@ -5,6 +5,9 @@
 #include "Body.h"
 #include "Circle.h"
 #include "Logger.h"
+#include "EntityHandles.h"
+
+class World;
 
 /**
  * @class MovementStrategy
@@ -13,11 +16,12 @@
  * This class defines the interface for all movement strategies
  * using the Strategy pattern. Different movement behaviors
  * can be implemented by creating concrete strategy classes.
+ * The body and target are owned by a World and referenced by handle.
  */
 class MovementStrategy {
 public:
-    MovementStrategy(std::shared_ptr<Body> body, std::shared_ptr<Circle> target)
-        : body(body), target(target) {}
+    MovementStrategy(World& world, BodyHandle body, CircleHandle target)
+        : world(&world), bodyHandle(body), targetHandle(target) {}
     
     virtual ~MovementStrategy() = default;
     
@@ -32,14 +36,19 @@ public:
     }
     
     // Target management
-    virtual void setTarget(std::shared_ptr<Circle> newTarget) {
-        target = newTarget;
+    virtual void setTarget(CircleHandle newTarget) {
+        targetHandle = newTarget;
     }
     
 protected:
-    std::shared_ptr<Body> body;
-    std::shared_ptr<Circle> target;
-    std::shared_ptr<Logger> logger;
+    // Resolve the handles (nullptr once the entity has been destroyed)
+    Body* getBody() const;
+    Circle* getTarget() const;
+    
+    World* world;
+    BodyHandle bodyHandle;
+    CircleHandle targetHandle;
+    std::shared_ptr<Logger> logger;   // Only dereferenced per move, never copied
 };
 
 #endif // MOVEMENT_STRATEGY_H
\ No newline at end of file
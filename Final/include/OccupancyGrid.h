@@ -0,0 +1,113 @@
+/**
+ * @file OccupancyGrid.h
+ * @brief Level obstacles and the blocked/free cell grid that walkers plan on
+ */
+#ifndef OCCUPANCY_GRID_H
+#define OCCUPANCY_GRID_H
+
+#include "Vector2D.h"
+#include "AabbTree.h"
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+/**
+ * @struct Obstacle
+ * @brief Circle or axis-aligned box that bodies have to walk around
+ */
+struct Obstacle {
+    enum class Shape { CIRCLE, BOX };
+
+    static Obstacle circle(const Vector2D& center, Real radius);
+    static Obstacle box(const Vector2D& min, const Vector2D& max);
+
+    Aabb getBounds() const;
+
+    Shape shape;
+    Vector2D center;
+    Vector2D halfSize;      // Half extents of a box; (radius, radius) for a circle
+};
+
+// Cell coordinates in an OccupancyGrid
+struct GridCell {
+    int32_t x;
+    int32_t y;
+
+    bool operator==(const GridCell& other) const { return x == other.x && y == other.y; }
+    bool operator!=(const GridCell& other) const { return !(*this == other); }
+};
+
+/**
+ * @class OccupancyGrid
+ * @brief Square cells over a rectangle of the level, each blocked or free
+ *
+ * Blocked cells are stored as bits twice: row by row and column by column.
+ * The path planner scans both 64 cells at a time, so a jump across open
+ * ground costs one word per 64 cells in either direction. Cells outside
+ * the grid (and the padding bits past the last cell of a row or column)
+ * read as blocked.
+ *
+ * Obstacles are stamped into the cells they overlap, grown by a clearance
+ * so that paths through free cells keep the body away from them. The grid
+ * does not remember which obstacle blocked a cell: to move an obstacle,
+ * clear the cells under its old bounds and stamp again every obstacle
+ * that overlapped them (World::moveObstacle does this).
+ */
+class OccupancyGrid {
+public:
+    explicit OccupancyGrid(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    // Cover width x height cells of cellSize with the lower corner at origin (all cells free)
+    void resize(const Vector2D& origin, Real cellSize, int32_t width, int32_t height);
+    void clear();
+
+    // Cells
+    bool isBlocked(int32_t x, int32_t y) const;    // True outside the grid
+    bool isBlocked(GridCell cell) const;
+    void setBlocked(int32_t x, int32_t y, bool blocked);
+    bool contains(GridCell cell) const;
+
+    // Obstacles: mark every cell the obstacle, grown by clearance, overlaps
+    void markObstacle(const Obstacle& obstacle, Real clearance = 0);
+    void clearCells(const Aabb& box);               // Frees every cell overlapping box
+
+    // Coordinates
+    GridCell toCell(const Vector2D& point) const;   // May lie outside the grid
+    Vector2D getCellCenter(GridCell cell) const;
+
+    // Does the segment between the two cell centers cross only free cells?
+    // Passing exactly through a cell corner needs both side cells free.
+    bool hasLineOfSight(GridCell from, GridCell to) const;
+
+    // Blocked bits (bit i of word i / 64 is cell i) for the path planner.
+    // Rows and columns outside the grid return an all-blocked line.
+    const uint64_t* getRowBits(int32_t y) const;
+    const uint64_t* getColumnBits(int32_t x) const;
+    size_t getWordsPerRow() const;
+    size_t getWordsPerColumn() const;
+
+    // Getters
+    int32_t getWidth() const;
+    int32_t getHeight() const;
+    Real getCellSize() const;
+    Vector2D getOrigin() const;
+    bool isEmpty() const;
+
+private:
+    void fillRow(int32_t y, int32_t minX, int32_t maxX, bool blocked);
+    int32_t toCellX(Real x) const;
+    int32_t toCellY(Real y) const;
+
+    Vector2D origin;
+    Real cellSize;
+    Real inverseCellSize;
+    int32_t width;
+    int32_t height;
+    size_t wordsPerRow;
+    size_t wordsPerColumn;
+    std::pmr::vector<uint64_t> rows;            // height * wordsPerRow
+    std::pmr::vector<uint64_t> columns;         // width * wordsPerColumn
+    std::pmr::vector<uint64_t> blockedLine;     // All ones, for lines outside the grid
+};
+
+#endif // OCCUPANCY_GRID_H
@@ -0,0 +1,83 @@
+/**
+ * @file PathPlanner.h
+ * @brief Jump-point search over an OccupancyGrid, with path smoothing
+ */
+#ifndef PATH_PLANNER_H
+#define PATH_PLANNER_H
+
+#include "OccupancyGrid.h"
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+/**
+ * @class PathPlanner
+ * @brief A* over the jump points of an 8-connected grid
+ *
+ * Moves go to the 8 neighbouring cells (diagonals cost sqrt(2) and may not
+ * cut a blocked corner). Instead of pushing every neighbour, each expansion
+ * jumps in a straight or diagonal line until it reaches a cell where the
+ * optimal path might turn (a jump point, Harabor and Grastien 2011), so
+ * open ground costs no open-list traffic. Straight jumps scan the grid's
+ * row and column bits 64 cells at a time.
+ *
+ * Search state is kept only for the jump points reached, in an open
+ * addressing table stamped with a search number, so planning over a large
+ * grid costs memory in proportion to the obstacles, not the area, and a
+ * new search starts without clearing anything.
+ */
+class PathPlanner {
+public:
+    explicit PathPlanner(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    // Jump points from start to goal (both included). False if either cell
+    // is blocked or the goal cannot be reached.
+    bool findPath(const OccupancyGrid& grid, GridCell start, GridCell goal, std::vector<GridCell>& path);
+
+    // Drop every jump point that the previous kept point can see past
+    void smoothPath(const OccupancyGrid& grid, std::vector<GridCell>& path) const;
+
+    // from and to in world coordinates; waypoints are the smoothed jump
+    // points' cell centers followed by to itself
+    bool planPath(const OccupancyGrid& grid, const Vector2D& from, const Vector2D& to,
+                  std::vector<Vector2D>& waypoints);
+
+    // Getters
+    size_t getExpandedNodes() const;    // During the last findPath()
+
+private:
+    static constexpr uint32_t kNoNode = UINT32_MAX;
+
+    struct Node {
+        uint32_t cell;
+        uint32_t search;    // Slot is empty unless this is the current search
+        float cost;         // From the start
+        uint32_t parent;    // Cell index, kNoNode for the start
+        bool closed;
+    };
+    struct OpenEntry {
+        float estimate;     // cost + heuristic
+        uint32_t cell;
+        bool operator<(const OpenEntry& other) const { return estimate > other.estimate; }   // Min-heap
+    };
+
+    Node* findNode(uint32_t cell);
+    Node& insertNode(uint32_t cell, bool& inserted);
+    void expand(uint32_t cell, float cost, uint32_t parent);
+    void push(uint32_t cell, uint32_t parent, float cost);
+    int32_t jumpStraight(int32_t x, int32_t y, int32_t dx, int32_t dy) const;
+    int32_t jumpDiagonal(int32_t x, int32_t y, int32_t dx, int32_t dy) const;
+    static int32_t scanLine(const uint64_t* line, const uint64_t* sideA, const uint64_t* sideB,
+                            size_t words, int32_t position, int32_t direction, int32_t goal);
+    float heuristic(int32_t x, int32_t y) const;
+
+    std::pmr::vector<Node> nodes;       // Hash table by cell index, jump points only
+    size_t nodeCount;
+    uint32_t search;
+    std::pmr::vector<OpenEntry> open;
+    const OccupancyGrid* grid;      // During findPath()
+    GridCell goal;
+    size_t expandedNodes;
+};
+
+#endif // PATH_PLANNER_H
@@ -0,0 +1,93 @@
+/**
+ * @file PointKernels.h
+ * @brief Vectorized kernels over arrays of points stored as separate x/y spans
+ */
+#ifndef POINT_KERNELS_H
+#define POINT_KERNELS_H
+
+#include "Segment.h"
+#include "Vector2D.h"
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <string_view>
+
+/*
+ * Each kernel applies one Vector2D/Segment/Circle operation to every point
+ * (xs[i], ys[i]). The implementation is picked once at startup: AVX2 or
+ * SSE2 intrinsics on x86 CPUs that support them, a portable loop
+ * otherwise. Results match the scalar classes up to floating-point
+ * rounding. The angle kernels at the end serve the batched kinematics.
+ * Mismatched span sizes are processed up to the shortest one.
+ * Instantiated for float and double.
+ */
+
+// p += offset
+template <typename Scalar>
+void translatePoints(std::span<Scalar> xs, std::span<Scalar> ys, const BasicVector2D<Scalar>& offset);
+
+// p = p.rotate(angle) (about the origin)
+template <typename Scalar>
+void rotatePoints(std::span<Scalar> xs, std::span<Scalar> ys, Scalar angle);
+
+// p *= factor
+template <typename Scalar>
+void scalePoints(std::span<Scalar> xs, std::span<Scalar> ys, Scalar factor);
+
+// out[i] = p.dot(v)
+template <typename Scalar>
+void dotPoints(std::span<const Scalar> xs, std::span<const Scalar> ys,
+               const BasicVector2D<Scalar>& v, std::span<Scalar> out);
+
+// out[i] = p.distance(point)
+template <typename Scalar>
+void distancesToPoint(std::span<const Scalar> xs, std::span<const Scalar> ys,
+                      const BasicVector2D<Scalar>& point, std::span<Scalar> out);
+
+// out[i] = distance from p to the segment [start, end] (as Segment::distanceToPoint)
+template <typename Scalar>
+void distancesToSegment(std::span<const Scalar> xs, std::span<const Scalar> ys,
+                        const BasicVector2D<Scalar>& start, const BasicVector2D<Scalar>& end,
+                        std::span<Scalar> out);
+
+// inside[i] = 1 if the circle contains p (as Circle::contains); returns the number inside
+template <typename Scalar>
+size_t pointsInCircle(std::span<const Scalar> xs, std::span<const Scalar> ys,
+                      const BasicVector2D<Scalar>& center, Scalar radius,
+                      std::span<unsigned char> inside);
+
+// Segments given as endpoint coordinate arrays: segment i runs from
+// (startXs[i], startYs[i]) to (endXs[i], endYs[i])
+template <typename Scalar>
+struct SegmentArrays {
+    std::span<const Scalar> startXs;
+    std::span<const Scalar> startYs;
+    std::span<const Scalar> endXs;
+    std::span<const Scalar> endYs;
+    
+    size_t size() const { return std::min({startXs.size(), startYs.size(), endXs.size(), endYs.size()}); }
+};
+
+// out[i] = squared distance between segments a[i] and b[i] (as Segment::distanceSquaredToSegment)
+template <typename Scalar>
+void segmentPairDistancesSquared(const SegmentArrays<Scalar>& a, const SegmentArrays<Scalar>& b,
+                                 std::span<Scalar> out);
+
+// sines[i], cosines[i] = sinCos(angles[i]) (polynomial, or libm with OOCATCHER_LIBM_TRIG)
+template <typename Scalar>
+void sinCosAngles(std::span<const Scalar> angles, std::span<Scalar> sines, std::span<Scalar> cosines);
+
+// angles[i] = JointLimits{centers[i], halfWidths[i]}.clamp(angles[i]) (see Segment.h)
+template <typename Scalar>
+void clampAngles(std::span<Scalar> angles, std::span<const Scalar> centers, std::span<const Scalar> halfWidths);
+
+// Instruction set in use: "avx2", "sse2" or "portable", chosen at startup
+// unless set below
+const char* getPointKernelInstructionSet();
+
+// Run every kernel on the named instruction set from now on, to compare
+// the paths; false (and nothing changes) if the name is unknown or the CPU
+// lacks it. Not while kernels are running on other threads.
+bool setPointKernelInstructionSet(std::string_view name);
+
+#endif // POINT_KERNELS_H
@@ -0,0 +1,77 @@
+/**
+ * @file ProjectileArray.h
+ * @brief Projectiles stored as parallel arrays for batched stepping
+ */
+#ifndef PROJECTILE_ARRAY_H
+#define PROJECTILE_ARRAY_H
+
+#include "ArchetypeTable.h"
+#include "Components.h"
+#include <memory_resource>
+#include <optional>
+
+// Snapshot of one projectile (the array itself stores it as components)
+struct ProjectileState {
+    Vector2D position;
+    Vector2D velocity;
+    Real radius;
+    Real groundLevel;
+    CircleHandle target;
+    BodyHandle thrower;
+    ProjectileStatus status;
+};
+
+/**
+ * @class ProjectileArray
+ * @brief Ballistic circles (snowballs) as one archetype of components
+ *
+ * A view over an ArchetypeTable of Transform, ProjectilePhysics,
+ * ProjectileShape, ProjectileLinks and ProjectileStatus. Live projectiles
+ * are packed chunk after chunk, so integrating a tick streams through the
+ * position, velocity and status arrays of each chunk and never touches
+ * the shape or links. Handles go through the table's slot table (index +
+ * generation); destroying a projectile moves the last one into its place.
+ * Integration matches Circle::updatePosition with ballistics enabled.
+ */
+class ProjectileArray {
+public:
+    explicit ProjectileArray(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    ProjectileHandle create(const ProjectileState& state);
+    bool destroy(ProjectileHandle handle);
+    bool contains(ProjectileHandle handle) const;
+    std::optional<ProjectileState> get(ProjectileHandle handle) const;
+    size_t getIndex(ProjectileHandle handle) const;    // Packed index, size() if not contained
+
+    size_t size() const;
+
+    // Advance every flying projectile by one time step
+    void integrate(Real timeStep, Real gravity);
+    // Only those in chunks [firstChunk, lastChunk) of the table
+    void integrate(Real timeStep, Real gravity, size_t firstChunk, size_t lastChunk);
+    // The same over many ticks at once, in closed form (equal to stepping
+    // up to rounding)
+    void advance(Real timeStep, Real gravity, uint64_t ticks);
+
+    // Packed access (index < size())
+    Vector2D getPositionAt(size_t index) const { return table.get<Transform>(index).position; }
+    Real getRadiusAt(size_t index) const { return table.get<ProjectileShape>(index).radius; }
+    Real getGroundLevelAt(size_t index) const { return table.get<ProjectileShape>(index).groundLevel; }
+    Vector2D getVelocityAt(size_t index) const { return table.get<ProjectilePhysics>(index).velocity; }
+    CircleHandle getTargetAt(size_t index) const { return table.get<ProjectileLinks>(index).target; }
+    BodyHandle getThrowerAt(size_t index) const { return table.get<ProjectileLinks>(index).thrower; }
+    ProjectileStatus getStatusAt(size_t index) const { return table.get<ProjectileStatus>(index); }
+    void setStatusAt(size_t index, ProjectileStatus status) { table.get<ProjectileStatus>(index) = status; }
+    ProjectileHandle getHandleAt(size_t index) const;
+
+    // The components themselves, for systems that walk them chunk by chunk
+    using Table = ArchetypeTable<ProjectileState, Transform, ProjectilePhysics, ProjectileShape, ProjectileLinks,
+                                 ProjectileStatus>;
+    Table& getTable() { return table; }
+    const Table& getTable() const { return table; }
+
+private:
+    Table table;
+};
+
+#endif // PROJECTILE_ARRAY_H
@@ -0,0 +1,92 @@
+/**
+ * @file Rotation2D.h
+ * @brief A rotation stored as a unit complex number
+ */
+#ifndef ROTATION2D_H
+#define ROTATION2D_H
+
+#include "Vector2D.h"
+#include "FastTrig.h"
+
+/**
+ * @class BasicRotation2D
+ * @brief Rotation by an angle, kept as (cos, sin) together with the angle
+ *
+ * Composing two rotations is a complex multiplication and applying one to
+ * a vector is four multiplies, so a delta rotation built once can be
+ * applied any number of times without evaluating trig functions. The
+ * angle is carried along (summed on composition) so code that needs the
+ * angle itself, e.g. joint limits, does not have to recover it with atan2.
+ */
+template <typename Scalar>
+class BasicRotation2D {
+public:
+    using Vec = BasicVector2D<Scalar>;
+
+    // Identity rotation
+    BasicRotation2D() : cosine(1), sine(0), radians(0) {}
+
+    // Rotation by an angle (one sinCos evaluation)
+    explicit BasicRotation2D(Scalar angle) : radians(angle) {
+        SinCos<Scalar> sc = sinCos(angle);
+        cosine = sc.cos;
+        sine = sc.sin;
+    }
+
+    // Conversion from a rotation with another scalar type
+    template <typename OtherScalar>
+    explicit BasicRotation2D(const BasicRotation2D<OtherScalar>& other)
+        : cosine(static_cast<Scalar>(other.getCos())),
+          sine(static_cast<Scalar>(other.getSin())),
+          radians(static_cast<Scalar>(other.getAngle())) {}
+
+    // Getters
+    Scalar getCos() const { return cosine; }
+    Scalar getSin() const { return sine; }
+    Scalar getAngle() const { return radians; }
+
+    // Rotation by this angle followed by other (complex multiplication)
+    BasicRotation2D operator*(const BasicRotation2D& other) const {
+        return BasicRotation2D(cosine * other.cosine - sine * other.sine,
+                               sine * other.cosine + cosine * other.sine,
+                               radians + other.radians);
+    }
+
+    BasicRotation2D& operator*=(const BasicRotation2D& other) {
+        return *this = *this * other;
+    }
+
+    // Rotation by the opposite angle (complex conjugate)
+    BasicRotation2D inverse() const {
+        return BasicRotation2D(cosine, -sine, -radians);
+    }
+
+    // Rotate a vector about the origin
+    Vec apply(const Vec& v) const {
+        return Vec(v.x * cosine - v.y * sine, v.x * sine + v.y * cosine);
+    }
+
+    // Unit vector pointing along the angle
+    Vec direction() const {
+        return Vec(cosine, sine);
+    }
+
+    // Pull the magnitude back to 1 after many compositions (one Newton step)
+    BasicRotation2D normalized() const {
+        Scalar scale = (Scalar(3) - (cosine * cosine + sine * sine)) * Scalar(0.5);
+        return BasicRotation2D(cosine * scale, sine * scale, radians);
+    }
+
+private:
+    BasicRotation2D(Scalar cosine, Scalar sine, Scalar radians)
+        : cosine(cosine), sine(sine), radians(radians) {}
+
+    Scalar cosine;   // Real part
+    Scalar sine;     // Imaginary part
+    Scalar radians;  // Angle represented by (cosine, sine)
+};
+
+// Simulation precision (see Precision.h)
+using Rotation2D = BasicRotation2D<Real>;
+
+#endif // ROTATION2D_H
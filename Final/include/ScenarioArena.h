@@ -0,0 +1,96 @@
+/**
+ * @file ScenarioArena.h
+ * @brief Scenario-scoped memory arena for bodies, targets and strategies
+ */
+#ifndef SCENARIO_ARENA_H
+#define SCENARIO_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+
+/**
+ * @class CountingResource
+ * @brief Memory resource that forwards to another one and counts the traffic
+ */
+class CountingResource : public std::pmr::memory_resource {
+public:
+    explicit CountingResource(std::pmr::memory_resource* upstream);
+
+    // Getters
+    size_t getAllocationCount() const;
+    size_t getAllocatedBytes() const;
+    size_t getDeallocationCount() const;
+
+    // Reset the counters (not the upstream)
+    void resetCounts();
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    std::pmr::memory_resource* upstream;
+    size_t allocations;
+    size_t bytes;
+    size_t deallocations;
+};
+
+/**
+ * @class ScenarioArena
+ * @brief Monotonic arena that everything created for one scenario draws from
+ *
+ * Bodies (segment map, names, index caches), targets, strategies and their
+ * move queues are allocated from getResource(); deallocation is a no-op and
+ * release() drops the whole scenario at once by resetting a pointer to the
+ * start of the arena buffer. If a scenario overflowed the buffer, release()
+ * returns the overflow chunks and regrows the buffer once to the peak size,
+ * so back-to-back scenarios settle to zero upstream allocations.
+ *
+ * Everything allocated from the arena must be destroyed before release().
+ */
+class ScenarioArena {
+public:
+    // Arena traffic since the last release
+    struct Report {
+        size_t arenaAllocations;      // Requests served by the arena
+        size_t arenaBytes;            // Bytes handed out by the arena
+        size_t upstreamAllocations;   // Overflow chunks taken from the global heap
+        size_t upstreamBytes;
+        size_t capacity;              // Size of the arena buffer
+    };
+
+    explicit ScenarioArena(size_t initialBytes = kDefaultCapacity);
+
+    ScenarioArena(const ScenarioArena&) = delete;
+    ScenarioArena& operator=(const ScenarioArena&) = delete;
+
+    // Resource to pass to the core types (Body, WalkerStrategy, ...)
+    std::pmr::memory_resource* getResource();
+
+    // Drop everything allocated since the last release
+    void release();
+
+    Report getReport() const;
+
+    // shared_ptr whose object and control block live in the arena
+    template <typename T, typename... Args>
+    std::shared_ptr<T> makeShared(Args&&... args) {
+        return std::allocate_shared<T>(std::pmr::polymorphic_allocator<T>(getResource()),
+                                       std::forward<Args>(args)...);
+    }
+
+    static constexpr size_t kDefaultCapacity = 64 * 1024;
+
+private:
+    void resetBuffer(size_t bytes);
+
+    std::unique_ptr<std::byte[]> buffer;
+    size_t capacity;
+    CountingResource upstream;                              // Global heap, counted
+    std::optional<std::pmr::monotonic_buffer_resource> monotonic;
+    std::optional<CountingResource> arena;                  // What callers see
+};
+
+#endif // SCENARIO_ARENA_H
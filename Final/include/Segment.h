@@ -6,8 +6,13 @@
 #define SEGMENT_H
 
 #include "Vector2D.h"
+#include "Rotation2D.h"
+#include "Terrain.h"
 #include <string>
+#include <string_view>
 #include <memory>
+#include <memory_resource>
+#include <algorithm>
 #include <cmath>   // For M_PI
 
 // Define M_PI if not available
@@ -15,59 +20,139 @@
 #define M_PI 3.14159265358979323846
 #endif
 
-class Segment {
+/**
+ * @struct BasicJointLimits
+ * @brief Joint limits stored as an arc: center +/- halfWidth
+ *
+ * Limits are given as (minAngle, maxAngle) in whatever convention suits
+ * the joint (-pi..0, 0..2pi, or min > max for an arc through 0). They are
+ * converted once into this form; clamping then wraps the offset from the
+ * center into [-pi, pi] and limits it with a min/max pair, without fmod
+ * or branches. Clamped angles lie in [center - halfWidth, center + halfWidth],
+ * i.e. in the convention the limits were given in.
+ */
+template <typename Scalar>
+struct BasicJointLimits {
+    Scalar center;      // Middle of the allowed arc
+    Scalar halfWidth;   // Half of its length (pi for an unrestricted joint)
+    
+    // Counterclockwise arc from minAngle to maxAngle (wraps through 0 if min > max)
+    static BasicJointLimits fromRange(Scalar minAngle, Scalar maxAngle) {
+        const Scalar twoPi = Scalar(2 * M_PI);
+        Scalar span = maxAngle - minAngle;
+        if (span < 0) {
+            span += twoPi;
+        }
+        span = std::min(span, twoPi);
+        return {minAngle + span * Scalar(0.5), span * Scalar(0.5)};
+    }
+    
+    Scalar getMin() const { return center - halfWidth; }
+    Scalar getMax() const { return center + halfWidth; }
+    
+    // Same direction as angle, expressed within [center - pi, center + pi]
+    Scalar wrap(Scalar angle) const {
+        return center + wrappedOffset(angle);
+    }
+    
+    // Whether the angle's direction lies on the arc
+    bool contains(Scalar angle) const {
+        using std::abs;
+        return abs(wrappedOffset(angle)) <= halfWidth;
+    }
+    
+    // Closest allowed angle
+    Scalar clamp(Scalar angle) const {
+        Scalar offset = wrappedOffset(angle);
+        return center + std::min(std::max(offset, -halfWidth), halfWidth);
+    }
+    
+private:
+    Scalar wrappedOffset(Scalar angle) const {
+        using std::nearbyint;
+        Scalar offset = angle - center;
+        return offset - Scalar(2 * M_PI) * nearbyint(offset * Scalar(1 / (2 * M_PI)));
+    }
+};
+
+template <typename Scalar>
+class BasicSegment {
 public:
-    // Constructor
-    Segment(const std::string& id, const Vector2D& start, double length, double angle,
-            double minAngle = 0.0, double maxAngle = 2 * M_PI);
+    using Vec = BasicVector2D<Scalar>;
+    using Rotation = BasicRotation2D<Scalar>;
+    using Limits = BasicJointLimits<Scalar>;
+    
+    // Constructor (the id is stored in the given memory resource)
+    BasicSegment(std::string_view id, const Vec& start, Scalar length, Scalar angle,
+                 Scalar minAngle = 0.0, Scalar maxAngle = 2 * M_PI,
+                 std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+    
+    // Copy the geometry of a segment with another scalar type (parent link is not copied)
+    template <typename OtherScalar>
+    explicit BasicSegment(const BasicSegment<OtherScalar>& other);
     
     // Getters
-    std::string getId() const;
-    Vector2D getStart() const;
-    Vector2D getEnd() const;
-    double getLength() const;
-    double getAngle() const;
-    double getMinAngle() const;
-    double getMaxAngle() const;
+    std::string_view getId() const;
+    Vec getStart() const;
+    Vec getEnd() const;
+    Scalar getLength() const;
+    Scalar getAngle() const;
+    Scalar getMinAngle() const;
+    Scalar getMaxAngle() const;
+    const Limits& getLimits() const;
     
     // Setters
-    void setStart(const Vector2D& newStart);
-    void setAngle(double newAngle);
-    void setAngleLimits(double newMin, double newMax);
+    void setStart(const Vec& newStart);
+    void setAngle(Scalar newAngle);
+    void setAngleLimits(Scalar newMin, Scalar newMax);
+    
+    // Set the angle without applying the limits (used to seed derivatives of a pose)
+    void setRawAngle(Scalar newAngle);
     
     // Movement
-    bool rotate(double deltaAngle);
-    bool rotateTo(double targetAngle);
-    void move(const Vector2D& displacement);
+    bool rotate(Scalar deltaAngle);
+    bool rotate(const Rotation& delta);     // Composes (cos, sin) without trig while within limits
+    bool rotateTo(Scalar targetAngle);
+    void move(const Vec& displacement);
     
     // Connected segments
-    void connectTo(std::shared_ptr<Segment> parent);
+    void connectTo(std::shared_ptr<BasicSegment> parent);
     void updateConnectedSegments();
     
     // Check if point is on or near segment
-    bool containsPoint(const Vector2D& point, double threshold = 1.0) const;
+    bool containsPoint(const Vec& point, Scalar threshold = 1.0) const;
     
     // Calculate closest point on segment to a given point
-    Vector2D closestPointTo(const Vector2D& point) const;
+    Vec closestPointTo(const Vec& point) const;
     
     // Calculate distance from a point to this segment
-    double distanceToPoint(const Vector2D& point) const;
+    Scalar distanceToPoint(const Vec& point) const;
+    
+    // Squared distance between this segment and another (0 if they touch or cross)
+    Scalar distanceSquaredToSegment(const BasicSegment& other) const;
     
     // Ground contact detection
-    bool isStartContactingGround(double groundLevel, double threshold = 1.0) const;
-    bool isEndContactingGround(double groundLevel, double threshold = 1.0) const;
+    bool isStartContactingGround(Scalar groundLevel, Scalar threshold = 1.0) const;
+    bool isEndContactingGround(Scalar groundLevel, Scalar threshold = 1.0) const;
+    bool isStartContactingGround(const BasicTerrain<Scalar>& terrain, Scalar threshold = 1.0) const;
+    bool isEndContactingGround(const BasicTerrain<Scalar>& terrain, Scalar threshold = 1.0) const;
 
 private:
-    std::string id;                  // Segment identifier
-    Vector2D start;                  // Start point
-    double length;                   // Length of segment
-    double angle;                    // Current angle in radians
-    double minAngle;                 // Minimum allowed angle
-    double maxAngle;                 // Maximum allowed angle
-    std::weak_ptr<Segment> parent;   // Parent segment (if any)
+    template <typename OtherScalar>
+    friend class BasicSegment;
+    
+    std::pmr::string id;             // Segment identifier
+    Vec start;                       // Start point
+    Scalar length;                   // Length of segment
+    Limits limits;                   // Allowed angles (initialized before the angle is clamped)
+    Rotation orientation;            // Current angle in radians with its cos/sin
+    std::weak_ptr<BasicSegment> parent;   // Parent segment (if any)
     
     // Helper for angle constraints
-    double clampAngle(double angle) const;
+    Scalar clampAngle(Scalar angle) const;
 };
 
-#endif // SEGMENT_H
\ No newline at end of file
+// Simulation precision (see Precision.h)
+using Segment = BasicSegment<Real>;
+
+#endif // SEGMENT_H
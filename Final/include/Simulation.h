@@ -8,6 +8,8 @@
 #include "MovementStrategy.h"
 #include "WalkerStrategy.h"
 #include "SnowballStrategy.h"
+#include "World.h"
+#include "SimulationCommand.h"
 #include <SFML/Graphics.hpp>
 #include <memory>
 #include <string>
@@ -20,6 +22,11 @@
  * - Builder: To construct the body with segments
  * - Strategy: To implement different movement behaviors
  * - Singleton: For the logging functionality
+ *
+ * Input never runs the simulation itself: handleInput (and any other
+ * source, through submitCommand) pushes commands on a lock-free queue, and
+ * update applies them (processCommands) at the start of each tick. A key
+ * press costs one push however long replanning takes.
  */
 class Simulation {
 public:
@@ -34,32 +41,61 @@ public:
     // Set the simulation mode
     void setMode(Mode mode);
     
-    // Run the simulation for a single frame
+    // Run the simulation for a single frame: apply the queued commands, then
+    // advance
     void update(float deltaTime);
     
     // Draw the simulation
     void draw(sf::RenderWindow& window);
     
-    // Handle user input
+    // Handle user input: queues the matching command
     void handleInput(const sf::Event& event);
     
+    // Queue a command from any thread; false if the queue is full
+    bool submitCommand(const SimulationCommand& command);
+    
+    // Apply the queued commands, in order, on the simulation thread; update
+    // calls this first. Returns the number applied.
+    size_t processCommands();
+    
     // Get information about the current state
     bool isComplete() const;
+    size_t getDroppedCommandCount() const;
+    int64_t getMaxCommandLatency() const;     // Nanoseconds from submit to applied
     
 private:
     // Initialize different modes
     void initializeWalkerMode();
     void initializeSnowballMode();
     
+    void applyCommand(const SimulationCommand& command);
+    
+    // One frame of the current strategy, without draining the queue (a STEP
+    // command applies this, so it cannot re-enter processCommands)
+    void advance(float deltaTime);
+    
     // Create a body using the Builder pattern
-    std::shared_ptr<Body> createBody();
+    BodyHandle createBody();
+    
+    // Resolve the handles (the world owns both entities)
+    Body* getBody() { return world.getBody(body); }
+    Circle* getTarget() { return world.getCircle(target); }
     
     // Member variables
-    std::shared_ptr<Body> body;
-    std::shared_ptr<Circle> target;
+    World world;
+    BodyHandle body;
+    CircleHandle target;
     std::shared_ptr<Logger> logger;
     std::unique_ptr<MovementStrategy> currentStrategy;
     
+    // Segment lines reused by every frame (grows only when the skeleton does)
+    std::vector<std::pair<Vector2D, Vector2D>> segmentLines;
+    
+    // Commands from the input sources, drained at tick boundaries
+    static constexpr size_t kCommandCapacity = 256;
+    SimulationCommandQueue commands;
+    int64_t maxCommandLatency;
+    
     Mode currentMode;
     bool simulationComplete;
     
@@ -0,0 +1,45 @@
+/**
+ * @file SimulationCommand.h
+ * @brief Commands that input sources hand to the simulation thread
+ */
+#ifndef SIMULATION_COMMAND_H
+#define SIMULATION_COMMAND_H
+
+#include "CommandQueue.h"
+#include <cstdint>
+#include <istream>
+
+enum class CommandType { WALKER_MODE, SNOWBALL_MODE, STEP, RESET };
+
+/**
+ * @struct SimulationCommand
+ * @brief One input event, applied by the simulation at its next tick boundary
+ *
+ * Keyboard, scripts and any other control source turn their input into
+ * these and push them on a SimulationCommandQueue; only the simulation
+ * thread changes the simulation, so an input source never waits on
+ * planning.
+ */
+struct SimulationCommand {
+    CommandType type;
+    float deltaTime;        // STEP only
+    int64_t issuedAt;       // steady_clock nanoseconds, for latency
+};
+
+using SimulationCommandQueue = CommandQueue<SimulationCommand>;
+
+// A command stamped with the current time
+SimulationCommand makeCommand(CommandType type, float deltaTime = 0.0f);
+
+// steady_clock nanoseconds, comparable with issuedAt
+int64_t getCommandClock();
+
+// The text front ends' simulation keys: s=step, w=walker, b=snowball,
+// r=reset (a and q stay with the front end)
+bool parseCommand(char key, SimulationCommand& command, float stepTime = 0.1f);
+
+// Push every command key in a script (whitespace between keys is skipped,
+// unknown keys reported); returns the number pushed
+size_t submitScript(std::istream& script, SimulationCommandQueue& queue, float stepTime = 0.1f);
+
+#endif // SIMULATION_COMMAND_H
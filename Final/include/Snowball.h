@@ -8,16 +8,17 @@
 #include "Body.h"
 #include "Circle.h"
 #include "Logger.h"
+#include "World.h"
 #include <memory>
 #include <vector>
 
 class Snowball {
 public:
-    // Constructor
-    Snowball(double radius = 10.0, double gravityValue = 9.8);
+    // Constructor (thrower and target are resolved through the world)
+    Snowball(World& world, double radius = 10.0, double gravityValue = 9.8);
     
     // Set the body that will throw this snowball
-    void setThrower(const std::shared_ptr<Body>& body);
+    void setThrower(BodyHandle body);
     
     // Get the snowball circle (for collision detection)
     const Circle& getCircle() const;
@@ -41,7 +42,7 @@ public:
     double getRadius() const;
     
     // Target interaction
-    void setTarget(const std::shared_ptr<Circle>& target);
+    void setTarget(CircleHandle target);
     bool checkTargetHit();
     
     // Enable logging
@@ -53,9 +54,10 @@ private:
     bool active;                  // Whether the snowball is currently in flight
     bool hitTarget;               // Whether the snowball has hit its target
     bool hitGround;               // Whether the snowball has hit the ground
-    std::weak_ptr<Body> thrower;  // The body that throws this snowball
-    std::weak_ptr<Circle> target; // The target to hit
-    double groundLevel;           // The y-coordinate of the ground
+    World* world;                 // Owner of the thrower and target
+    BodyHandle thrower;           // The body that throws this snowball
+    CircleHandle target;          // The target to hit
+    Terrain terrain;              // Ground, taken from the thrower
     
     // Optional logger
     std::shared_ptr<Logger> logger;
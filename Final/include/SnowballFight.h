@@ -0,0 +1,99 @@
+/**
+ * @file SnowballFight.h
+ * @brief Team mode: many bodies throwing snowballs at each other
+ */
+#ifndef SNOWBALL_FIGHT_H
+#define SNOWBALL_FIGHT_H
+
+#include "World.h"
+#include "KdTree.h"
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+/**
+ * @class SnowballFight
+ * @brief Fighters on teams, each with a hit circle over its torso
+ *
+ * Every step() the fighters pace back and forth, then those whose throw
+ * timer fell due (on the world's timing wheel, so idle fighters are not
+ * looked at) pick the nearest fighter of another team (one KdTree per
+ * team, rebuilt from the moved positions) and throw at where that fighter
+ * will be when the snowball arrives. The world resolves the impacts from its
+ * event queue (World::enableImpactEvents with the pacing speed), so a
+ * tick looks at the impacts that fall due, not every snowball against its
+ * target. The fighters pace every tick, so the fight never skips ticks
+ * with advanceToNextImpact. Its throws are short and their targets keep
+ * moving, so most target events are predicted again within a few ticks.
+ * That costs somewhat more than the plain tests (--fight times both).
+ */
+class SnowballFight {
+public:
+    explicit SnowballFight(World& world);
+
+    // The body joins a team; its hit circle is created in the world
+    void addFighter(BodyHandle body, uint32_t team);
+
+    // Move, aim and throw, advance the world, then score the impacts. The
+    // fight drives the world: throws are due by the world's timers, which
+    // only show the last step's.
+    void step(double timeStep);
+
+    // Getters and setters
+    size_t getFighterCount() const;
+    size_t getTeamCount() const;
+    size_t getScore(uint32_t team) const;       // Hits scored by the team's throwers
+    size_t getThrows() const;
+    size_t getHits() const;
+    size_t getMisses() const;
+    double getMoveSpeed() const;                // Pacing speed, units per second
+    void setMoveSpeed(double speed);
+    double getThrowInterval() const;            // Seconds between one fighter's throws
+    void setThrowInterval(double seconds);
+    double getSnowballRadius() const;
+    void setSnowballRadius(double radius);
+    double getHitRadius() const;                // For fighters added after the call
+    void setHitRadius(double radius);
+
+private:
+    struct Fighter {
+        BodyHandle body;
+        CircleHandle hitCircle;
+        uint32_t team;
+        Real homeX;         // Paces within paceRange of here
+        Real velocityX;
+        TimerHandle throwTimer;
+    };
+    struct Team {
+        explicit Team(std::pmr::memory_resource* resource);
+        std::pmr::vector<uint32_t> members;     // Fighter indices
+        std::pmr::vector<Vector2D> positions;   // Of the hit circles, by member
+        KdTree tree;                            // Over positions
+        size_t score;
+    };
+
+    void moveFighters(Real timeStep);
+    void rebuildTeamTrees();
+    uint32_t findNearestEnemy(const Fighter& fighter) const;
+    void throwAt(const Fighter& thrower, const Fighter& target, Real timeStep);
+    void scheduleThrow(uint32_t fighter, double delay, double timeStep);
+    void scoreImpacts();
+
+    World* world;
+    std::pmr::vector<Fighter> fighters;
+    std::vector<Team> teams;
+    std::pmr::vector<uint32_t> fighterOfBody;       // Body slot -> fighter index
+    std::pmr::vector<uint32_t> unscheduled;         // Added since the last step, no throw timer yet
+    double moveSpeed;
+    double paceRange;
+    double throwInterval;
+    double snowballRadius;
+    double hitRadius;
+    double hitHeight;       // Hit circle center above the base
+    double releaseHeight;   // Snowballs leave this far above the base
+    size_t throws;
+    size_t hits;
+    size_t misses;
+};
+
+#endif // SNOWBALL_FIGHT_H
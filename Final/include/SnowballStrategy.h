@@ -13,7 +13,7 @@
  */
 class SnowballStrategy : public MovementStrategy {
 public:
-    SnowballStrategy(std::shared_ptr<Body> body, std::shared_ptr<Circle> target, 
+    SnowballStrategy(World& world, BodyHandle body, CircleHandle target, 
                      double snowballRadius = 10.0, double gravity = 9.8);
     
     // Core strategy interface implementation
@@ -39,6 +39,7 @@ private:
     // Physics state
     bool active;
     Vector2D position;
+    Vector2D previousPosition;  // Before the last physics update
     Vector2D velocity;
     double gravity;
     double radius;
@@ -0,0 +1,126 @@
+/**
+ * @file SpatialGrid.h
+ * @brief Uniform-grid spatial hash used as a broadphase for proximity queries
+ */
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include "Vector2D.h"
+#include <algorithm>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+/**
+ * @class SpatialGrid
+ * @brief Axis-aligned boxes hashed into uniform square cells
+ *
+ * Usage per tick: clear(), insert() every item with its bounding box and a
+ * caller-chosen value (typically an index into the caller's own arrays),
+ * then build(). build() counting-sorts the (item, cell) entries by hash
+ * bucket straight into one flat array, so a rebuild is O(items) with no per-cell
+ * allocations and a query walks a few contiguous runs.
+ *
+ * query() reports every item whose box overlaps the query box exactly
+ * once; the exact test (segment distance, circle intersection) is left to
+ * the caller. Items covering more than kMaxCellsPerItem cells are kept in
+ * a separate list that every query scans.
+ */
+class SpatialGrid {
+public:
+    static constexpr size_t kMaxCellsPerItem = 64;
+
+    explicit SpatialGrid(Real cellSize = 64.0,
+                         std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    // Building (the index reflects the items inserted before the last build())
+    void clear();
+    void insert(uint32_t value, const Vector2D& min, const Vector2D& max);
+    void build();
+
+    // Call visit(value) for every item whose box overlaps [min, max]
+    template <typename Visitor>
+    void query(const Vector2D& min, const Vector2D& max, Visitor&& visit) const;
+
+    // Getters and setters
+    size_t size() const;
+    Real getCellSize() const;
+    void setCellSize(Real cellSize);    // Takes effect at the next build()
+
+private:
+    struct CellRange {
+        int32_t minX, minY, maxX, maxY;
+    };
+    struct Item {
+        Vector2D min;
+        Vector2D max;
+        CellRange cells;
+        uint32_t value;
+        bool large;     // In largeItems rather than in the cells
+    };
+    struct Entry {
+        uint32_t item;
+        int32_t cellX, cellY;
+    };
+
+    int32_t toCell(Real coordinate) const;
+    CellRange toCells(const Vector2D& min, const Vector2D& max) const;
+    uint32_t bucketOf(int32_t cellX, int32_t cellY) const;
+    static bool overlaps(const Item& item, const Vector2D& min, const Vector2D& max);
+
+    Real cellSize;
+    Real inverseCellSize;
+    std::pmr::vector<Item> items;
+    std::pmr::vector<uint32_t> largeItems;      // Too many cells to hash
+    std::pmr::vector<Entry> entries;            // Grouped by bucket
+    std::pmr::vector<uint32_t> bucketStarts;    // bucketCount + 1 offsets into entries
+    uint32_t bucketMask;
+};
+
+template <typename Visitor>
+void SpatialGrid::query(const Vector2D& min, const Vector2D& max, Visitor&& visit) const {
+    for (uint32_t index : largeItems) {
+        if (overlaps(items[index], min, max)) {
+            visit(items[index].value);
+        }
+    }
+    if (entries.empty()) {
+        return;
+    }
+
+    // A query wider than the index is cheaper as a plain scan
+    CellRange range = toCells(min, max);
+    uint64_t cellCount = uint64_t(int64_t(range.maxX) - range.minX + 1) *
+                         uint64_t(int64_t(range.maxY) - range.minY + 1);
+    if (cellCount > entries.size()) {
+        for (const Item& item : items) {
+            if (!item.large && overlaps(item, min, max)) {
+                visit(item.value);
+            }
+        }
+        return;
+    }
+
+    for (int32_t cellY = range.minY; cellY <= range.maxY; cellY++) {
+        for (int32_t cellX = range.minX; cellX <= range.maxX; cellX++) {
+            uint32_t bucket = bucketOf(cellX, cellY);
+            for (uint32_t e = bucketStarts[bucket]; e < bucketStarts[bucket + 1]; e++) {
+                const Entry& entry = entries[e];
+                if (entry.cellX != cellX || entry.cellY != cellY) {
+                    continue;   // Another cell hashed into the same bucket
+                }
+                // Report an item only from the first cell it shares with the query
+                const Item& item = items[entry.item];
+                if (cellX != std::max(item.cells.minX, range.minX) ||
+                    cellY != std::max(item.cells.minY, range.minY)) {
+                    continue;
+                }
+                if (overlaps(item, min, max)) {
+                    visit(item.value);
+                }
+            }
+        }
+    }
+}
+
+#endif // SPATIAL_GRID_H
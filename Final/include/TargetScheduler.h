@@ -0,0 +1,89 @@
+/**
+ * @file TargetScheduler.h
+ * @brief Orders many targets into one short walking route for a body
+ */
+#ifndef TARGET_SCHEDULER_H
+#define TARGET_SCHEDULER_H
+
+#include "EntityHandles.h"
+#include "KdTree.h"
+#include <chrono>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+class World;
+
+/**
+ * @class TargetScheduler
+ * @brief Open tour from the body through its targets (start fixed, end free)
+ *
+ * The tour starts as the greedy nearest-unvisited walk, answered by a
+ * KdTree that drops each target once it is taken. It is then improved by
+ * 2-opt (reverse a stretch of the tour) and Or-opt (move one to three
+ * consecutive targets elsewhere, either way round) until neither finds a
+ * shorter tour or the time budget runs out. Both only try moves that join
+ * a target to one of its nearest neighbours, so a pass costs
+ * O(targets * neighbours) and thousands of targets fit a budget of a few
+ * milliseconds.
+ *
+ * Distances are straight lines; around obstacles the walker's path is
+ * planned per leg as before.
+ */
+class TargetScheduler {
+public:
+    explicit TargetScheduler(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    // Visiting order of the points from start, as indices into points
+    void planTour(const Vector2D& start, std::span<const Vector2D> points, std::vector<uint32_t>& order);
+
+    // The body's reachable targets in visiting order; returns how many
+    // were left out (destroyed or unreachable)
+    size_t planRoute(const World& world, const Body& body, std::span<const CircleHandle> targets,
+                     std::vector<CircleHandle>& route);
+
+    // Can the body, walking on the ground, get a hand to the target? Too
+    // high above the ground, buried in it, or inside an obstacle is not.
+    static bool isReachable(const World& world, const Body& body, const Circle& target);
+    // Furthest a segment end can get from the base, all joints unfolded
+    static Real getReachDistance(const Body& body);
+
+    // Getters and setters
+    double getTimeBudget() const;           // Seconds spent improving the greedy tour
+    void setTimeBudget(double seconds);
+    size_t getNeighbourCount() const;       // Candidates per target in 2-opt and Or-opt
+    void setNeighbourCount(size_t count);
+    double getGreedyLength() const;         // During the last planTour()
+    double getTourLength() const;
+    size_t getImprovingMoves() const;
+
+private:
+    static constexpr uint32_t kNoCity = UINT32_MAX;
+
+    void buildGreedyTour();
+    void buildNeighbourLists();
+    bool improveTwoOpt();
+    bool improveOrOpt();
+    void reverseTour(size_t first, size_t last);
+    void updatePositions(size_t first, size_t last);
+    double distance(uint32_t a, uint32_t b) const;  // 0 if either is kNoCity
+    uint32_t cityAt(size_t position) const;         // kNoCity past the end
+    bool isOutOfTime();
+
+    double timeBudget;
+    size_t neighbourCount;
+    std::pmr::vector<Vector2D> cities;          // 0 is the start
+    std::pmr::vector<uint32_t> tour;            // Cities in visiting order, tour[0] = 0
+    std::pmr::vector<uint32_t> positionOf;      // City -> index in tour
+    std::pmr::vector<uint32_t> neighbours;      // neighbourCount per city, nearest first, kNoCity padded
+    KdTree tree;
+    std::chrono::steady_clock::time_point deadline;
+    size_t timeChecks;
+    bool outOfTime;
+    double greedyLength;
+    double tourLength;
+    size_t improvingMoves;
+};
+
+#endif // TARGET_SCHEDULER_H
@@ -0,0 +1,78 @@
+/**
+ * @file Terrain.h
+ * @brief Ground shape: a flat level or a piecewise-linear heightfield
+ */
+#ifndef TERRAIN_H
+#define TERRAIN_H
+
+#include "Vector2D.h"
+#include <memory>
+#include <vector>
+
+/**
+ * @class BasicTerrain
+ * @brief Ground height (y, growing downwards as everywhere else) over x
+ *
+ * Either one flat ground level or heights sampled every `spacing` units
+ * from originX, joined by straight lines and held at the end heights
+ * beyond the samples. A lookup is one subtraction, one multiply and one
+ * lerp; flat ground skips even that, so the single groundLevel the
+ * simulation started with costs what it always did.
+ *
+ * The samples are immutable and shared between copies, so every body on
+ * a level can hold the same terrain by value.
+ */
+template <typename Scalar>
+class BasicTerrain {
+public:
+    using Vec = BasicVector2D<Scalar>;
+
+    // Flat ground
+    BasicTerrain(Scalar groundLevel = 400.0);
+    // Heightfield: heights[i] is the ground at originX + i * spacing
+    BasicTerrain(Scalar originX, Scalar spacing, std::vector<Scalar> heights);
+
+    template <typename OtherScalar>
+    explicit BasicTerrain(const BasicTerrain<OtherScalar>& other);
+
+    // Ground height and upward unit normal at x
+    Scalar getHeightAt(Scalar x) const;
+    Vec getNormalAt(Scalar x) const;
+    Scalar getSlopeAt(Scalar x) const;      // dy/dx of the ground
+
+    // Is the point within threshold of the ground, measured vertically?
+    bool isTouching(const Vec& point, Scalar threshold) const;
+    // Is the point on or below the ground?
+    bool isBelow(const Vec& point) const;
+
+    // First point of the segment from -> to on or below the ground, as a
+    // fraction along the segment (0 if from is already below). Exact
+    // against the piecewise-linear ground; visits only the samples between
+    // from.x and to.x.
+    bool intersectSegment(const Vec& from, const Vec& to, Scalar& fraction) const;
+
+    // Getters
+    bool isFlat() const;
+    Scalar getGroundLevel() const;          // Flat level, or the height at originX
+    Scalar getOriginX() const;
+    Scalar getSpacing() const;
+    size_t getSampleCount() const;
+
+private:
+    template <typename OtherScalar>
+    friend class BasicTerrain;
+
+    // Sample interval containing x, clamped to the samples, and the position in it
+    size_t intervalAt(Scalar x, Scalar& t) const;
+
+    Scalar groundLevel;
+    Scalar originX;
+    Scalar spacing;
+    Scalar inverseSpacing;
+    std::shared_ptr<const std::vector<Scalar>> heights;    // Null for flat ground
+};
+
+// Simulation precision (see Precision.h)
+using Terrain = BasicTerrain<Real>;
+
+#endif // TERRAIN_H
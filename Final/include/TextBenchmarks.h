@@ -0,0 +1,15 @@
+/**
+ * @file TextBenchmarks.h
+ * @brief Benchmark and check modes of the text front end
+ */
+#ifndef TEXT_BENCHMARKS_H
+#define TEXT_BENCHMARKS_H
+
+// Print the options below, one line each, for the text front end's usage
+void displayBenchmarkUsage();
+
+// Run the mode named by argv[i] (with its arguments after it); false if
+// argv[i] names no benchmark or check
+bool runBenchmark(int argc, char** argv, int i);
+
+#endif // TEXT_BENCHMARKS_H
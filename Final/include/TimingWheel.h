@@ -0,0 +1,94 @@
+/**
+ * @file TimingWheel.h
+ * @brief Hierarchical timing wheel for one-shot simulation-time timers
+ */
+#ifndef TIMING_WHEEL_H
+#define TIMING_WHEEL_H
+
+#include "Handle.h"
+#include <array>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+// A pending timer (see TimingWheel); links are pool slot indices
+struct Timer {
+    uint64_t due;           // Tick it falls due at
+    uint64_t payload;       // The scheduler's own, handed back on expiry
+    uint32_t previous;
+    uint32_t next;
+    uint32_t bucket;        // List it is linked into
+};
+
+using TimerHandle = Handle<Timer>;
+
+// A timer that fell due during the last advance
+struct ExpiredTimer {
+    TimerHandle timer;
+    uint64_t payload;
+};
+
+/**
+ * @class TimingWheel
+ * @brief Timers bucketed by due tick in four wheels of 64 slots
+ *
+ * The first wheel has one slot per tick for the next 64 ticks, the second
+ * one slot per 64 ticks, and so on up to 2^24 ticks; later timers wait in
+ * an overflow list. A timer goes into the finest wheel its delay fits, so
+ * scheduling and cancelling are an unlink or link in a doubly linked list,
+ * O(1) whatever the number of timers. Each time the first wheel comes
+ * round, the matching slot of the next wheel is cascaded down into it
+ * (and so on up), which moves each timer at most once per wheel.
+ *
+ * Advancing skips straight to the next occupied slot of the first wheel
+ * (or the next cascade) using a bit mask of the occupied slots, so quiet
+ * ticks cost nothing. Timers that fall due are destroyed and reported by
+ * getExpired() until the next advance, in the order they were scheduled
+ * into their last slot.
+ */
+class TimingWheel {
+public:
+    explicit TimingWheel(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    // Due after the given number of ticks (at least one)
+    TimerHandle schedule(uint64_t ticks, uint64_t payload);
+    bool cancel(TimerHandle timer);
+    void clear();
+
+    // Move the clock forward, collecting the timers that fall due
+    void advance(uint64_t ticks);
+    void advanceTo(uint64_t tick);
+    std::span<const ExpiredTimer> getExpired() const;
+
+    // Getters
+    uint64_t getTick() const;
+    size_t size() const;                    // Pending timers
+    bool isPending(TimerHandle timer) const;
+    uint64_t getDue(TimerHandle timer) const;   // UINT64_MAX if not pending
+    // No timer falls due before this tick (exactly the next due tick when
+    // every pending timer is within 64 ticks); UINT64_MAX if none is pending
+    uint64_t getEarliestDue() const;
+
+private:
+    static constexpr uint32_t kSlotBits = 6;
+    static constexpr uint32_t kSlots = 1u << kSlotBits;
+    static constexpr uint32_t kLevels = 4;
+    static constexpr uint32_t kOverflow = kLevels * kSlots;     // Bucket of the overflow list
+    static constexpr uint32_t kNoTimer = UINT32_MAX;
+
+    Timer& timerAt(uint32_t slot);
+    void insert(uint32_t slot);
+    void unlink(uint32_t slot);
+    void cascade();
+    void expireSlot(uint32_t bucket);
+
+    HandlePool<Timer> timers;
+    std::array<uint32_t, kOverflow + 1> heads;      // First timer per bucket
+    std::array<uint32_t, kOverflow + 1> tails;
+    std::array<uint64_t, kLevels> occupied;         // Bit per non-empty slot
+    std::pmr::vector<ExpiredTimer> expired;
+    uint64_t currentTick;
+};
+
+#endif // TIMING_WHEEL_H
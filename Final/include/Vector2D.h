@@ -5,60 +5,197 @@
 #ifndef VECTOR2D_H
 #define VECTOR2D_H
 
+#include "Precision.h"
+#include "FastTrig.h"
 #include <iostream>
 #include <cmath>
+#include <type_traits>
 
 // Define M_PI if not available
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
-class Vector2D {
+/**
+ * @class BasicVector2D
+ * @brief 2D vector templated on its scalar type
+ *
+ * Header-only value type: every operation is inline (constexpr where the
+ * scalar allows it) and the layout is exactly {x, y}, so the type is
+ * trivially copyable and can be memcpy'd or loaded into SIMD registers.
+ * The simulation uses the Real instantiation (Vector2D); the dual-number
+ * instantiation lets the same kinematics code compute exact derivatives.
+ */
+template <typename Scalar>
+class BasicVector2D {
 public:
     // Public member variables for direct access
-    double x, y;
-    
+    Scalar x, y;
+
+    // Tolerance of operator== (per-component absolute difference)
+    static constexpr double kEqualityEpsilon = 1e-6;
+
     // Constructors
-    Vector2D();
-    Vector2D(double x, double y);
-    Vector2D(const Vector2D& v);
-    
+    constexpr BasicVector2D() : x(0), y(0) {}
+    constexpr BasicVector2D(Scalar x, Scalar y) : x(x), y(y) {}
+
+    // Conversion from a vector with another scalar type
+    template <typename OtherScalar>
+    constexpr explicit BasicVector2D(const BasicVector2D<OtherScalar>& v)
+        : x(static_cast<Scalar>(v.x)), y(static_cast<Scalar>(v.y)) {}
+
     // Arithmetic operators
-    Vector2D operator+(const Vector2D& v) const;
-    Vector2D operator-(const Vector2D& v) const;
-    Vector2D operator*(double scalar) const;
-    Vector2D operator/(double scalar) const;
-    
+    constexpr BasicVector2D operator+(const BasicVector2D& v) const {
+        return BasicVector2D(x + v.x, y + v.y);
+    }
+
+    constexpr BasicVector2D operator-(const BasicVector2D& v) const {
+        return BasicVector2D(x - v.x, y - v.y);
+    }
+
+    constexpr BasicVector2D operator*(Scalar scalar) const {
+        return BasicVector2D(x * scalar, y * scalar);
+    }
+
+    constexpr BasicVector2D operator/(Scalar scalar) const {
+        if (scalar == 0) {
+            return *this;  // Avoid division by zero
+        }
+        return BasicVector2D(x / scalar, y / scalar);
+    }
+
     // Compound assignment operators
-    Vector2D& operator+=(const Vector2D& v);
-    Vector2D& operator-=(const Vector2D& v);
-    Vector2D& operator*=(double scalar);
-    Vector2D& operator/=(double scalar);
-    
-    // Comparison operators
-    bool operator==(const Vector2D& v) const;
-    bool operator!=(const Vector2D& v) const;
-    
+    constexpr BasicVector2D& operator+=(const BasicVector2D& v) {
+        x += v.x;
+        y += v.y;
+        return *this;
+    }
+
+    constexpr BasicVector2D& operator-=(const BasicVector2D& v) {
+        x -= v.x;
+        y -= v.y;
+        return *this;
+    }
+
+    constexpr BasicVector2D& operator*=(Scalar scalar) {
+        x *= scalar;
+        y *= scalar;
+        return *this;
+    }
+
+    constexpr BasicVector2D& operator/=(Scalar scalar) {
+        if (scalar != 0) {
+            x /= scalar;
+            y /= scalar;
+        }
+        return *this;
+    }
+
+    // Comparison operators (approximate, see kEqualityEpsilon)
+    constexpr bool operator==(const BasicVector2D& v) const {
+        return approxEquals(v, kEqualityEpsilon);
+    }
+
+    constexpr bool operator!=(const BasicVector2D& v) const {
+        return !(*this == v);
+    }
+
+    // Component-wise comparison with an explicit tolerance
+    constexpr bool approxEquals(const BasicVector2D& v, Scalar epsilon) const {
+        Scalar dx = x - v.x;
+        Scalar dy = y - v.y;
+        return (dx < 0 ? -dx : dx) < epsilon && (dy < 0 ? -dy : dy) < epsilon;
+    }
+
     // Vector operations
-    double length() const;            // Magnitude of the vector
-    double magnitude() const;         // Alias for length()
-    double lengthSquared() const;     // Squared magnitude (more efficient)
-    double distance(const Vector2D& v) const;       // Distance to another vector
-    double distanceSquared(const Vector2D& v) const;  // Squared distance
-    Vector2D normalized() const;      // Returns a normalized copy
-    Vector2D normalize();             // Normalizes this vector and returns reference
-    
+    Scalar length() const {            // Magnitude of the vector
+        using std::sqrt;
+        return sqrt(x * x + y * y);
+    }
+
+    Scalar magnitude() const {         // Alias for length()
+        return length();
+    }
+
+    constexpr Scalar lengthSquared() const {     // Squared magnitude (more efficient)
+        return x * x + y * y;
+    }
+
+    Scalar distance(const BasicVector2D& v) const {       // Distance to another vector
+        return (*this - v).length();
+    }
+
+    constexpr Scalar distanceSquared(const BasicVector2D& v) const {  // Squared distance
+        return (*this - v).lengthSquared();
+    }
+
+    BasicVector2D normalized() const {      // Returns a normalized copy
+        Scalar len = length();
+        if (len == 0) {
+            return BasicVector2D(0, 0);
+        }
+        return BasicVector2D(x / len, y / len);
+    }
+
+    BasicVector2D normalize() {             // Normalizes this vector and returns reference
+        Scalar len = length();
+        if (len != 0) {
+            x /= len;
+            y /= len;
+        }
+        return *this;
+    }
+
     // Vector products
-    double dot(const Vector2D& v) const;    // Dot product
-    double cross(const Vector2D& v) const;  // 2D cross product (returns scalar)
-    
+    constexpr Scalar dot(const BasicVector2D& v) const {    // Dot product
+        return x * v.x + y * v.y;
+    }
+
+    constexpr Scalar cross(const BasicVector2D& v) const {  // 2D cross product (returns scalar)
+        return x * v.y - y * v.x;
+    }
+
     // Rotation and angles
-    Vector2D rotate(double angle) const;    // Rotate by angle (radians)
-    double angle() const;                   // Angle from origin
-    double angleBetween(const Vector2D& v) const;  // Angle between vectors
+    BasicVector2D rotate(Scalar angle) const {    // Rotate by angle (radians)
+        SinCos<Scalar> sc = sinCos(angle);
+        return BasicVector2D(
+            x * sc.cos - y * sc.sin,
+            x * sc.sin + y * sc.cos
+        );
+    }
+
+    Scalar angle() const {                   // Angle from origin
+        using std::atan2;
+        return atan2(y, x);
+    }
+
+    Scalar angleBetween(const BasicVector2D& v) const {  // Angle between vectors
+        using std::atan2;
+        Scalar dot = this->dot(v);
+        Scalar det = this->cross(v);
+        return atan2(det, dot);
+    }
 };
 
+// Simulation precision (see Precision.h)
+using Vector2D = BasicVector2D<Real>;
+
+static_assert(std::is_trivially_copyable<BasicVector2D<float>>::value &&
+              std::is_trivially_copyable<BasicVector2D<double>>::value,
+              "Vector2D must stay trivially copyable");
+static_assert(sizeof(BasicVector2D<float>) == 2 * sizeof(float) &&
+              sizeof(BasicVector2D<double>) == 2 * sizeof(double),
+              "Vector2D must be laid out as {x, y}");
+
 // Stream operator for easier printing
-std::ostream& operator<<(std::ostream& os, const Vector2D& v);
+template <typename Scalar>
+std::ostream& operator<<(std::ostream& os, const BasicVector2D<Scalar>& v) {
+    os << "(" << v.x << ", " << v.y << ")";
+    return os;
+}
+
+#ifdef OOCATCHER_SIMD_VECTOR2D
+#include "Vector2DSimd.h"
+#endif
 
-#endif // VECTOR2D_H
\ No newline at end of file
+#endif // VECTOR2D_H
@@ -0,0 +1,70 @@
+/**
+ * @file Vector2DSimd.h
+ * @brief Optional SSE2 register form of Vector2D
+ *
+ * Included by Vector2D.h when OOCATCHER_SIMD_VECTOR2D is defined. A vector
+ * is held in one 128-bit register with x in the lowest lane; load/store
+ * go through the {x, y} layout guaranteed by Vector2D.h.
+ */
+#ifndef VECTOR2D_SIMD_H
+#define VECTOR2D_SIMD_H
+
+#include "Vector2D.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+
+template <typename Scalar>
+struct Vector2DRegister;
+
+template <>
+struct Vector2DRegister<double> {
+    __m128d value;
+
+    static Vector2DRegister load(const BasicVector2D<double>& v) {
+        return {_mm_loadu_pd(&v.x)};
+    }
+
+    BasicVector2D<double> store() const {
+        BasicVector2D<double> v;
+        _mm_storeu_pd(&v.x, value);
+        return v;
+    }
+
+    Vector2DRegister operator+(Vector2DRegister other) const { return {_mm_add_pd(value, other.value)}; }
+    Vector2DRegister operator-(Vector2DRegister other) const { return {_mm_sub_pd(value, other.value)}; }
+    Vector2DRegister operator*(double scalar) const { return {_mm_mul_pd(value, _mm_set1_pd(scalar))}; }
+
+    double dot(Vector2DRegister other) const {
+        __m128d product = _mm_mul_pd(value, other.value);
+        return _mm_cvtsd_f64(_mm_add_sd(product, _mm_unpackhi_pd(product, product)));
+    }
+};
+
+template <>
+struct Vector2DRegister<float> {
+    __m128 value;   // x, y in the two low lanes
+
+    static Vector2DRegister load(const BasicVector2D<float>& v) {
+        return {_mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(&v.x)))};
+    }
+
+    BasicVector2D<float> store() const {
+        BasicVector2D<float> v;
+        _mm_store_sd(reinterpret_cast<double*>(&v.x), _mm_castps_pd(value));
+        return v;
+    }
+
+    Vector2DRegister operator+(Vector2DRegister other) const { return {_mm_add_ps(value, other.value)}; }
+    Vector2DRegister operator-(Vector2DRegister other) const { return {_mm_sub_ps(value, other.value)}; }
+    Vector2DRegister operator*(float scalar) const { return {_mm_mul_ps(value, _mm_set1_ps(scalar))}; }
+
+    float dot(Vector2DRegister other) const {
+        __m128 product = _mm_mul_ps(value, other.value);
+        return _mm_cvtss_f32(_mm_add_ss(product, _mm_shuffle_ps(product, product, _MM_SHUFFLE(1, 1, 1, 1))));
+    }
+};
+
+#endif // __SSE2__
+
+#endif // VECTOR2D_SIMD_H
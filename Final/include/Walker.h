@@ -8,6 +8,7 @@
 #include "Body.h"
 #include "Circle.h"
 #include "Logger.h"
+#include "World.h"
 #include <memory>
 #include <vector>
 #include <functional>
@@ -32,8 +33,8 @@ struct SequenceMove {
 
 class Walker {
 public:
-    // Constructor
-    Walker(const std::shared_ptr<Body>& body, double walkSpeed = 5.0);
+    // Constructor (the body is owned by the world)
+    Walker(World& world, BodyHandle body, double walkSpeed = 5.0);
     
     // Update the walker's motion
     bool update(double timeStep);
@@ -59,32 +60,37 @@ public:
     bool hasObjectBeenCaught() const;
     
     // Set the object to catch
-    void setTargetObject(const std::shared_ptr<Circle>& object);
+    void setTargetObject(CircleHandle object);
     
     // Enable logging
     void enableLogging(std::shared_ptr<Logger> logger);
     
+    // End segments a catch reaches with; a catch is all of them on the
+    // object (as WalkerStrategy's kArmCount hands)
+    static constexpr size_t kReachingSegments = 2;
+    
 private:
-    std::shared_ptr<Body> body;                 // The controlled body
-    std::weak_ptr<Circle> targetObject;         // The object to catch
+    World* world;                               // Owner of the body and target
+    BodyHandle bodyHandle;                      // The controlled body
+    CircleHandle targetHandle;                  // The object to catch
     std::vector<SequenceMove> sequence;         // Planned sequence of moves
     int currentMoveIndex;                       // Current position in the sequence
     double walkSpeed;                           // Speed for walking motions
     bool objectCaught;                          // Whether the object has been caught
     
     // Helper methods for planning sequences
-    void addWalkingSequence(const Vector2D& destination);
-    void addReachingSequence(const Vector2D& objectPosition);
-    void addThrowingSequence(const Vector2D& targetPosition);
+    void addWalkingSequence(const Body& body, const Vector2D& destination);
+    void addReachingSequence(const Body& body, const Vector2D& objectPosition);
+    void addThrowingSequence(const Body& body, const Vector2D& targetPosition);
     
     // Helper methods for executing moves
-    bool executeWalkForward(double distance);
-    bool executeWalkBackward(double distance);
-    bool executeReachUp(const std::string& segmentName, double angle);
-    bool executeReachDown(const std::string& segmentName, double angle);
-    bool executeReachLeft(const std::string& segmentName, double angle);
-    bool executeReachRight(const std::string& segmentName, double angle);
-    bool executeResetPose();
+    bool executeWalkForward(Body& body, double distance);
+    bool executeWalkBackward(Body& body, double distance);
+    bool executeReachUp(Body& body, const std::string& segmentName, double angle);
+    bool executeReachDown(Body& body, const std::string& segmentName, double angle);
+    bool executeReachLeft(Body& body, const std::string& segmentName, double angle);
+    bool executeReachRight(Body& body, const std::string& segmentName, double angle);
+    bool executeResetPose(Body& body);
     
     // Logging
     std::shared_ptr<Logger> logger;
@@ -4,6 +4,9 @@
 #include "MovementStrategy.h"
 #include <vector>
 #include <deque>
+#include <memory_resource>
+#include <span>
+#include <string_view>
 
 /**
  * @class WalkerStrategy
@@ -14,7 +17,7 @@
  */
 class WalkerStrategy : public MovementStrategy {
 public:
-    WalkerStrategy(std::shared_ptr<Body> body, std::shared_ptr<Circle> target, double walkSpeed = 5.0);
+    WalkerStrategy(World& world, BodyHandle body, CircleHandle target, double walkSpeed = 5.0);
     
     // Core strategy interface implementation
     void planSequence() override;
@@ -22,28 +25,69 @@ public:
     bool executeNextMove() override;
     bool isSequenceComplete() const override;
     
+    // executeNextMove() in two halves: the move, which only touches the
+    // walker's own body (walkers on different bodies may move at once),
+    // then planning the next target of a route once the moves run out
+    // (on the world's path planner, so one walker at a time)
+    bool executeMove();
+    void continueRoute();
+    
+    // Collect several targets, in the order a TargetScheduler picks, each
+    // caught as a single target is. Returns how many were left out as
+    // unreachable.
+    size_t planCollection(std::span<const CircleHandle> targets, double timeBudget = 0.02);
+    
     // Walker-specific methods
     bool hasObjectBeenCaught() const;
+    size_t getCaughtCount() const;
+    const std::pmr::vector<CircleHandle>& getRoute() const;
     void setWalkSpeed(double speed);
     double getWalkSpeed() const;
     
+    // The arms a catch reaches with, shoulder to hand; a catch is both
+    // hands on the object
+    static constexpr size_t kArmCount = 2;
+    static constexpr size_t kArmSegments = 3;
+    static constexpr std::string_view kArms[kArmCount][kArmSegments] = {
+        {"left_upper_arm", "left_lower_arm", "left_hand"},
+        {"right_upper_arm", "right_lower_arm", "right_hand"}
+    };
+    
+    // Horizontal distance from the base at which the hands close on a
+    // target at shoulder height (middle of the hand of a straight arm).
+    // These two are instantiated for float and double bodies alike
+    template <typename Scalar>
+    static Scalar getReachDistance(const BasicBody<Scalar>& body);
+    
+    // Straighten an arm towards the target, the left one aimed just above
+    // it and the right one just below (each on its own side of its joint
+    // limits). Segments stop at their limits; the reach is undone if it
+    // pushes the arm into another segment. Returns false if undone.
+    template <typename Scalar>
+    static bool reachWithArm(BasicBody<Scalar>& body, size_t arm, const BasicVector2D<Scalar>& target);
+    
 private:
     struct Move {
         enum class Type { WALK, REACH, GRAB };
         Type type;
         Vector2D position;
-        std::string segmentName;
-        double rotationAmount;
+        size_t arm;                     // REACH: index into kArms
     };
     
-    void addWalkingSequence(const Vector2D& targetPos);
-    void addReachingSequence(const Vector2D& targetPos);
-    bool executeWalkMove(const Move& move);
-    bool executeReachMove(const Move& move);
+    void addCatchSequence(const Body& body, const Vector2D& objectPosition);
+    bool startNextTarget(const Body& body);
+    void addWalkingSequence(const Body& body, const Vector2D& targetPos);
+    void addWalkingPath(const Body& body, const std::vector<Vector2D>& waypoints);
+    void addReachingSequence(const Body& body, const Vector2D& targetPos);
+    bool executeWalkMove(Body& body, const Move& move);
+    bool executeReachMove(Body& body, const Move& move);
     
     double walkSpeed;
-    std::deque<Move> plannedMoves;
+    std::pmr::deque<Move> plannedMoves;   // Allocated from the body's memory resource
     bool objectCaught;
+    std::pmr::vector<CircleHandle> route;   // Targets to collect, in order (empty for a single target)
+    size_t routeIndex;                      // The one being chased
+    size_t caughtCount;
     int currentMoveIndex;
     int minGroundContacts;
     int minObjectContacts;
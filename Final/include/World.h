@@ -0,0 +1,306 @@
+/**
+ * @file World.h
+ * @brief Owner of the simulation's bodies, circles, walkers and projectiles
+ */
+#ifndef WORLD_H
+#define WORLD_H
+
+#include "EntityHandles.h"
+#include "EventQueue.h"
+#include "JobSystem.h"
+#include "TimingWheel.h"
+#include "ProjectileArray.h"
+#include "SpatialGrid.h"
+#include "AabbTree.h"
+#include "OccupancyGrid.h"
+#include "PathPlanner.h"
+#include "WalkerStrategy.h"
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <vector>
+
+// One segment of one body (index as in Body::getSegmentAt)
+struct SegmentRef {
+    BodyHandle body;
+    uint32_t segment;
+};
+
+// A projectile that came down during the last step (see World::getImpacts)
+struct ProjectileImpact {
+    ProjectileHandle projectile;
+    CircleHandle target;
+    BodyHandle thrower;
+    ProjectileStatus status;    // HIT_TARGET or HIT_GROUND
+};
+
+// Crowd-level counters (see World::getStats)
+struct WorldStats {
+    size_t bodies;
+    size_t circles;
+    size_t walkers;
+    size_t walkersMoving;       // Walkers with moves left
+    size_t targetsCaught;       // Walkers whose grab succeeded
+    size_t projectilesFlying;
+    size_t projectileHits;      // Since the world was created
+    size_t projectileMisses;    // Projectiles that hit the ground instead
+};
+
+/**
+ * @class World
+ * @brief Owns every entity; everything else refers to them by handle
+ *
+ * Strategies, walkers and snowballs keep generation-checked handles and
+ * resolve them through the world when they act, so the per-tick path is
+ * an index lookup and a generation compare instead of shared_ptr copies
+ * and weak_ptr::lock(). A handle to a destroyed entity resolves to nullptr.
+ *
+ * Bodies, circles and walker strategies live in chunked pools, projectiles
+ * in packed arrays. step() advances every walker by one move and every
+ * projectile by one time step; each entity only touches its own body and
+ * target, so the cost per entity does not grow with the crowd.
+ *
+ * Proximity queries go through uniform grids over the segments and
+ * projectiles and a bounding volume tree over the circles (whose sizes
+ * vary too much for one cell size). step() and creating or destroying
+ * entities mark them stale and the next query rebuilds the grids and
+ * refits the tree, so they cost one update per tick that queries. Moving
+ * a body or circle directly through its pointer needs an explicit
+ * updateSpatialIndex() before querying. step() itself does not query:
+ * each walker's catch and each projectile's hit test look at one known
+ * target, which no index makes cheaper, so a world that never asks
+ * "what is near here" never rebuilds the grids.
+ *
+ * Obstacles are stamped into a navigation grid (once one is set) that
+ * walkers plan their walk on. Creating, moving or destroying an obstacle
+ * only redraws the cells under it.
+ *
+ * By default step() tests every flying projectile against the ground and
+ * its target each tick. With impact events enabled it instead keeps a
+ * time-ordered queue of predicted impacts: the tick a projectile meets
+ * the ground, and the earliest tick it could reach its target if the
+ * target closed in at the maximum target speed. A tick only looks at the
+ * events that fall due; a target event that finds the projectile still
+ * clear is predicted again from there. Each projectile has one pending
+ * event of each kind in an EventQueue, moved in place when predicted
+ * again and dropped by generation once the projectile is gone.
+ * advanceToNextImpact() skips the quiet ticks in between in closed form.
+ * Events only pay off for long, quiet flights (--impact-bench: lobs at
+ * static targets). Short throws at targets that move every tick are
+ * re-predicted nearly every tick, and there the queue costs more than
+ * the plain tests (--fight). With walkers or any per-tick driver (the
+ * fight's pacing), no tick is quiet for advanceToNextImpact to skip.
+ *
+ * Per-body timing (the next throw, a respawn) goes through one timing
+ * wheel counted in ticks: whoever schedules a timer finds it among the
+ * due timers after the step it falls due in, instead of every body
+ * counting down its own delay each tick.
+ *
+ * step() runs in phases on a JobSystem: the walkers' moves (kinematics),
+ * then their planning of the next target, projectile integration, and
+ * the ground and target tests (detection), then resolution. The parallel
+ * phases split their entities into ranges of a fixed size, never by the
+ * number of threads, and write only what their own entities own;
+ * detection fills one impact buffer per range, which resolution applies
+ * in range order. Anything shared (the path planner, the impact list,
+ * the event queue, the counters) is touched in a serial phase, so a tick
+ * comes out bit for bit the same on any number of threads. Walkers must
+ * each drive a body of their own. The moves only run in parallel while
+ * the world allocates from new_delete_resource(): bodies grow scratch
+ * space from the world's resource, and arenas are not thread-safe.
+ */
+class World {
+public:
+    explicit World(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    World(const World&) = delete;
+    World& operator=(const World&) = delete;
+
+    // Entity creation and destruction
+    BodyHandle createBody(const Vector2D& basePosition, double groundLevel);
+    CircleHandle createCircle(const Vector2D& center, double radius);
+    bool destroyBody(BodyHandle handle);
+    bool destroyCircle(CircleHandle handle);
+
+    // Handle resolution (nullptr if the entity no longer exists)
+    Body* getBody(BodyHandle handle) { return bodies.get(handle); }
+    const Body* getBody(BodyHandle handle) const { return bodies.get(handle); }
+    Circle* getCircle(CircleHandle handle) { return circles.get(handle); }
+    const Circle* getCircle(CircleHandle handle) const { return circles.get(handle); }
+
+    // Walkers: a body chasing a target, planned on creation and moved by step().
+    // step() moves the walkers in parallel, so a body has at most one walker:
+    // adding a second one for the same body is refused (null handle)
+    WalkerHandle addWalker(BodyHandle body, CircleHandle target, double walkSpeed = 5.0);
+    // A walker collecting several targets in a scheduled order (see WalkerStrategy::planCollection)
+    WalkerHandle addWalker(BodyHandle body, std::span<const CircleHandle> targets, double walkSpeed = 5.0);
+    bool removeWalker(WalkerHandle handle);
+    WalkerStrategy* getWalker(WalkerHandle handle) { return walkers.get(handle); }
+
+    // Projectiles
+    ProjectileHandle throwSnowball(BodyHandle thrower, CircleHandle target, double radius = 10.0);
+    ProjectileHandle createProjectile(const ProjectileState& state);
+    bool destroyProjectile(ProjectileHandle handle);
+    std::optional<ProjectileState> getProjectile(ProjectileHandle handle) const;
+    size_t removeFinishedProjectiles();
+
+    // Obstacles
+    ObstacleHandle createObstacle(const Obstacle& obstacle);
+    bool destroyObstacle(ObstacleHandle handle);
+    bool moveObstacle(ObstacleHandle handle, const Vector2D& center);
+    const Obstacle* getObstacle(ObstacleHandle handle) const { return obstacles.get(handle); }
+    
+    // Navigation grid over the level; cells within clearance of an obstacle are blocked
+    void setNavigationGrid(const Vector2D& origin, double cellSize, int width, int height, double clearance = 0.0);
+    const OccupancyGrid& getNavigationGrid() const;
+    bool hasNavigationGrid() const;
+    
+    // Smoothed path around the obstacles, ending at 'to' (just 'to' without a
+    // navigation grid). False if no path exists.
+    bool planPath(const Vector2D& from, const Vector2D& to, std::vector<Vector2D>& waypoints);
+    
+    // Ground for every body and projectile, including those created later
+    // (until then each keeps the groundLevel it was created with)
+    void setTerrain(const Terrain& terrain);
+    const Terrain& getTerrain() const;
+    bool hasTerrain() const;
+    
+    // Advance all walkers by one move and all projectiles by timeStep
+    void step(double timeStep);
+    // With impact events: moves every projectile straight to the next
+    // predicted impact (at most maxTicks ahead) in closed form and resolves
+    // it; returns the ticks advanced. Walkers move once per tick, so with
+    // any walker (or without impact events) this is one step(). Never
+    // jumps past a pending timer.
+    uint64_t advanceToNextImpact(double timeStep, uint64_t maxTicks);
+
+    // Timers due after the given number of steps (see above); the payload
+    // is the scheduler's own, handed back in getDueTimers()
+    TimerHandle scheduleTimer(uint64_t ticks, uint64_t payload);
+    bool cancelTimer(TimerHandle timer);
+    bool isTimerPending(TimerHandle timer) const;
+    // Timers that fell due during the last step()
+    std::span<const ExpiredTimer> getDueTimers() const;
+    uint64_t getTickCount() const;      // Steps taken since the world was created
+    
+    // Impacts from predicted events (see above). Circles that projectiles
+    // are aimed at must not move faster than maxTargetSpeed (units per
+    // second); changing the time step, gravity or terrain re-predicts
+    // every projectile.
+    void enableImpactEvents(double maxTargetSpeed);
+    void disableImpactEvents();     // Back to testing every projectile each tick
+    bool usesImpactEvents() const;
+    size_t getPendingImpactEvents() const;
+    size_t getProcessedImpactEvents() const;    // Since the world was created
+    // Projectiles that hit the ground or their target during the last step()
+    std::span<const ProjectileImpact> getImpacts() const;
+
+    // Batch queries (each writes at most out.size() entries and returns the count written)
+    size_t getBodyBasePositions(std::span<Vector2D> out) const;
+    size_t getProjectilePositions(std::span<Vector2D> out) const;
+    size_t findSegmentsTouchingCircle(const Circle& circle, std::span<SegmentRef> out);              // Segment::distanceToPoint
+    size_t findCirclesNear(const Vector2D& point, double radius, std::span<CircleHandle> out);          // Overlapping the disc
+    CircleHandle findClosestCircle(const Vector2D& point);                  // Closest edge; null handle if there are none
+    CircleHandle rayCastCircles(const Vector2D& from, const Vector2D& to);  // First circle crossed going from -> to
+    size_t findProjectilesNear(const Vector2D& point, double radius, std::span<ProjectileHandle> out);  // Center inside the disc
+    WorldStats getStats() const;
+
+    // Getters and setters
+    size_t getBodyCount() const;
+    size_t getCircleCount() const;
+    size_t getWalkerCount() const;
+    size_t getProjectileCount() const;
+    size_t getObstacleCount() const;
+    double getGravity() const;
+    void setGravity(double gravity);
+    std::pmr::memory_resource* getMemoryResource() const;
+    JobSystem* getJobSystem() const;
+    // JobSystem::shared() by default. Only a world on the new/delete
+    // resource moves its walkers in parallel: a walker's move allocates
+    // from the world's resource, and an arena (ScenarioArena) is not
+    // thread-safe, so an arena-backed world keeps them on one thread
+    void setJobSystem(JobSystem* jobs);
+    double getGridCellSize() const;
+    void setGridCellSize(double cellSize);
+
+    // Rebuild the proximity grids now instead of at the next query
+    void updateSpatialIndex();
+
+private:
+    struct BodyWalker {
+        BodyHandle body;
+        WalkerHandle walker;    // The one walker driving body
+    };
+
+    struct DetectedImpact {
+        uint32_t index;     // Packed projectile index
+        ProjectileStatus status;
+    };
+
+    bool isBodyFree(BodyHandle body);     // No live walker on it (sizes bodyWalkers)
+    void moveWalkers();
+    void resolveProjectileHits(Real timeStep);
+    bool hasHitGround(size_t index, Real timeStep) const;
+    void recordImpact(size_t index, ProjectileStatus status);
+    void rebuildImpactEvents();
+    void predictImpacts(size_t index);
+    void predictGroundImpact(size_t index);
+    void predictTargetImpact(size_t index);
+    void scheduleImpact(size_t index, bool ground, uint64_t ticks);
+    void processImpactEvents();
+    void ensureSpatialIndex();
+    CircleHandle circleHandleAt(uint32_t slot) const;
+    Aabb getMarkedBounds(const Obstacle& obstacle) const;
+    void redrawObstacleCells(const Aabb& box);
+
+    std::pmr::memory_resource* resource;   // Bodies allocate their segments here
+    HandlePool<Body> bodies;
+    HandlePool<Circle> circles;
+    HandlePool<WalkerStrategy> walkers;
+    ProjectileArray projectiles;
+    HandlePool<Obstacle> obstacles;
+
+    // Tick phases
+    JobSystem* jobs;
+    std::pmr::vector<WalkerStrategy*> movingWalkers;                    // During the last step()
+    std::pmr::vector<BodyWalker> bodyWalkers;                           // By body slot index
+    std::pmr::vector<std::pmr::vector<DetectedImpact>> detectedImpacts; // One buffer per range of projectiles
+
+    // Proximity grids; item values index gridSegments / the projectile arrays
+    SpatialGrid segmentGrid;
+    SpatialGrid projectileGrid;
+    std::pmr::vector<SegmentRef> gridSegments;
+    
+    // Circle tree; leaf values are circle slot indices, circleLeaves maps them back
+    AabbTree circleTree;
+    std::pmr::vector<int32_t> circleLeaves;
+    bool spatialIndexStale;
+    
+    Terrain terrain;
+    bool terrainSet;
+    
+    // Walking paths
+    OccupancyGrid navigationGrid;
+    PathPlanner pathPlanner;
+    double navigationClearance;
+
+    // Impact events
+    // Ids are projectile slot * 2, plus 1 for the target; the ground comes
+    // before the target within one tick, as resolveProjectileHits() checks them
+    EventQueue impactEvents;
+    std::pmr::vector<ProjectileImpact> impacts;     // During the last step()
+    bool impactEventsEnabled;
+    bool impactEventsStale;     // Re-predict everything at the next step()
+    double impactTimeStep;      // The step the predictions assume
+    double maxTargetSpeed;
+    uint64_t tickCount;
+    size_t processedImpactEvents;
+
+    TimingWheel timers;     // Its tick follows tickCount
+
+    double gravity;
+    size_t projectileHits;
+    size_t projectileMisses;
+};
+
+#endif // WORLD_H
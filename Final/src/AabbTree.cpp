@@ -0,0 +1,263 @@
+/**
+ * @file AabbTree.cpp
+ * @brief Implementation of the BasicAabbTree class
+ */
+#include "../include/AabbTree.h"
+#include "../include/Dual.h"
+
+template <typename Scalar>
+BasicAabbTree<Scalar>::BasicAabbTree(std::pmr::memory_resource* resource)
+    : nodes(resource), freeNodes(resource), scratch(resource),
+      root(kNullNode), leafCount(0), rebuiltPerimeter(0), currentPerimeter(0) {
+}
+
+template <typename Scalar>
+int32_t BasicAabbTree<Scalar>::insert(uint32_t value, const Aabb& box) {
+    int32_t leaf = allocateNode();
+    nodes[leaf] = Node{box, kNullNode, kNullNode, kNullNode, value};
+    leafCount++;
+    if (root == kNullNode) {
+        root = leaf;
+        return leaf;
+    }
+
+    // Descend to the sibling that adds the least perimeter; going further
+    // down costs what the new box adds to every node passed on the way
+    int32_t sibling = root;
+    while (!nodes[sibling].isLeaf()) {
+        const Node& node = nodes[sibling];
+        Scalar combined = node.box.merged(box).perimeter();
+        Scalar pairHere = Scalar(2) * combined;
+        Scalar inherited = Scalar(2) * (combined - node.box.perimeter());
+
+        auto descentCost = [&](int32_t child) {
+            const Aabb& childBox = nodes[child].box;
+            Scalar grown = childBox.merged(box).perimeter();
+            return nodes[child].isLeaf() ? grown + inherited : grown - childBox.perimeter() + inherited;
+        };
+        Scalar leftCost = descentCost(node.left);
+        Scalar rightCost = descentCost(node.right);
+        if (pairHere < leftCost && pairHere < rightCost) {
+            break;
+        }
+        sibling = (leftCost < rightCost) ? node.left : node.right;
+    }
+
+    // New parent for the sibling and the leaf
+    int32_t oldParent = nodes[sibling].parent;
+    int32_t parent = allocateNode();
+    nodes[parent] = Node{box.merged(nodes[sibling].box), oldParent, sibling, leaf, 0};
+    nodes[sibling].parent = parent;
+    nodes[leaf].parent = parent;
+    if (oldParent == kNullNode) {
+        root = parent;
+    } else if (nodes[oldParent].left == sibling) {
+        nodes[oldParent].left = parent;
+    } else {
+        nodes[oldParent].right = parent;
+    }
+
+    // Grow the ancestors' boxes and keep the depth bounded for the query stacks
+    int32_t depth = 1;
+    for (int32_t node = oldParent; node != kNullNode; node = nodes[node].parent) {
+        nodes[node].box = nodes[nodes[node].left].box.merged(nodes[nodes[node].right].box);
+        depth++;
+    }
+    if (depth > kMaxHeight) {
+        rebuild();
+    }
+    return leaf;
+}
+
+template <typename Scalar>
+void BasicAabbTree<Scalar>::remove(int32_t leaf) {
+    int32_t parent = nodes[leaf].parent;
+    freeNode(leaf);
+    leafCount--;
+    if (parent == kNullNode) {
+        root = kNullNode;
+        return;
+    }
+
+    // The sibling takes the parent's place
+    int32_t sibling = (nodes[parent].left == leaf) ? nodes[parent].right : nodes[parent].left;
+    int32_t grandParent = nodes[parent].parent;
+    nodes[sibling].parent = grandParent;
+    freeNode(parent);
+    if (grandParent == kNullNode) {
+        root = sibling;
+        return;
+    }
+    if (nodes[grandParent].left == parent) {
+        nodes[grandParent].left = sibling;
+    } else {
+        nodes[grandParent].right = sibling;
+    }
+    for (int32_t node = grandParent; node != kNullNode; node = nodes[node].parent) {
+        nodes[node].box = nodes[nodes[node].left].box.merged(nodes[nodes[node].right].box);
+    }
+}
+
+template <typename Scalar>
+void BasicAabbTree<Scalar>::update(int32_t leaf, const Aabb& box) {
+    nodes[leaf].box = box;
+}
+
+template <typename Scalar>
+void BasicAabbTree<Scalar>::clear() {
+    nodes.clear();
+    freeNodes.clear();
+    root = kNullNode;
+    leafCount = 0;
+    rebuiltPerimeter = 0;
+    currentPerimeter = 0;
+}
+
+template <typename Scalar>
+void BasicAabbTree<Scalar>::refit() {
+    if (root == kNullNode) {
+        return;
+    }
+
+    // Pre-order (parents before children), then merge in reverse
+    scratch.clear();
+    scratch.push_back(root);
+    for (size_t i = 0; i < scratch.size(); i++) {
+        const Node& node = nodes[scratch[i]];
+        if (!node.isLeaf()) {
+            scratch.push_back(node.left);
+            scratch.push_back(node.right);
+        }
+    }
+    Scalar perimeter = 0;
+    for (size_t i = scratch.size(); i-- > 0;) {
+        Node& node = nodes[scratch[i]];
+        if (!node.isLeaf()) {
+            node.box = nodes[node.left].box.merged(nodes[node.right].box);
+            perimeter += node.box.perimeter();
+        }
+    }
+    currentPerimeter = perimeter;
+
+    if (currentPerimeter > rebuiltPerimeter * Scalar(kRebuildRatio)) {
+        rebuild();
+    }
+}
+
+template <typename Scalar>
+void BasicAabbTree<Scalar>::rebuild() {
+    if (root == kNullNode) {
+        return;
+    }
+
+    // Collect the leaves and free the internal nodes
+    scratch.clear();
+    scratch.push_back(root);
+    size_t leaves = 0;
+    for (size_t i = 0; i < scratch.size(); i++) {
+        int32_t index = scratch[i];
+        const Node& node = nodes[index];
+        if (node.isLeaf()) {
+            scratch[leaves++] = index;    // Never overtakes i, so no unread entry is overwritten
+        } else {
+            scratch.push_back(node.left);
+            scratch.push_back(node.right);
+            freeNode(index);
+        }
+    }
+    scratch.resize(leaves);
+
+    root = buildTopDown(scratch.data(), leaves, kNullNode);
+    rebuiltPerimeter = internalPerimeter();
+    currentPerimeter = rebuiltPerimeter;
+}
+
+template <typename Scalar>
+int32_t BasicAabbTree<Scalar>::buildTopDown(int32_t* leaves, size_t count, int32_t parent) {
+    if (count == 1) {
+        nodes[leaves[0]].parent = parent;
+        return leaves[0];
+    }
+
+    // Split at the median centroid along the longer axis of the centroids' extent
+    Aabb centroids = {nodes[leaves[0]].box.min + nodes[leaves[0]].box.max,
+                      nodes[leaves[0]].box.min + nodes[leaves[0]].box.max};
+    for (size_t i = 1; i < count; i++) {
+        Vec centroid = nodes[leaves[i]].box.min + nodes[leaves[i]].box.max;
+        centroids = centroids.merged(Aabb{centroid, centroid});
+    }
+    bool splitX = (centroids.max.x - centroids.min.x) >= (centroids.max.y - centroids.min.y);
+    size_t half = count / 2;
+    std::nth_element(leaves, leaves + half, leaves + count, [&](int32_t a, int32_t b) {
+        const Aabb& boxA = nodes[a].box;
+        const Aabb& boxB = nodes[b].box;
+        return splitX ? (boxA.min.x + boxA.max.x < boxB.min.x + boxB.max.x)
+                      : (boxA.min.y + boxA.max.y < boxB.min.y + boxB.max.y);
+    });
+
+    int32_t node = allocateNode();
+    int32_t left = buildTopDown(leaves, half, node);
+    int32_t right = buildTopDown(leaves + half, count - half, node);
+    nodes[node] = Node{nodes[left].box.merged(nodes[right].box), parent, left, right, 0};
+    return node;
+}
+
+template <typename Scalar>
+Scalar BasicAabbTree<Scalar>::internalPerimeter() const {
+    Scalar perimeter = 0;
+    int32_t stack[kStackSize];
+    int32_t top = 0;
+    if (root != kNullNode) {
+        stack[top++] = root;
+    }
+    while (top > 0) {
+        const Node& node = nodes[stack[--top]];
+        if (!node.isLeaf()) {
+            perimeter += node.box.perimeter();
+            stack[top++] = node.left;
+            stack[top++] = node.right;
+        }
+    }
+    return perimeter;
+}
+
+template <typename Scalar>
+int32_t BasicAabbTree<Scalar>::allocateNode() {
+    if (!freeNodes.empty()) {
+        int32_t node = freeNodes.back();
+        freeNodes.pop_back();
+        return node;
+    }
+    nodes.emplace_back();
+    return static_cast<int32_t>(nodes.size() - 1);
+}
+
+template <typename Scalar>
+void BasicAabbTree<Scalar>::freeNode(int32_t node) {
+    freeNodes.push_back(node);
+}
+
+template <typename Scalar>
+size_t BasicAabbTree<Scalar>::size() const {
+    return leafCount;
+}
+
+template <typename Scalar>
+Scalar BasicAabbTree<Scalar>::getDegradation() const {
+    return (rebuiltPerimeter > Scalar(0)) ? currentPerimeter / rebuiltPerimeter : Scalar(1);
+}
+
+template <typename Scalar>
+const BasicAabb<Scalar>& BasicAabbTree<Scalar>::getLeafBox(int32_t leaf) const {
+    return nodes[leaf].box;
+}
+
+template <typename Scalar>
+uint32_t BasicAabbTree<Scalar>::getLeafValue(int32_t leaf) const {
+    return nodes[leaf].value;
+}
+
+// Explicit instantiations for the supported scalar types
+template class BasicAabbTree<float>;
+template class BasicAabbTree<double>;
+template class BasicAabbTree<KinematicDual>;
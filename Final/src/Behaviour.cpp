@@ -0,0 +1,241 @@
+/**
+ * @file Behaviour.cpp
+ * @brief Implementation of the Behaviour and BehaviourScheduler classes
+ */
+#include "../include/Behaviour.h"
+#include <cmath>
+#include <iostream>
+
+namespace {
+// Room in front of each frame for its resource, keeping the frame aligned
+constexpr size_t kFrameHeader = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+}
+
+void* detail::allocateBehaviourFrame(std::pmr::memory_resource* resource, size_t size) {
+    std::byte* block = static_cast<std::byte*>(resource->allocate(size + kFrameHeader, kFrameHeader));
+    *reinterpret_cast<std::pmr::memory_resource**>(block) = resource;
+    return block + kFrameHeader;
+}
+
+void* Behaviour::promise_type::operator new(size_t size) {
+    return detail::allocateBehaviourFrame(std::pmr::get_default_resource(), size);
+}
+
+void Behaviour::promise_type::operator delete(void* frame, size_t size) {
+    std::byte* block = static_cast<std::byte*>(frame) - kFrameHeader;
+    std::pmr::memory_resource* resource = *reinterpret_cast<std::pmr::memory_resource**>(block);
+    resource->deallocate(block, size + kFrameHeader, kFrameHeader);
+}
+
+std::coroutine_handle<> Behaviour::FinalAwaiter::await_suspend(FrameHandle frame) noexcept {
+    promise_type& promise = frame.promise();
+    if (promise.continuation) {
+        return promise.continuation;
+    }
+    if (promise.scheduler) {
+        // The scheduler destroys the frame once resume() has returned
+        promise.scheduler->finish(promise.scheduler->current);
+    }
+    return std::noop_coroutine();
+}
+
+Behaviour::~Behaviour() {
+    if (frame) {
+        frame.destroy();
+    }
+}
+
+Behaviour::Behaviour(Behaviour&& other) noexcept : frame(other.release()) {
+}
+
+Behaviour& Behaviour::operator=(Behaviour&& other) noexcept {
+    if (this != &other) {
+        if (frame) {
+            frame.destroy();
+        }
+        frame = other.release();
+    }
+    return *this;
+}
+
+std::coroutine_handle<> Behaviour::await_suspend(std::coroutine_handle<> awaiting) noexcept {
+    // Start it straight away; it hands back to the awaiting one when it returns
+    frame.promise().continuation = awaiting;
+    return frame;
+}
+
+bool Behaviour::isDone() const {
+    return !frame || frame.done();
+}
+
+Behaviour::FrameHandle Behaviour::release() {
+    return std::exchange(frame, nullptr);
+}
+
+BehaviourScheduler::BehaviourScheduler(double timeStep, std::pmr::memory_resource* resource)
+    : framePool(resource), behaviours(resource), timers(resource), conditionWaiters(resource),
+      timeStep(timeStep), tickCount(0), resumeCount(0) {
+}
+
+BehaviourScheduler::~BehaviourScheduler() {
+    // Before the pool goes
+    behaviours.forEach([](BehaviourHandle, BehaviourState& state) {
+        state.frame.destroy();
+    });
+}
+
+BehaviourHandle BehaviourScheduler::spawn(Behaviour behaviour) {
+    Behaviour::FrameHandle frame = behaviour.release();
+    if (!frame) {
+        return BehaviourHandle{};
+    }
+    frame.promise().scheduler = this;
+    BehaviourHandle handle = behaviours.create(BehaviourState{frame, frame, nullptr, nullptr, TimerHandle{}, false});
+    resume(handle);
+    return handle;
+}
+
+bool BehaviourScheduler::cancel(BehaviourHandle handle) {
+    BehaviourState* state = behaviours.get(handle);
+    if (!state) {
+        return false;
+    }
+    if (handle == current) {
+        std::cerr << "A behaviour cannot cancel itself; it should return instead" << std::endl;
+        return false;
+    }
+
+    // Awaited behaviours live in the frame and go with it; a pending
+    // condition is dropped by the generation check
+    timers.cancel(state->timer);
+    state->frame.destroy();
+    behaviours.destroy(handle);
+    return true;
+}
+
+bool BehaviourScheduler::isRunning(BehaviourHandle handle) const {
+    return behaviours.contains(handle);
+}
+
+void BehaviourScheduler::tick() {
+    tickCount++;
+    timers.advanceTo(tickCount);
+    for (const ExpiredTimer& expired : timers.getExpired()) {
+        BehaviourHandle handle = unpack(expired.payload);
+        BehaviourState* state = behaviours.get(handle);
+        if (state && state->timer == expired.timer) {
+            state->timer = TimerHandle{};
+            resume(handle);
+        }
+    }
+
+    // Conditions awaited during this loop were checked when awaited, and
+    // wait for the next tick
+    size_t count = conditionWaiters.size();
+    size_t kept = 0;
+    for (size_t i = 0; i < count; i++) {
+        BehaviourHandle handle = conditionWaiters[i];
+        BehaviourState* state = behaviours.get(handle);
+        if (!state || !state->condition) {
+            continue;
+        }
+        if (state->condition(state->conditionState)) {
+            state->condition = nullptr;
+            state->conditionState = nullptr;
+            resume(handle);
+        } else {
+            conditionWaiters[kept++] = handle;
+        }
+    }
+    conditionWaiters.erase(conditionWaiters.begin() + kept, conditionWaiters.begin() + count);
+}
+
+BehaviourScheduler::TickAwaiter BehaviourScheduler::seconds(double duration) {
+    // A hair under a whole number of steps counts as that number
+    double steps = duration / timeStep;
+    return TickAwaiter(*this, steps > 0.0 ? static_cast<uint64_t>(std::ceil(steps - 1e-9)) : 0);
+}
+
+size_t BehaviourScheduler::size() const {
+    return behaviours.size();
+}
+
+uint64_t BehaviourScheduler::getTickCount() const {
+    return tickCount;
+}
+
+double BehaviourScheduler::getTimeStep() const {
+    return timeStep;
+}
+
+size_t BehaviourScheduler::getResumeCount() const {
+    return resumeCount;
+}
+
+std::pmr::memory_resource* BehaviourScheduler::getFrameResource() {
+    return &framePool;
+}
+
+bool BehaviourScheduler::waitTicks(std::coroutine_handle<> point, uint64_t ticks) {
+    BehaviourState* state = getCurrent(point);
+    if (!state) {
+        return false;
+    }
+    state->resumePoint = point;
+    state->timer = timers.schedule(ticks, pack(current));
+    return true;
+}
+
+bool BehaviourScheduler::waitUntil(std::coroutine_handle<> point, bool (*condition)(void*), void* conditionState) {
+    BehaviourState* state = getCurrent(point);
+    if (!state) {
+        return false;
+    }
+    state->resumePoint = point;
+    state->condition = condition;
+    state->conditionState = conditionState;
+    conditionWaiters.push_back(current);
+    return true;
+}
+
+BehaviourState* BehaviourScheduler::getCurrent(std::coroutine_handle<> point) {
+    BehaviourState* state = behaviours.get(current);
+    if (!state) {
+        std::cerr << "Behaviour at " << point.address() << " is not running on this scheduler; not waiting" << std::endl;
+    }
+    return state;
+}
+
+void BehaviourScheduler::resume(BehaviourHandle handle) {
+    BehaviourState* state = behaviours.get(handle);
+    if (!state || !state->resumePoint) {
+        return;
+    }
+
+    // A behaviour may spawn (and so resume) another
+    std::coroutine_handle<> point = std::exchange(state->resumePoint, nullptr);
+    BehaviourHandle previous = std::exchange(current, handle);
+    resumeCount++;
+    point.resume();
+    current = previous;
+
+    // Pool objects never move, so state is still this behaviour's
+    if (state->finished) {
+        state->frame.destroy();
+        behaviours.destroy(handle);
+    }
+}
+
+void BehaviourScheduler::finish(BehaviourHandle handle) {
+    if (BehaviourState* state = behaviours.get(handle)) {
+        state->finished = true;
+    }
+}
+
+uint64_t BehaviourScheduler::pack(BehaviourHandle handle) {
+    return (static_cast<uint64_t>(handle.index) << 32) | handle.generation;
+}
+
+BehaviourHandle BehaviourScheduler::unpack(uint64_t payload) {
+    return BehaviourHandle{static_cast<uint32_t>(payload >> 32), static_cast<uint32_t>(payload)};
+}
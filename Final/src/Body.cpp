@@ -3,12 +3,21 @@
  * @brief Implementation of the Body class
  */
 #include "../include/Body.h"
+#include "../include/Dual.h"
+#include "../include/PointKernels.h"
 #include <algorithm>
+#include <type_traits>
 #include <stdexcept>
 #include <iostream>
 
-Body::Body(const Vector2D& basePosition, double groundLevel)
-    : basePosition(basePosition), groundLevel(groundLevel) {
+template <typename Scalar>
+BasicBody<Scalar>::BasicBody(const Vec& basePosition, Scalar groundLevel, std::pmr::memory_resource* resource)
+    : basePosition(basePosition), terrain(groundLevel),
+      segments(resource), connections(resource),
+      segmentsByIndex(resource), namesByIndex(resource), rootIndices(resource),
+      endPointFlags(resource), childIndices(resource), parentIndices(resource), selfCollision(resource),
+      segmentTree(resource), segmentLeaves(resource), segmentTreeStale(true),
+      segmentTreeThreshold(kDefaultTreeThreshold) {
     
     // Create a default articulated body with a humanoid-like structure
     
@@ -55,145 +64,191 @@ Body::Body(const Vector2D& basePosition, double groundLevel)
     updateSegments();
 }
 
-void Body::addSegment(const std::string& name, double length, double angle, 
-                     double minAngle, double maxAngle) {
+template <typename Scalar>
+template <typename OtherScalar>
+BasicBody<Scalar>::BasicBody(const BasicBody<OtherScalar>& other)
+    : basePosition(other.basePosition),
+      terrain(other.terrain),
+      connections(other.connections), segmentTreeStale(true),
+      segmentTreeThreshold(other.segmentTreeThreshold) {
+    
+    // Copy every segment with its current pose (no default skeleton is created)
+    for (const auto& pair : other.segments) {
+        segments.try_emplace(pair.first, pair.second);
+    }
+    rebuildSegmentIndex();
+}
+
+template <typename Scalar>
+void BasicBody<Scalar>::addSegment(std::string_view name, Scalar length, Scalar angle, 
+                                  Scalar minAngle, Scalar maxAngle) {
     if (segments.find(name) != segments.end()) {
         std::cerr << "Segment '" << name << "' already exists!" << std::endl;
         return;
     }
     
-    // Create segment starting at base position
-    auto segment = std::make_unique<Segment>(name, basePosition, length, angle, minAngle, maxAngle);
-    
-    // Add to segments map
-    segments[name] = std::move(segment);
+    // Create segment starting at base position (in the map node, from the body's resource)
+    std::pmr::memory_resource* resource = getMemoryResource();
+    segments.try_emplace(std::pmr::string(name, resource),
+                         name, basePosition, length, angle, minAngle, maxAngle, resource);
+    rebuildSegmentIndex();
 }
 
-void Body::connectSegment(const std::string& parentName, const std::string& childName) {
+template <typename Scalar>
+void BasicBody<Scalar>::connectSegment(std::string_view parentName, std::string_view childName) {
     // Ensure both segments exist
-    if (segments.find(parentName) == segments.end() || 
-        segments.find(childName) == segments.end()) {
+    auto parent = segments.find(parentName);
+    auto child = segments.find(childName);
+    if (parent == segments.end() || child == segments.end()) {
         std::cerr << "Cannot connect: one or both segments don't exist!" << std::endl;
         return;
     }
     
     // Add child to parent's connections
-    connections[parentName].push_back(childName);
+    auto parentConnections = connections.find(parentName);
+    if (parentConnections == connections.end()) {
+        parentConnections = connections.try_emplace(parent->first).first;
+    }
+    parentConnections->second.emplace_back(childName);
+    rebuildSegmentIndex();
     
     // Update child segment to start from parent's end
-    const auto& parentEnd = segments[parentName]->getEnd();
-    segments[childName]->setStart(parentEnd);
+    child->second.setStart(parent->second.getEnd());
 }
 
-Segment* Body::getSegment(const std::string& name) {
+template <typename Scalar>
+BasicSegment<Scalar>* BasicBody<Scalar>::getSegment(std::string_view name) {
+    // The caller may move the segment
+    segmentTreeStale = true;
     auto it = segments.find(name);
-    return (it != segments.end()) ? it->second.get() : nullptr;
+    return (it != segments.end()) ? &it->second : nullptr;
 }
 
-const Segment* Body::getSegment(const std::string& name) const {
+template <typename Scalar>
+const BasicSegment<Scalar>* BasicBody<Scalar>::getSegment(std::string_view name) const {
     auto it = segments.find(name);
-    return (it != segments.end()) ? it->second.get() : nullptr;
+    return (it != segments.end()) ? &it->second : nullptr;
 }
 
-const Vector2D& Body::getBasePosition() const {
+template <typename Scalar>
+const BasicVector2D<Scalar>& BasicBody<Scalar>::getBasePosition() const {
     return basePosition;
 }
 
-double Body::getGroundLevel() const {
-    return groundLevel;
+template <typename Scalar>
+Scalar BasicBody<Scalar>::getGroundLevel() const {
+    return terrain.getHeightAt(basePosition.x);
+}
+
+template <typename Scalar>
+const BasicTerrain<Scalar>& BasicBody<Scalar>::getTerrain() const {
+    return terrain;
+}
+
+template <typename Scalar>
+void BasicBody<Scalar>::setTerrain(const BasicTerrain<Scalar>& terrain) {
+    this->terrain = terrain;
 }
 
-std::vector<std::string> Body::getSegmentNames() const {
+template <typename Scalar>
+std::vector<std::string> BasicBody<Scalar>::getSegmentNames() const {
     std::vector<std::string> names;
     for (const auto& pair : segments) {
-        names.push_back(pair.first);
+        names.emplace_back(pair.first);
     }
     return names;
 }
 
-size_t Body::getSegmentCount() const {
+template <typename Scalar>
+size_t BasicBody<Scalar>::getSegmentCount() const {
     return segments.size();
 }
 
-bool Body::rotateSegment(const std::string& name, double deltaAngle) {
+template <typename Scalar>
+std::pmr::memory_resource* BasicBody<Scalar>::getMemoryResource() const {
+    return segments.get_allocator().resource();
+}
+
+template <typename Scalar>
+bool BasicBody<Scalar>::rotateSegment(std::string_view name, Scalar deltaAngle) {
     auto segment = getSegment(name);
     if (!segment) {
         std::cerr << "Segment '" << name << "' not found!" << std::endl;
         return false;
     }
     
+    // A limited rotation still moves the segment (to its limit), so the
+    // children follow either way
     bool success = segment->rotate(deltaAngle);
-    if (success) {
-        // Update all child segments to maintain connections
-        updateChildSegments(name);
+    updateChildSegments(name);
+    return success;
+}
+
+template <typename Scalar>
+bool BasicBody<Scalar>::rotateSegment(std::string_view name, const BasicRotation2D<Scalar>& delta) {
+    auto segment = getSegment(name);
+    if (!segment) {
+        std::cerr << "Segment '" << name << "' not found!" << std::endl;
+        return false;
     }
+    
+    // A limited rotation still moves the segment (to its limit), so the
+    // children follow either way
+    bool success = segment->rotate(delta);
+    updateChildSegments(name);
     return success;
 }
 
-bool Body::rotateSegmentTo(const std::string& name, double targetAngle) {
+template <typename Scalar>
+bool BasicBody<Scalar>::rotateSegmentTo(std::string_view name, Scalar targetAngle) {
     auto segment = getSegment(name);
     if (!segment) {
         std::cerr << "Segment '" << name << "' not found!" << std::endl;
         return false;
     }
     
+    // A limited rotation still moves the segment (to its limit), so the
+    // children follow either way
     bool success = segment->rotateTo(targetAngle);
-    if (success) {
-        // Update all child segments to maintain connections
-        updateChildSegments(name);
-    }
+    updateChildSegments(name);
     return success;
 }
 
-void Body::moveBaseTo(const Vector2D& newBase) {
+template <typename Scalar>
+void BasicBody<Scalar>::moveBaseTo(const Vec& newBase) {
     // Calculate the displacement vector
-    Vector2D displacement = newBase - basePosition;
+    Vec displacement = newBase - basePosition;
     
     // Update base position
     basePosition = newBase;
     
-    // Move all segments that are directly connected to the base
-    for (auto& pair : segments) {
-        const std::string& name = pair.first;
-        Segment* segment = pair.second.get();
-        
-        // Check if this is a "root" segment (no parent)
-        bool isRoot = true;
-        for (const auto& conn : connections) {
-            for (const auto& child : conn.second) {
-                if (child == name) {
-                    isRoot = false;
-                    break;
-                }
-            }
-            if (!isRoot) break;
-        }
+    // Move all segments that are directly connected to the base ("root" segments, no parent)
+    for (size_t root : rootIndices) {
+        SegmentType* segment = segmentsByIndex[root];
         
-        if (isRoot) {
-            // Move the segment's start point
-            segment->setStart(segment->getStart() + displacement);
-            // Update its children recursively
-            updateChildSegments(name);
-        }
+        // Move the segment's start point
+        segment->setStart(segment->getStart() + displacement);
+        // Update its children recursively
+        updateChildSegments(root);
     }
 }
 
-bool Body::hasMinimumGroundContacts(int minContacts) const {
+template <typename Scalar>
+bool BasicBody<Scalar>::hasMinimumGroundContacts(int minContacts) const {
     return countGroundContacts() >= minContacts;
 }
 
-int Body::countGroundContacts() const {
+template <typename Scalar>
+int BasicBody<Scalar>::countGroundContacts() const {
     int count = 0;
     
     // Check all segments' endpoints
-    for (const auto& pair : segments) {
-        const Segment* segment = pair.second.get();
-        
-        if (segment->isStartContactingGround(groundLevel)) {
+    for (const SegmentType* segment : segmentsByIndex) {
+        if (segment->isStartContactingGround(terrain)) {
             count++;
         }
         
-        if (segment->isEndContactingGround(groundLevel)) {
+        if (segment->isEndContactingGround(terrain)) {
             count++;
         }
     }
@@ -201,52 +256,305 @@ int Body::countGroundContacts() const {
     return count;
 }
 
-std::vector<std::string> Body::getSegmentsContactingGround() const {
+template <typename Scalar>
+std::vector<std::string> BasicBody<Scalar>::getSegmentsContactingGround() const {
     std::vector<std::string> contactingSegments;
     
-    for (const auto& pair : segments) {
-        const std::string& name = pair.first;
-        const Segment* segment = pair.second.get();
-        
-        if (segment->isStartContactingGround(groundLevel) || 
-            segment->isEndContactingGround(groundLevel)) {
-            contactingSegments.push_back(name);
+    for (size_t i = 0; i < segmentsByIndex.size(); i++) {
+        if (isContactingGround(i)) {
+            contactingSegments.emplace_back(*namesByIndex[i]);
         }
     }
     
     return contactingSegments;
 }
 
-bool Body::canReachObject(const Circle& object, int minTouchingPoints) const {
-    return getSegmentsTouchingObject(object).size() >= static_cast<size_t>(minTouchingPoints);
+template <typename Scalar>
+typename BasicBody<Scalar>::SegmentMask BasicBody<Scalar>::getGroundContactMask() const {
+    SegmentMask mask = 0;
+    size_t count = std::min(segmentsByIndex.size(), kMaxMaskSegments);
+    for (size_t i = 0; i < count; i++) {
+        mask |= static_cast<SegmentMask>(isContactingGround(i)) << i;
+    }
+    return mask;
+}
+
+template <typename Scalar>
+bool BasicBody<Scalar>::isContactingGround(size_t index) const {
+    const SegmentType* segment = segmentsByIndex[index];
+    return segment->isStartContactingGround(terrain) || segment->isEndContactingGround(terrain);
+}
+
+template <typename Scalar>
+bool BasicBody<Scalar>::canReachObject(const BasicCircle<Scalar>& object, int minTouchingPoints) const {
+    // Count without building the name list
+    int touching = 0;
+    if (usesSegmentTree()) {
+        // Only segments whose box overlaps the object's box can touch it
+        getSegmentTree().query(BasicAabb<Scalar>::fromCircle(object.getCenter(), object.getRadius()),
+                               [&](uint32_t index) {
+            touching += isTouchingObject(index, object) ? 1 : 0;
+        });
+        return touching >= minTouchingPoints;
+    }
+    
+    for (size_t i = 0; i < segmentsByIndex.size(); i++) {
+        touching += isTouchingObject(i, object) ? 1 : 0;
+    }
+    return touching >= minTouchingPoints;
 }
 
-std::vector<std::string> Body::getSegmentsTouchingObject(const Circle& object) const {
+template <typename Scalar>
+std::vector<std::string> BasicBody<Scalar>::getSegmentsTouchingObject(const BasicCircle<Scalar>& object) const {
     std::vector<std::string> touchingSegments;
     
-    for (const auto& pair : segments) {
-        const std::string& name = pair.first;
-        const Segment* segment = pair.second.get();
-        
-        // Check if the segment is an endpoint (not parent to any other segments)
-        if (isEndPoint(name)) {
-            // Check if either endpoint is within the circle
-            Vector2D end = segment->getEnd();
-            if (object.contains(end) || segment->distanceToPoint(object.getCenter()) <= object.getRadius()) {
-                touchingSegments.push_back(name);
-            }
+    for (size_t i = 0; i < segmentsByIndex.size(); i++) {
+        if (isTouchingObject(i, object)) {
+            touchingSegments.emplace_back(*namesByIndex[i]);
         }
     }
     
     return touchingSegments;
 }
 
-void Body::updateSegments() {
-    // Start by finding the "root" segments (not children of any other segment)
-    std::vector<std::string> rootSegments;
+template <typename Scalar>
+typename BasicBody<Scalar>::SegmentMask BasicBody<Scalar>::getTouchingObjectMask(const BasicCircle<Scalar>& object) const {
+    SegmentMask mask = 0;
+    size_t count = std::min(segmentsByIndex.size(), kMaxMaskSegments);
+    for (size_t i = 0; i < count; i++) {
+        mask |= static_cast<SegmentMask>(isTouchingObject(i, object)) << i;
+    }
+    return mask;
+}
+
+template <typename Scalar>
+bool BasicBody<Scalar>::isTouchingObject(size_t index, const BasicCircle<Scalar>& object) const {
+    // Only endpoints (not parent to any other segments) can touch
+    if (!endPointFlags[index]) {
+        return false;
+    }
+    
+    // Check if either endpoint is within the circle
+    const SegmentType* segment = segmentsByIndex[index];
+    Vec end = segment->getEnd();
+    return object.contains(end) || segment->distanceToPoint(object.getCenter()) <= object.getRadius();
+}
+
+template <typename Scalar>
+size_t BasicBody<Scalar>::findClosestSegment(const Vec& point) const {
+    size_t closest = kNoSegment;
+    if (usesSegmentTree()) {
+        uint32_t index;
+        Scalar distance;
+        if (getSegmentTree().findClosest(point, [&](uint32_t i) { return segmentsByIndex[i]->distanceToPoint(point); },
+                                         index, distance)) {
+            closest = index;
+        }
+        return closest;
+    }
+    
+    Scalar closestDistance = 0;
+    for (size_t i = 0; i < segmentsByIndex.size(); i++) {
+        Scalar distance = segmentsByIndex[i]->distanceToPoint(point);
+        if (closest == kNoSegment || distance < closestDistance) {
+            closest = i;
+            closestDistance = distance;
+        }
+    }
+    return closest;
+}
+
+template <typename Scalar>
+size_t BasicBody<Scalar>::rayCastSegments(const Vec& from, const Vec& to, Scalar* hitFraction) const {
+    Vec delta = to - from;
+    size_t hitIndex = kNoSegment;
+    Scalar fraction = 1;
+    if (usesSegmentTree()) {
+        fraction = getSegmentTree().rayCast(from, to, [&](uint32_t i, Scalar maxFraction) {
+            Scalar t = rayCastSegment(i, from, delta, maxFraction);
+            if (t < maxFraction) {
+                hitIndex = i;
+            }
+            return t;
+        });
+    } else {
+        for (size_t i = 0; i < segmentsByIndex.size(); i++) {
+            Scalar t = rayCastSegment(i, from, delta, fraction);
+            if (t < fraction) {
+                hitIndex = i;
+                fraction = t;
+            }
+        }
+    }
+    
+    if (hitFraction && hitIndex != kNoSegment) {
+        *hitFraction = fraction;
+    }
+    return hitIndex;
+}
+
+template <typename Scalar>
+Scalar BasicBody<Scalar>::rayCastSegment(size_t index, const Vec& from, const Vec& delta, Scalar maxFraction) const {
+    // Solve from + s * delta = start + t * direction for s in [0, maxFraction), t in [0, 1]
+    const SegmentType* segment = segmentsByIndex[index];
+    Vec start = segment->getStart();
+    Vec direction = segment->getEnd() - start;
+    Scalar denominator = delta.cross(direction);
+    if (denominator == Scalar(0)) {
+        return maxFraction;     // Parallel (touching along the ray counts as a miss)
+    }
+    Vec offset = start - from;
+    Scalar s = offset.cross(direction) / denominator;
+    Scalar t = offset.cross(delta) / denominator;
+    bool hit = s >= Scalar(0) && s < maxFraction && t >= Scalar(0) && t <= Scalar(1);
+    return hit ? s : maxFraction;
+}
+
+template <typename Scalar>
+size_t BasicBody<Scalar>::getSegmentTreeThreshold() const {
+    return segmentTreeThreshold;
+}
+
+template <typename Scalar>
+void BasicBody<Scalar>::setSegmentTreeThreshold(size_t threshold) {
+    segmentTreeThreshold = threshold;
+}
+
+template <typename Scalar>
+bool BasicBody<Scalar>::usesSegmentTree() const {
+    return segmentsByIndex.size() >= segmentTreeThreshold;
+}
+
+template <typename Scalar>
+const BasicAabbTree<Scalar>& BasicBody<Scalar>::getSegmentTree() const {
+    if (segmentLeaves.size() != segmentsByIndex.size()) {
+        // Skeleton changed: insert every segment, then balance
+        segmentTree.clear();
+        segmentLeaves.clear();
+        for (size_t i = 0; i < segmentsByIndex.size(); i++) {
+            const SegmentType* segment = segmentsByIndex[i];
+            segmentLeaves.push_back(segmentTree.insert(static_cast<uint32_t>(i),
+                BasicAabb<Scalar>::fromSegment(segment->getStart(), segment->getEnd())));
+        }
+        segmentTree.rebuild();
+    } else if (segmentTreeStale) {
+        // Pose changed: new leaf boxes, one refit pass
+        for (size_t i = 0; i < segmentsByIndex.size(); i++) {
+            const SegmentType* segment = segmentsByIndex[i];
+            segmentTree.update(segmentLeaves[i], BasicAabb<Scalar>::fromSegment(segment->getStart(), segment->getEnd()));
+        }
+        segmentTree.refit();
+    }
+    segmentTreeStale = false;
+    return segmentTree;
+}
+
+template <typename Scalar>
+void BasicBody<Scalar>::updateSegments() {
+    // Update all segments starting from the root segments (not children of any other segment)
+    for (size_t root : rootIndices) {
+        segmentsByIndex[root]->setStart(basePosition);
+        updateChildSegments(root);
+    }
+}
+
+template <typename Scalar>
+std::vector<std::pair<BasicVector2D<Scalar>, BasicVector2D<Scalar>>> BasicBody<Scalar>::getSegmentLines() const {
+    std::vector<std::pair<Vec, Vec>> lines;
     
     for (const auto& pair : segments) {
-        const std::string& name = pair.first;
+        const SegmentType& segment = pair.second;
+        lines.emplace_back(segment.getStart(), segment.getEnd());
+    }
+    
+    return lines;
+}
+
+template <typename Scalar>
+size_t BasicBody<Scalar>::getSegmentLines(std::span<std::pair<Vec, Vec>> out) const {
+    size_t count = std::min(out.size(), segmentsByIndex.size());
+    for (size_t i = 0; i < count; i++) {
+        out[i] = {segmentsByIndex[i]->getStart(), segmentsByIndex[i]->getEnd()};
+    }
+    return count;
+}
+
+template <typename Scalar>
+void BasicBody<Scalar>::updateChildSegments(std::string_view parentName) {
+    size_t parentIndex = getSegmentIndex(parentName);
+    if (parentIndex == kNoSegment) {
+        return; // Parent segment not found
+    }
+    updateChildSegments(parentIndex);
+}
+
+template <typename Scalar>
+void BasicBody<Scalar>::updateChildSegments(size_t parentIndex) {
+    const SegmentType* parentSegment = segmentsByIndex[parentIndex];
+    segmentTreeStale = true;
+    
+    // Update all children of this segment
+    for (size_t child : childIndices[parentIndex]) {
+        // Connect the child's start to the parent's end
+        segmentsByIndex[child]->setStart(parentSegment->getEnd());
+        
+        // Recursively update this child's children
+        updateChildSegments(child);
+    }
+}
+
+template <typename Scalar>
+bool BasicBody<Scalar>::isEndPoint(std::string_view segmentName) const {
+    // A segment is an endpoint if it's not a parent to any other segment
+    return connections.find(segmentName) == connections.end();
+}
+
+template <typename Scalar>
+bool BasicBody<Scalar>::isEndPoint(size_t index) const {
+    return endPointFlags[index] != 0;
+}
+
+template <typename Scalar>
+size_t BasicBody<Scalar>::getSegmentIndex(std::string_view name) const {
+    // Names are in map (sorted) order
+    auto it = std::lower_bound(namesByIndex.begin(), namesByIndex.end(), name,
+                               [](const std::pmr::string* a, std::string_view b) { return std::string_view(*a) < b; });
+    if (it == namesByIndex.end() || **it != name) {
+        return kNoSegment;
+    }
+    return static_cast<size_t>(it - namesByIndex.begin());
+}
+
+template <typename Scalar>
+std::string_view BasicBody<Scalar>::getSegmentName(size_t index) const {
+    return *namesByIndex[index];
+}
+
+template <typename Scalar>
+const BasicSegment<Scalar>& BasicBody<Scalar>::getSegmentAt(size_t index) const {
+    return *segmentsByIndex[index];
+}
+
+template <typename Scalar>
+void BasicBody<Scalar>::rebuildSegmentIndex() {
+    // The segment tree is rebuilt on its next use
+    segmentLeaves.clear();
+    segmentTreeStale = true;
+    
+    segmentsByIndex.clear();
+    namesByIndex.clear();
+    rootIndices.clear();
+    endPointFlags.clear();
+    
+    // Keep the capacity of the per-parent child lists (no churn in an arena)
+    childIndices.resize(segments.size());
+    for (auto& children : childIndices) {
+        children.clear();
+    }
+    parentIndices.assign(segments.size(), kNoSegment);
+    
+    for (auto& pair : segments) {
+        const std::pmr::string& name = pair.first;
         
         // Check if this segment is a child of any other segment
         bool isChild = false;
@@ -258,53 +566,185 @@ void Body::updateSegments() {
         }
         
         if (!isChild) {
-            rootSegments.push_back(name);
+            rootIndices.push_back(segmentsByIndex.size());
         }
+        endPointFlags.push_back(isEndPoint(name) ? 1 : 0);
+        segmentsByIndex.push_back(&pair.second);
+        namesByIndex.push_back(&name);
     }
     
-    // Update all segments starting from the root segments
-    for (const auto& rootName : rootSegments) {
-        segments[rootName]->setStart(basePosition);
-        updateChildSegments(rootName);
+    // Children by index (names of missing segments are skipped)
+    for (const auto& conn : connections) {
+        size_t parent = getSegmentIndex(conn.first);
+        if (parent == kNoSegment) continue;
+        for (const auto& childName : conn.second) {
+            size_t child = getSegmentIndex(childName);
+            if (child != kNoSegment) {
+                childIndices[parent].push_back(child);
+                parentIndices[child] = parent;
+            }
+        }
     }
 }
 
-std::vector<std::pair<Vector2D, Vector2D>> Body::getSegmentLines() const {
-    std::vector<std::pair<Vector2D, Vector2D>> lines;
+template <typename Scalar>
+std::vector<std::string> BasicBody<Scalar>::getSegmentChain(std::string_view segmentName) const {
+    std::vector<std::string> chain;
+    if (segments.find(segmentName) == segments.end()) {
+        return chain;
+    }
     
-    for (const auto& pair : segments) {
-        const Segment* segment = pair.second.get();
-        lines.emplace_back(segment->getStart(), segment->getEnd());
+    // Walk up through the parents, then reverse to get root-first order
+    std::string current(segmentName);
+    chain.push_back(current);
+    bool foundParent = true;
+    while (foundParent && chain.size() <= segments.size()) {
+        foundParent = false;
+        for (const auto& conn : connections) {
+            if (std::find(conn.second.begin(), conn.second.end(), std::string_view(current)) != conn.second.end()) {
+                current = conn.first;
+                chain.push_back(current);
+                foundParent = true;
+                break;
+            }
+        }
     }
     
-    return lines;
+    std::reverse(chain.begin(), chain.end());
+    return chain;
 }
 
-void Body::updateChildSegments(const std::string& parentName) {
-    const auto& parentConnections = connections.find(parentName);
-    if (parentConnections == connections.end()) {
-        return; // No children
+template <typename Scalar>
+size_t BasicBody<Scalar>::getParentIndex(size_t index) const {
+    return parentIndices[index];
+}
+
+template <typename Scalar>
+bool BasicBody<Scalar>::hasSelfCollision(Scalar clearance) const {
+    return sweepSelfCollisions({}, clearance, true) > 0;
+}
+
+template <typename Scalar>
+size_t BasicBody<Scalar>::findSelfCollisions(std::span<SegmentPair> out, Scalar clearance) const {
+    return sweepSelfCollisions(out, clearance, false);
+}
+
+template <typename Scalar>
+bool BasicBody<Scalar>::sharesJoint(size_t a, size_t b) const {
+    return parentIndices[a] == b || parentIndices[b] == a || parentIndices[a] == parentIndices[b];
+}
+
+template <typename Scalar>
+size_t BasicBody<Scalar>::sweepSelfCollisions(std::span<SegmentPair> out, Scalar clearance, bool stopAtFirst) const {
+    SelfCollisionState& state = selfCollision;
+    size_t count = segmentsByIndex.size();
+    
+    // Endpoints and boxes widened by the clearance
+    Vec margin(clearance, clearance);
+    state.endpoints.resize(2 * count);
+    state.boxes.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        Vec start = segmentsByIndex[i]->getStart();
+        Vec end = segmentsByIndex[i]->getEnd();
+        state.endpoints[2 * i] = start;
+        state.endpoints[2 * i + 1] = end;
+        BasicAabb<Scalar> box = BasicAabb<Scalar>::fromSegment(start, end);
+        state.boxes[i] = {box.min - margin, box.max + margin};
     }
     
-    const Segment* parentSegment = getSegment(parentName);
-    if (!parentSegment) {
-        return; // Parent segment not found
+    // Restore the order along x (nearly sorted since the last call)
+    if (state.order.size() != count) {
+        state.order.resize(count);
+        for (size_t i = 0; i < count; i++) {
+            state.order[i] = static_cast<uint32_t>(i);
+        }
+    }
+    for (size_t i = 1; i < count; i++) {
+        uint32_t segment = state.order[i];
+        Scalar left = state.boxes[segment].min.x;
+        size_t j = i;
+        while (j > 0 && state.boxes[state.order[j - 1]].min.x > left) {
+            state.order[j] = state.order[j - 1];
+            j--;
+        }
+        state.order[j] = segment;
     }
     
-    // Update all children of this segment
-    for (const auto& childName : parentConnections->second) {
-        Segment* childSegment = getSegment(childName);
-        if (childSegment) {
-            // Connect the child's start to the parent's end
-            childSegment->setStart(parentSegment->getEnd());
-            
-            // Recursively update this child's children
-            updateChildSegments(childName);
+    // Sweep: pairs overlapping on x, then on y, not joined at a joint. A
+    // yes/no query measures each pair as the sweep finds it and returns on
+    // the first hit; otherwise the pairs go to the batched narrow phase
+    Scalar limit = clearance * clearance;
+    state.pairs.clear();
+    for (size_t i = 0; i < count; i++) {
+        const BasicAabb<Scalar>& box = state.boxes[state.order[i]];
+        for (size_t j = i + 1; j < count && state.boxes[state.order[j]].min.x <= box.max.x; j++) {
+            size_t a = state.order[i];
+            size_t b = state.order[j];
+            const BasicAabb<Scalar>& other = state.boxes[b];
+            if (box.min.y > other.max.y || other.min.y > box.max.y || sharesJoint(a, b)) {
+                continue;
+            }
+            SegmentPair pair(std::min(a, b), std::max(a, b));
+            if (!stopAtFirst) {
+                state.pairs.push_back(pair);
+            } else if (segmentsByIndex[a]->distanceSquaredToSegment(*segmentsByIndex[b]) <= limit) {
+                if (!out.empty()) {
+                    out[0] = pair;
+                }
+                return 1;
+            }
+        }
+    }
+    if (stopAtFirst) {
+        return 0;
+    }
+    
+    // Narrow phase: exact squared distances, vectorized for float and double
+    size_t candidates = state.pairs.size();
+    state.distances.resize(candidates);
+    if constexpr (std::is_same_v<Scalar, float> || std::is_same_v<Scalar, double>) {
+        state.pairEndpoints.resize(8 * candidates);
+        Scalar* blocks = state.pairEndpoints.data();
+        for (size_t k = 0; k < candidates; k++) {
+            const Vec* a = &state.endpoints[2 * state.pairs[k].first];
+            const Vec* b = &state.endpoints[2 * state.pairs[k].second];
+            blocks[k] = a[0].x;
+            blocks[candidates + k] = a[0].y;
+            blocks[2 * candidates + k] = a[1].x;
+            blocks[3 * candidates + k] = a[1].y;
+            blocks[4 * candidates + k] = b[0].x;
+            blocks[5 * candidates + k] = b[0].y;
+            blocks[6 * candidates + k] = b[1].x;
+            blocks[7 * candidates + k] = b[1].y;
+        }
+        auto block = [&](size_t index) { return std::span<const Scalar>(blocks + index * candidates, candidates); };
+        segmentPairDistancesSquared<Scalar>(SegmentArrays<Scalar>{block(0), block(1), block(2), block(3)},
+                                            SegmentArrays<Scalar>{block(4), block(5), block(6), block(7)},
+                                            state.distances);
+    } else {
+        for (size_t k = 0; k < candidates; k++) {
+            state.distances[k] = segmentsByIndex[state.pairs[k].first]->distanceSquaredToSegment(
+                *segmentsByIndex[state.pairs[k].second]);
+        }
+    }
+    
+    size_t colliding = 0;
+    for (size_t k = 0; k < candidates; k++) {
+        if (state.distances[k] <= limit) {
+            if (colliding < out.size()) {
+                out[colliding] = state.pairs[k];
+            }
+            colliding++;
         }
     }
+    return colliding;
 }
 
-bool Body::isEndPoint(const std::string& segmentName) const {
-    // A segment is an endpoint if it's not a parent to any other segment
-    return connections.find(segmentName) == connections.end();
-}
+// Explicit instantiations for the supported scalar types
+template class BasicBody<float>;
+template class BasicBody<double>;
+template class BasicBody<KinematicDual>;
+template BasicBody<float>::BasicBody(const BasicBody<double>& other);
+template BasicBody<double>::BasicBody(const BasicBody<float>& other);
+template BasicBody<KinematicDual>::BasicBody(const BasicBody<float>& other);
+template BasicBody<KinematicDual>::BasicBody(const BasicBody<double>& other);
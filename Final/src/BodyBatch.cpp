@@ -0,0 +1,222 @@
+/**
+ * @file BodyBatch.cpp
+ * @brief Implementation of the BodyBatch class
+ */
+#include "../include/BodyBatch.h"
+#include "../include/PointKernels.h"
+#include "../include/JobSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace {
+// Below these a pass runs on the calling thread alone
+constexpr size_t kTrigGrain = 16384;     // Angles per job, a multiple of every vector width
+constexpr size_t kLaneGrain = 2048;
+}
+
+BodyBatch::BodyBatch(const std::vector<std::shared_ptr<Body>>& bodies)
+    : laneCount(bodies.size()) {
+    if (bodies.empty() || !bodies.front()) {
+        return;
+    }
+    
+    // Order joints by chain depth so parents always come before their children
+    const Body& skeleton = *bodies.front();
+    std::vector<std::vector<std::string>> chains;
+    for (const auto& name : skeleton.getSegmentNames()) {
+        chains.push_back(skeleton.getSegmentChain(name));
+    }
+    std::stable_sort(chains.begin(), chains.end(),
+                     [](const std::vector<std::string>& a, const std::vector<std::string>& b) {
+                         return a.size() < b.size();
+                     });
+    
+    for (const auto& chain : chains) {
+        jointNames.push_back(chain.back());
+        parentIndices.push_back(chain.size() > 1 ? getJointIndex(chain[chain.size() - 2]) : -1);
+    }
+    
+    size_t rowSize = jointNames.size() * laneCount;
+    baseX.assign(laneCount, 0.0);
+    baseY.assign(laneCount, 0.0);
+    lengths.assign(rowSize, 0.0);
+    angles.assign(rowSize, 0.0);
+    limitCenters.assign(rowSize, 0.0);
+    limitHalfWidths.assign(rowSize, M_PI);
+    startX.assign(rowSize, 0.0);
+    startY.assign(rowSize, 0.0);
+    endX.assign(rowSize, 0.0);
+    endY.assign(rowSize, 0.0);
+    sines.assign(rowSize, 0.0);
+    cosines.assign(rowSize, 0.0);
+    
+    loadPoses(bodies);
+}
+
+void BodyBatch::loadPoses(const std::vector<std::shared_ptr<Body>>& bodies) {
+    size_t lanes = std::min(laneCount, bodies.size());
+    for (size_t lane = 0; lane < lanes; lane++) {
+        const Body* body = bodies[lane].get();
+        if (!body) continue;
+        
+        baseX[lane] = body->getBasePosition().x;
+        baseY[lane] = body->getBasePosition().y;
+        
+        for (size_t joint = 0; joint < jointNames.size(); joint++) {
+            const Segment* segment = body->getSegment(jointNames[joint]);
+            if (!segment) {
+                std::cerr << "Body in lane " << lane << " has no segment '" << jointNames[joint] << "'" << std::endl;
+                continue;
+            }
+            size_t index = joint * laneCount + lane;
+            lengths[index] = segment->getLength();
+            angles[index] = segment->getAngle();
+            limitCenters[index] = segment->getLimits().center;
+            limitHalfWidths[index] = segment->getLimits().halfWidth;
+        }
+    }
+    
+    forwardKinematics();
+}
+
+void BodyBatch::storePoses(const std::vector<std::shared_ptr<Body>>& bodies) const {
+    size_t lanes = std::min(laneCount, bodies.size());
+    for (size_t lane = 0; lane < lanes; lane++) {
+        Body* body = bodies[lane].get();
+        if (!body) continue;
+        
+        for (size_t joint = 0; joint < jointNames.size(); joint++) {
+            Segment* segment = body->getSegment(jointNames[joint]);
+            if (segment) {
+                segment->setRawAngle(angles[joint * laneCount + lane]);
+            }
+        }
+        body->updateSegments();
+    }
+}
+
+void BodyBatch::forwardKinematics() {
+    // Split at multiples of kTrigGrain from the start of the array, so every
+    // angle lands in the same vector group (or tail) as in one call
+    JobSystem& jobs = JobSystem::shared();
+    jobs.parallelFor(0, angles.size(), kTrigGrain, [this](size_t first, size_t last) {
+        size_t count = last - first;
+        sinCosAngles<Real>(std::span<const Real>(angles).subspan(first, count),
+                           std::span<Real>(sines).subspan(first, count), std::span<Real>(cosines).subspan(first, count));
+    });
+
+    // Lanes are independent, so each block of them runs down every chain
+    jobs.parallelFor(0, laneCount, kLaneGrain, [this](size_t firstLane, size_t lastLane) {
+        for (size_t joint = 0; joint < jointNames.size(); joint++) {
+            int parent = parentIndices[joint];
+            const Real* parentX = parent < 0 ? baseX.data() : &endX[parent * laneCount];
+            const Real* parentY = parent < 0 ? baseY.data() : &endY[parent * laneCount];
+            
+            size_t row = joint * laneCount;
+            const Real* length = &lengths[row];
+            const Real* sine = &sines[row];
+            const Real* cosine = &cosines[row];
+            Real* sx = &startX[row];
+            Real* sy = &startY[row];
+            Real* ex = &endX[row];
+            Real* ey = &endY[row];
+            
+            // Same instruction stream for every lane
+            for (size_t lane = firstLane; lane < lastLane; lane++) {
+                sx[lane] = parentX[lane];
+                sy[lane] = parentY[lane];
+                ex[lane] = parentX[lane] + length[lane] * cosine[lane];
+                ey[lane] = parentY[lane] + length[lane] * sine[lane];
+            }
+        }
+    });
+}
+
+void BodyBatch::applyJointLimits() {
+    clampAngles<Real>(angles, limitCenters, limitHalfWidths);
+}
+
+size_t BodyBatch::getLaneCount() const {
+    return laneCount;
+}
+
+size_t BodyBatch::getJointCount() const {
+    return jointNames.size();
+}
+
+int BodyBatch::getJointIndex(const std::string& name) const {
+    auto it = std::find(jointNames.begin(), jointNames.end(), name);
+    return it != jointNames.end() ? static_cast<int>(it - jointNames.begin()) : -1;
+}
+
+const std::string& BodyBatch::getJointName(size_t joint) const {
+    return jointNames[joint];
+}
+
+int BodyBatch::getParentIndex(size_t joint) const {
+    return parentIndices[joint];
+}
+
+bool BodyBatch::isAncestorOrSelf(size_t ancestor, size_t joint) const {
+    int current = static_cast<int>(joint);
+    while (current >= 0) {
+        if (current == static_cast<int>(ancestor)) {
+            return true;
+        }
+        current = parentIndices[current];
+    }
+    return false;
+}
+
+Real BodyBatch::getAngle(size_t joint, size_t lane) const {
+    return angles[joint * laneCount + lane];
+}
+
+void BodyBatch::setAngle(size_t joint, size_t lane, Real angle) {
+    size_t index = joint * laneCount + lane;
+    Segment::Limits limits{limitCenters[index], limitHalfWidths[index]};
+    angles[index] = limits.clamp(angle);
+}
+
+Vector2D BodyBatch::getStart(size_t joint, size_t lane) const {
+    size_t index = joint * laneCount + lane;
+    return Vector2D(startX[index], startY[index]);
+}
+
+Vector2D BodyBatch::getEnd(size_t joint, size_t lane) const {
+    size_t index = joint * laneCount + lane;
+    return Vector2D(endX[index], endY[index]);
+}
+
+Real* BodyBatch::getAngles(size_t joint) {
+    return &angles[joint * laneCount];
+}
+
+const Real* BodyBatch::getAngles(size_t joint) const {
+    return &angles[joint * laneCount];
+}
+
+const Real* BodyBatch::getLimitCenters(size_t joint) const {
+    return &limitCenters[joint * laneCount];
+}
+
+const Real* BodyBatch::getLimitHalfWidths(size_t joint) const {
+    return &limitHalfWidths[joint * laneCount];
+}
+
+const Real* BodyBatch::getStartX(size_t joint) const {
+    return &startX[joint * laneCount];
+}
+
+const Real* BodyBatch::getStartY(size_t joint) const {
+    return &startY[joint * laneCount];
+}
+
+const Real* BodyBatch::getEndX(size_t joint) const {
+    return &endX[joint * laneCount];
+}
+
+const Real* BodyBatch::getEndY(size_t joint) const {
+    return &endY[joint * laneCount];
+}
@@ -0,0 +1,88 @@
+/**
+ * @file BodyBehaviours.cpp
+ * @brief Implementation of the walker and thrower behaviours
+ */
+#include "../include/BodyBehaviours.h"
+#include "../include/WalkerStrategy.h"
+#include <algorithm>
+#include <cmath>
+
+Behaviour walkTo(BehaviourScheduler& scheduler, World& world, BodyHandle body, CircleHandle target, double walkSpeed,
+                 double reachDistance) {
+    while (true) {
+        // Handles are resolved afresh every tick: either may be gone
+        Body* walker = world.getBody(body);
+        const Circle* object = world.getCircle(target);
+        if (!walker || !object) {
+            co_return;
+        }
+        Vector2D base = walker->getBasePosition();
+        double toTarget = object->getCenter().x - base.x;
+        double distance = std::abs(toTarget);
+        if (distance <= reachDistance) {
+            co_return;
+        }
+
+        // Along the ground, keeping the base as high above it as it is now
+        double stride = std::min(walkSpeed, distance - reachDistance);
+        Vector2D next(base.x + std::copysign(stride, toTarget), base.y);
+        const Terrain& terrain = walker->getTerrain();
+        next.y = terrain.getHeightAt(next.x) - (terrain.getHeightAt(base.x) - base.y);
+        walker->moveBaseTo(next);
+        co_await scheduler.nextTick();
+        if (stride < walkSpeed) {
+            co_return;      // That was the short last step (rounding may leave it a hair out)
+        }
+    }
+}
+
+Behaviour reachFor(BehaviourScheduler& scheduler, World& world, BodyHandle body, CircleHandle target) {
+    for (size_t arm = 0; arm < WalkerStrategy::kArmCount; arm++) {
+        Body* walker = world.getBody(body);
+        const Circle* object = world.getCircle(target);
+        if (!walker || !object) {
+            co_return;
+        }
+        WalkerStrategy::reachWithArm(*walker, arm, object->getCenter());
+        co_await scheduler.nextTick();
+    }
+}
+
+Behaviour walkAndCatch(BehaviourScheduler& scheduler, World& world, BodyHandle body, CircleHandle target,
+                       double walkSpeed, bool* caught) {
+    const Body* standing = world.getBody(body);
+    if (!standing) {
+        co_return;
+    }
+    co_await walkTo(scheduler, world, body, target, walkSpeed, WalkerStrategy::getReachDistance(*standing));
+    co_await reachFor(scheduler, world, body, target);
+
+    const Body* walker = world.getBody(body);
+    const Circle* object = world.getCircle(target);
+    bool grabbed = walker && object && walker->canReachObject(*object, WalkerStrategy::kArmCount);
+    if (caught) {
+        *caught = grabbed;
+    }
+}
+
+Behaviour throwVolleys(BehaviourScheduler& scheduler, World& world, BodyHandle thrower, CircleHandle target,
+                       int volleys, double restSeconds, size_t* hits) {
+    for (int volley = 0; volley < volleys; volley++) {
+        ProjectileHandle snowball = world.throwSnowball(thrower, target);
+        if (!snowball) {
+            co_return;
+        }
+
+        // A snowball already removed from the world counts as a miss
+        ProjectileStatus landed = ProjectileStatus::FLYING;
+        co_await scheduler.until([&world, &landed, snowball]() {
+            std::optional<ProjectileState> state = world.getProjectile(snowball);
+            landed = state ? state->status : ProjectileStatus::HIT_GROUND;
+            return landed != ProjectileStatus::FLYING;
+        });
+        if (landed == ProjectileStatus::HIT_TARGET && hits) {
+            ++*hits;
+        }
+        co_await scheduler.seconds(restSeconds);
+    }
+}
@@ -6,7 +6,7 @@
 #include <iostream>
 
 BodyBuilder::BodyBuilder() 
-    : basePosition(100.0, 400.0), groundLevel(400.0) {
+    : basePosition(100.0, 400.0 - Body::kStandingHeight), groundLevel(400.0) {
 }
 
 BodyBuilder& BodyBuilder::setBasePosition(const Vector2D& position) {
@@ -96,26 +96,35 @@ BodyBuilder& BodyBuilder::buildSimpleBody() {
     return *this;
 }
 
-std::shared_ptr<Body> BodyBuilder::build() {
-    auto body = std::make_shared<Body>(basePosition, groundLevel);
-    
+std::shared_ptr<Body> BodyBuilder::build(std::pmr::memory_resource* resource) {
+    auto body = std::allocate_shared<Body>(std::pmr::polymorphic_allocator<Body>(resource),
+                                           basePosition, groundLevel, resource);
+    configure(*body);
+    return body;
+}
+
+BodyHandle BodyBuilder::build(World& world) {
+    BodyHandle handle = world.createBody(basePosition, groundLevel);
+    configure(*world.getBody(handle));
+    return handle;
+}
+
+void BodyBuilder::configure(Body& body) const {
     // Add all segments
     for (const auto& pair : segmentSpecs) {
         const std::string& name = pair.first;
         const SegmentSpec& spec = pair.second;
         
-        body->addSegment(name, spec.length, spec.angle, spec.minAngle, spec.maxAngle);
+        body.addSegment(name, spec.length, spec.angle, spec.minAngle, spec.maxAngle);
     }
     
     // Add all connections
     for (const auto& conn : connections) {
-        body->connectSegment(conn.parent, conn.child);
+        body.connectSegment(conn.parent, conn.child);
     }
     
     // Update all segments to ensure proper positioning
-    body->updateSegments();
-    
-    return body;
+    body.updateSegments();
 }
 
 void BodyBuilder::reset() {
@@ -3,9 +3,12 @@
  * @brief Implementation of the Circle class
  */
 #include "../include/Circle.h"
+#include "../include/Dual.h"
 #include <cmath>
+#include <algorithm>
 
-Circle::Circle(const Vector2D& center, double radius) 
+template <typename Scalar>
+BasicCircle<Scalar>::BasicCircle(const Vec& center, Scalar radius) 
     : center(center), 
       radius(radius),
       velocity(0, 0),
@@ -13,7 +16,8 @@ Circle::Circle(const Vector2D& center, double radius)
       hasPhysics(false) {
 }
 
-Circle::Circle(double x, double y, double radius)
+template <typename Scalar>
+BasicCircle<Scalar>::BasicCircle(Scalar x, Scalar y, Scalar radius)
     : center(x, y), 
       radius(radius),
       velocity(0, 0),
@@ -21,40 +25,49 @@ Circle::Circle(double x, double y, double radius)
       hasPhysics(false) {
 }
 
-Vector2D Circle::getCenter() const {
+template <typename Scalar>
+BasicVector2D<Scalar> BasicCircle<Scalar>::getCenter() const {
     return center;
 }
 
-double Circle::getRadius() const {
+template <typename Scalar>
+Scalar BasicCircle<Scalar>::getRadius() const {
     return radius;
 }
 
-double Circle::getArea() const {
+template <typename Scalar>
+Scalar BasicCircle<Scalar>::getArea() const {
     return M_PI * radius * radius;
 }
 
-double Circle::getCircumference() const {
+template <typename Scalar>
+Scalar BasicCircle<Scalar>::getCircumference() const {
     return 2 * M_PI * radius;
 }
 
-void Circle::setCenter(const Vector2D& newCenter) {
+template <typename Scalar>
+void BasicCircle<Scalar>::setCenter(const Vec& newCenter) {
     center = newCenter;
 }
 
-void Circle::setCenter(double x, double y) {
+template <typename Scalar>
+void BasicCircle<Scalar>::setCenter(Scalar x, Scalar y) {
     center.x = x;
     center.y = y;
 }
 
-void Circle::setRadius(double newRadius) {
-    radius = std::max(0.0, newRadius);  // Ensure radius is non-negative
+template <typename Scalar>
+void BasicCircle<Scalar>::setRadius(Scalar newRadius) {
+    radius = std::max(Scalar(0.0), newRadius);  // Ensure radius is non-negative
 }
 
-void Circle::move(const Vector2D& displacement) {
+template <typename Scalar>
+void BasicCircle<Scalar>::move(const Vec& displacement) {
     center += displacement;
 }
 
-void Circle::updatePosition(double timeStep) {
+template <typename Scalar>
+void BasicCircle<Scalar>::updatePosition(Scalar timeStep) {
     if (!hasPhysics) {
         return;  // No physics to simulate
     }
@@ -66,35 +79,47 @@ void Circle::updatePosition(double timeStep) {
     velocity.y += gravity * timeStep;
 }
 
-void Circle::setBallistics(const Vector2D& initialVelocity, double gravityValue) {
+template <typename Scalar>
+void BasicCircle<Scalar>::setBallistics(const Vec& initialVelocity, Scalar gravityValue) {
     velocity = initialVelocity;
     gravity = gravityValue;
     hasPhysics = true;
 }
 
-Vector2D Circle::getVelocity() const {
+template <typename Scalar>
+BasicVector2D<Scalar> BasicCircle<Scalar>::getVelocity() const {
     return velocity;
 }
 
-bool Circle::contains(const Vector2D& point) const {
+template <typename Scalar>
+bool BasicCircle<Scalar>::contains(const Vec& point) const {
     return center.distanceSquared(point) <= radius * radius;
 }
 
-bool Circle::intersects(const Circle& other) const {
-    double distanceSquared = center.distanceSquared(other.center);
-    double sumRadii = radius + other.radius;
+template <typename Scalar>
+bool BasicCircle<Scalar>::intersects(const BasicCircle& other) const {
+    Scalar distanceSquared = center.distanceSquared(other.center);
+    Scalar sumRadii = radius + other.radius;
     return distanceSquared <= sumRadii * sumRadii;
 }
 
-bool Circle::isOnGround(double groundLevel) const {
+template <typename Scalar>
+bool BasicCircle<Scalar>::isOnGround(Scalar groundLevel) const {
     return center.y + radius >= groundLevel;
 }
 
-double Circle::distanceTo(const Circle& other) const {
-    double centerDistance = center.distance(other.center);
-    return std::max(0.0, centerDistance - radius - other.radius);
+template <typename Scalar>
+Scalar BasicCircle<Scalar>::distanceTo(const BasicCircle& other) const {
+    Scalar centerDistance = center.distance(other.center);
+    return std::max(Scalar(0.0), centerDistance - radius - other.radius);
 }
 
-double Circle::distanceToCenter(const Circle& other) const {
+template <typename Scalar>
+Scalar BasicCircle<Scalar>::distanceToCenter(const BasicCircle& other) const {
     return center.distance(other.center);
-}
\ No newline at end of file
+}
+
+// Explicit instantiations for the supported scalar types
+template class BasicCircle<float>;
+template class BasicCircle<double>;
+template class BasicCircle<KinematicDual>;
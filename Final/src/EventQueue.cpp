@@ -0,0 +1,135 @@
+/**
+ * @file EventQueue.cpp
+ * @brief Implementation of the EventQueue class
+ */
+#include "../include/EventQueue.h"
+
+EventQueue::EventQueue(std::pmr::memory_resource* resource)
+    : heap(resource), positionOf(resource) {
+}
+
+void EventQueue::schedule(uint32_t id, uint32_t generation, uint64_t tick) {
+    if (id >= positionOf.size()) {
+        positionOf.resize(id + 1, kNotQueued);
+    }
+    Event event{tick, id, generation};
+    uint32_t position = positionOf[id];
+    if (position == kNotQueued) {
+        heap.push_back(event);
+        positionOf[id] = static_cast<uint32_t>(heap.size() - 1);
+        siftUp(heap.size() - 1);
+        return;
+    }
+
+    // Whichever way the new tick moves it
+    bool earlier = isBefore(event, heap[position]);
+    heap[position] = event;
+    if (earlier) {
+        siftUp(position);
+    } else {
+        siftDown(position);
+    }
+}
+
+void EventQueue::cancel(uint32_t id) {
+    if (isScheduled(id)) {
+        removeAt(positionOf[id]);
+    }
+}
+
+void EventQueue::clear() {
+    for (const Event& event : heap) {
+        positionOf[event.id] = kNotQueued;
+    }
+    heap.clear();
+}
+
+const EventQueue::Event& EventQueue::top() const {
+    return heap.front();
+}
+
+EventQueue::Event EventQueue::pop() {
+    Event event = heap.front();
+    removeAt(0);
+    return event;
+}
+
+bool EventQueue::empty() const {
+    return heap.empty();
+}
+
+size_t EventQueue::size() const {
+    return heap.size();
+}
+
+bool EventQueue::isScheduled(uint32_t id) const {
+    return id < positionOf.size() && positionOf[id] != kNotQueued;
+}
+
+uint64_t EventQueue::getTick(uint32_t id) const {
+    return isScheduled(id) ? heap[positionOf[id]].tick : UINT64_MAX;
+}
+
+uint64_t EventQueue::getNextTick() const {
+    return heap.empty() ? UINT64_MAX : heap.front().tick;
+}
+
+bool EventQueue::isBefore(const Event& a, const Event& b) {
+    return a.tick != b.tick ? a.tick < b.tick : a.id < b.id;
+}
+
+void EventQueue::siftUp(size_t position) {
+    // Move the hole up rather than swapping at every level
+    Event event = heap[position];
+    while (position > 0) {
+        size_t parent = (position - 1) / 2;
+        if (!isBefore(event, heap[parent])) {
+            break;
+        }
+        place(position, heap[parent]);
+        position = parent;
+    }
+    place(position, event);
+}
+
+void EventQueue::siftDown(size_t position) {
+    Event event = heap[position];
+    size_t count = heap.size();
+    while (true) {
+        size_t child = 2 * position + 1;
+        if (child >= count) {
+            break;
+        }
+        if (child + 1 < count && isBefore(heap[child + 1], heap[child])) {
+            child++;
+        }
+        if (!isBefore(heap[child], event)) {
+            break;
+        }
+        place(position, heap[child]);
+        position = child;
+    }
+    place(position, event);
+}
+
+void EventQueue::place(size_t position, const Event& event) {
+    heap[position] = event;
+    positionOf[event.id] = static_cast<uint32_t>(position);
+}
+
+void EventQueue::removeAt(size_t position) {
+    positionOf[heap[position].id] = kNotQueued;
+    Event last = heap.back();
+    heap.pop_back();
+    if (position == heap.size()) {
+        return;
+    }
+    // The last event fills the hole and moves whichever way it must
+    bool earlier = isBefore(last, heap[position]);
+    place(position, last);
+    if (earlier) {
+        siftUp(position);
+    } else {
+        siftDown(position);
+    }
+}
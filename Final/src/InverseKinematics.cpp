@@ -0,0 +1,278 @@
+/**
+ * @file InverseKinematics.cpp
+ * @brief Implementation of the IKSolver class
+ */
+#include "../include/InverseKinematics.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+IKSolver::IKSolver(double damping, int maxIterations, double tolerance)
+    : damping(damping), maxIterations(maxIterations), tolerance(tolerance), maxStepAngle(0.5) {
+}
+
+void IKSolver::setActiveJoints(const std::vector<std::string>& jointNames) {
+    activeJoints = jointNames;
+}
+
+void IKSolver::setMaxStepAngle(double maxStep) {
+    maxStepAngle = std::max(0.0, maxStep);
+}
+
+IKResult IKSolver::solve(const std::shared_ptr<Body>& body, const std::vector<IKTarget>& targets) const {
+    std::vector<std::shared_ptr<Body>> bodies = {body};
+    BodyBatch batch(bodies);
+    
+    std::vector<std::string> effectorNames;
+    std::vector<Vector2D> targetPositions;
+    for (const auto& target : targets) {
+        effectorNames.push_back(target.segmentName);
+        targetPositions.push_back(target.position);
+    }
+    
+    std::vector<IKResult> results = solveBatch(batch, effectorNames, targetPositions);
+    batch.storePoses(bodies);
+    return results.empty() ? IKResult{false, 0, 0.0} : results.front();
+}
+
+std::vector<IKResult> IKSolver::solveBatch(BodyBatch& batch,
+                                           const std::vector<std::string>& effectorNames,
+                                           const std::vector<Vector2D>& targetPositions) const {
+    const size_t lanes = batch.getLaneCount();
+    const size_t targetCount = effectorNames.size();
+    std::vector<IKResult> results(lanes, IKResult{false, 0, 0.0});
+    
+    if (targetCount == 0 || targetPositions.size() < lanes * targetCount) {
+        std::cerr << "IK: expected " << lanes * targetCount << " target positions" << std::endl;
+        return results;
+    }
+    
+    // Resolve effectors
+    std::vector<size_t> effectors;
+    for (const auto& name : effectorNames) {
+        int index = batch.getJointIndex(name);
+        if (index < 0) {
+            std::cerr << "IK: segment '" << name << "' not found!" << std::endl;
+            return results;
+        }
+        effectors.push_back(static_cast<size_t>(index));
+    }
+    
+    // Resolve the joints the solver may move
+    std::vector<size_t> joints;
+    for (size_t joint = 0; joint < batch.getJointCount(); joint++) {
+        bool allowed = activeJoints.empty() ||
+            std::find(activeJoints.begin(), activeJoints.end(), batch.getJointName(joint)) != activeJoints.end();
+        bool influences = false;
+        for (size_t effector : effectors) {
+            influences = influences || batch.isAncestorOrSelf(joint, effector);
+        }
+        if (allowed && influences) {
+            joints.push_back(joint);
+        }
+    }
+    
+    // influence[t * n + k] = 1 if joint k moves effector t
+    const size_t jointCount = joints.size();
+    std::vector<Real> influence(targetCount * jointCount, Real(0));
+    for (size_t t = 0; t < targetCount; t++) {
+        for (size_t k = 0; k < jointCount; k++) {
+            influence[t * jointCount + k] = batch.isAncestorOrSelf(joints[k], effectors[t]) ? Real(1) : Real(0);
+        }
+    }
+    
+    // Lane-major targets transposed into per-effector rows
+    std::vector<Real> goalX(targetCount * lanes), goalY(targetCount * lanes);
+    for (size_t lane = 0; lane < lanes; lane++) {
+        for (size_t t = 0; t < targetCount; t++) {
+            goalX[t * lanes + lane] = targetPositions[lane * targetCount + t].x;
+            goalY[t * lanes + lane] = targetPositions[lane * targetCount + t].y;
+        }
+    }
+    
+    // Work buffers, all rows of 'lanes' values
+    const size_t rows = 2 * targetCount;
+    std::vector<Real> columnX(jointCount * lanes), columnY(jointCount * lanes);
+    std::vector<Real> jointFree(jointCount * lanes);
+    std::vector<Real> error(rows * lanes);
+    std::vector<Real> system(rows * rows * lanes);
+    std::vector<Real> laneActive(lanes, Real(1));
+    std::vector<Real> maxError(lanes, Real(0));
+    const Real lambdaSquared = static_cast<Real>(damping * damping);
+    const Real maxStep = static_cast<Real>(maxStepAngle);
+    
+    int iteration = 0;
+    for (; iteration <= maxIterations; iteration++) {
+        batch.forwardKinematics();
+        
+        // Residuals e = goal - effector end
+        std::fill(maxError.begin(), maxError.end(), Real(0));
+        for (size_t t = 0; t < targetCount; t++) {
+            const Real* endX = batch.getEndX(effectors[t]);
+            const Real* endY = batch.getEndY(effectors[t]);
+            Real* errorX = &error[(2 * t) * lanes];
+            Real* errorY = &error[(2 * t + 1) * lanes];
+            for (size_t lane = 0; lane < lanes; lane++) {
+                errorX[lane] = goalX[t * lanes + lane] - endX[lane];
+                errorY[lane] = goalY[t * lanes + lane] - endY[lane];
+                Real distance = std::sqrt(errorX[lane] * errorX[lane] + errorY[lane] * errorY[lane]);
+                maxError[lane] = std::max(maxError[lane], distance);
+            }
+        }
+        
+        bool anyActive = false;
+        for (size_t lane = 0; lane < lanes; lane++) {
+            if (laneActive[lane] != 0 && maxError[lane] <= tolerance) {
+                laneActive[lane] = 0;
+                results[lane].converged = true;
+                results[lane].iterations = iteration;
+            }
+            anyActive = anyActive || laneActive[lane] != 0;
+        }
+        if (!anyActive || iteration == maxIterations) {
+            break;
+        }
+        
+        // Jacobian columns: d(end)/dθ_k = (-(end_k - start_k).y, (end_k - start_k).x)
+        for (size_t k = 0; k < jointCount; k++) {
+            const Real* sx = batch.getStartX(joints[k]);
+            const Real* sy = batch.getStartY(joints[k]);
+            const Real* ex = batch.getEndX(joints[k]);
+            const Real* ey = batch.getEndY(joints[k]);
+            Real* cx = &columnX[k * lanes];
+            Real* cy = &columnY[k * lanes];
+            for (size_t lane = 0; lane < lanes; lane++) {
+                cx[lane] = -(ey[lane] - sy[lane]);
+                cy[lane] = ex[lane] - sx[lane];
+            }
+        }
+        
+        // A joint at a limit that the error pulls further out is left out of
+        // this iteration (its column is zero); otherwise the clamp would undo
+        // its share of every step and the other joints would never make it up
+        for (size_t k = 0; k < jointCount; k++) {
+            const Real* angles = batch.getAngles(joints[k]);
+            const Real* centers = batch.getLimitCenters(joints[k]);
+            const Real* halfWidths = batch.getLimitHalfWidths(joints[k]);
+            const Real* cx = &columnX[k * lanes];
+            const Real* cy = &columnY[k * lanes];
+            Real* free = &jointFree[k * lanes];
+            for (size_t lane = 0; lane < lanes; lane++) {
+                Real pull = 0;     // (Jᵀ e)_k: the direction that reduces the error
+                for (size_t t = 0; t < targetCount; t++) {
+                    pull += influence[t * jointCount + k] * (cx[lane] * error[(2 * t) * lanes + lane] +
+                                                             cy[lane] * error[(2 * t + 1) * lanes + lane]);
+                }
+                Real offset = angles[lane] - centers[lane];
+                offset -= Real(2 * M_PI) * std::nearbyint(offset * Real(1 / (2 * M_PI)));
+                bool atLimit = halfWidths[lane] < Real(M_PI) &&
+                               std::abs(offset) >= halfWidths[lane] - Real(1e-4);
+                free[lane] = (atLimit && offset * pull > 0) ? Real(0) : Real(1);
+            }
+        }
+        
+        // A = J Jᵀ + λ² I (rows 2t and 2t+1 belong to effector t)
+        std::fill(system.begin(), system.end(), Real(0));
+        for (size_t p = 0; p < rows; p++) {
+            for (size_t q = 0; q <= p; q++) {
+                Real* entry = &system[(p * rows + q) * lanes];
+                for (size_t k = 0; k < jointCount; k++) {
+                    Real mask = influence[(p / 2) * jointCount + k] * influence[(q / 2) * jointCount + k];
+                    if (mask == 0) continue;
+                    const Real* a = (p % 2 == 0) ? &columnX[k * lanes] : &columnY[k * lanes];
+                    const Real* b = (q % 2 == 0) ? &columnX[k * lanes] : &columnY[k * lanes];
+                    const Real* free = &jointFree[k * lanes];
+                    for (size_t lane = 0; lane < lanes; lane++) {
+                        entry[lane] += a[lane] * b[lane] * free[lane];
+                    }
+                }
+                if (p == q) {
+                    for (size_t lane = 0; lane < lanes; lane++) {
+                        entry[lane] += lambdaSquared;
+                    }
+                }
+            }
+        }
+        
+        // Cholesky factorization A = L Lᵀ in place (lower triangle), per lane
+        for (size_t p = 0; p < rows; p++) {
+            for (size_t q = 0; q <= p; q++) {
+                Real* entry = &system[(p * rows + q) * lanes];
+                for (size_t r = 0; r < q; r++) {
+                    const Real* lp = &system[(p * rows + r) * lanes];
+                    const Real* lq = &system[(q * rows + r) * lanes];
+                    for (size_t lane = 0; lane < lanes; lane++) {
+                        entry[lane] -= lp[lane] * lq[lane];
+                    }
+                }
+                if (p == q) {
+                    for (size_t lane = 0; lane < lanes; lane++) {
+                        entry[lane] = std::sqrt(entry[lane]);
+                    }
+                } else {
+                    const Real* diagonal = &system[(q * rows + q) * lanes];
+                    for (size_t lane = 0; lane < lanes; lane++) {
+                        entry[lane] /= diagonal[lane];
+                    }
+                }
+            }
+        }
+        
+        // Forward then backward substitution: error becomes y = A⁻¹ e
+        for (size_t p = 0; p < rows; p++) {
+            Real* value = &error[p * lanes];
+            for (size_t r = 0; r < p; r++) {
+                const Real* l = &system[(p * rows + r) * lanes];
+                const Real* solved = &error[r * lanes];
+                for (size_t lane = 0; lane < lanes; lane++) {
+                    value[lane] -= l[lane] * solved[lane];
+                }
+            }
+            const Real* diagonal = &system[(p * rows + p) * lanes];
+            for (size_t lane = 0; lane < lanes; lane++) {
+                value[lane] /= diagonal[lane];
+            }
+        }
+        for (size_t p = rows; p-- > 0;) {
+            Real* value = &error[p * lanes];
+            for (size_t r = p + 1; r < rows; r++) {
+                const Real* l = &system[(r * rows + p) * lanes];
+                const Real* solved = &error[r * lanes];
+                for (size_t lane = 0; lane < lanes; lane++) {
+                    value[lane] -= l[lane] * solved[lane];
+                }
+            }
+            const Real* diagonal = &system[(p * rows + p) * lanes];
+            for (size_t lane = 0; lane < lanes; lane++) {
+                value[lane] /= diagonal[lane];
+            }
+        }
+        
+        // dθ_k = Σ_p J[p][k] y[p], limited per step, then clamped to the joint limits
+        for (size_t k = 0; k < jointCount; k++) {
+            Real* angles = batch.getAngles(joints[k]);
+            const Real* cx = &columnX[k * lanes];
+            const Real* cy = &columnY[k * lanes];
+            for (size_t lane = 0; lane < lanes; lane++) {
+                Real delta = 0;
+                for (size_t t = 0; t < targetCount; t++) {
+                    Real mask = influence[t * jointCount + k];
+                    delta += mask * (cx[lane] * error[(2 * t) * lanes + lane] +
+                                     cy[lane] * error[(2 * t + 1) * lanes + lane]);
+                }
+                delta = std::max(-maxStep, std::min(maxStep, delta)) * laneActive[lane] * jointFree[k * lanes + lane];
+                angles[lane] += delta;
+            }
+        }
+        batch.applyJointLimits();
+    }
+    
+    for (size_t lane = 0; lane < lanes; lane++) {
+        if (!results[lane].converged) {
+            results[lane].iterations = iteration;
+        }
+        results[lane].maxError = maxError[lane];
+    }
+    
+    return results;
+}
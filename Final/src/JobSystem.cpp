@@ -0,0 +1,173 @@
+/**
+ * @file JobSystem.cpp
+ * @brief Implementation of the JobSystem class
+ */
+#include "../include/JobSystem.h"
+
+namespace {
+// Which system and deque the current thread works for
+thread_local const JobSystem* currentSystem = nullptr;
+thread_local size_t currentQueue = 0;
+}
+
+size_t JobSystem::getDefaultWorkerCount() {
+    unsigned hardware = std::thread::hardware_concurrency();
+    return hardware > 1 ? hardware - 1 : 0;
+}
+
+JobSystem& JobSystem::shared() {
+    static JobSystem system;
+    return system;
+}
+
+JobSystem::JobSystem(size_t workerCount)
+    : queuedCount(0), executedCount(0), stolenCount(0), running(true) {
+    for (size_t i = 0; i <= workerCount; i++) {
+        queues.push_back(std::make_unique<Queue>());
+    }
+    for (size_t i = 1; i <= workerCount; i++) {
+        workers.emplace_back(&JobSystem::workerLoop, this, i);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepLock);
+        running = false;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+JobHandle JobSystem::submit(std::function<void()> work) {
+    JobHandle job = std::make_shared<Job>();
+    job->work = std::move(work);
+    push(job);
+    return job;
+}
+
+JobHandle JobSystem::submitAfter(std::span<const JobHandle> dependencies, std::function<void()> work) {
+    JobHandle job = std::make_shared<Job>();
+    job->work = std::move(work);
+
+    // One extra count held while registering, so the job cannot be pushed
+    // before every dependency has been looked at
+    job->unfinishedDependencies = dependencies.size() + 1;
+    for (const JobHandle& dependency : dependencies) {
+        std::lock_guard<std::mutex> lock(dependency->continuationLock);
+        if (dependency->finished) {
+            job->unfinishedDependencies--;
+        } else {
+            dependency->continuations.push_back(job);
+        }
+    }
+    if (--job->unfinishedDependencies == 0) {
+        push(job);
+    }
+    return job;
+}
+
+void JobSystem::wait(const JobHandle& job) {
+    while (!job->finished) {
+        if (JobHandle other = findJob()) {
+            execute(other);
+        } else {
+            // The job is running on another thread
+            std::this_thread::yield();
+        }
+    }
+}
+
+size_t JobSystem::getWorkerCount() const {
+    return workers.size();
+}
+
+size_t JobSystem::getExecutedCount() const {
+    return executedCount;
+}
+
+size_t JobSystem::getStolenCount() const {
+    return stolenCount;
+}
+
+void JobSystem::push(JobHandle job) {
+    Queue& queue = *queues[getQueueIndex()];
+    {
+        std::lock_guard<std::mutex> lock(queue.lock);
+        queue.jobs.push_back(std::move(job));
+    }
+    queuedCount++;
+    if (!workers.empty()) {
+        // Taking the lock orders this with a worker about to sleep
+        std::lock_guard<std::mutex> lock(sleepLock);
+        wake.notify_one();
+    }
+}
+
+JobHandle JobSystem::findJob() {
+    if (queuedCount == 0) {
+        return nullptr;
+    }
+    // Own deque from the back, then the others' from the front
+    size_t own = getQueueIndex();
+    for (size_t offset = 0; offset < queues.size(); offset++) {
+        size_t index = (own + offset) % queues.size();
+        Queue& queue = *queues[index];
+        std::lock_guard<std::mutex> lock(queue.lock);
+        if (queue.jobs.empty()) {
+            continue;
+        }
+        JobHandle job;
+        if (offset == 0) {
+            job = std::move(queue.jobs.back());
+            queue.jobs.pop_back();
+        } else {
+            job = std::move(queue.jobs.front());
+            queue.jobs.pop_front();
+            stolenCount++;
+        }
+        queuedCount--;
+        return job;
+    }
+    return nullptr;
+}
+
+void JobSystem::execute(const JobHandle& job) {
+    job->work();
+    job->work = nullptr;    // Drop what it captured
+    executedCount++;
+
+    std::vector<JobHandle> ready;
+    {
+        std::lock_guard<std::mutex> lock(job->continuationLock);
+        job->finished = true;
+        ready.swap(job->continuations);
+    }
+    for (JobHandle& continuation : ready) {
+        if (--continuation->unfinishedDependencies == 0) {
+            push(std::move(continuation));
+        }
+    }
+}
+
+void JobSystem::workerLoop(size_t index) {
+    currentSystem = this;
+    currentQueue = index;
+    while (true) {
+        if (JobHandle job = findJob()) {
+            execute(job);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepLock);
+        wake.wait(lock, [this]() { return !running || queuedCount > 0; });
+        if (!running && queuedCount == 0) {
+            return;
+        }
+    }
+}
+
+size_t JobSystem::getQueueIndex() const {
+    return currentSystem == this ? currentQueue : 0;
+}
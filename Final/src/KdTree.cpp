@@ -0,0 +1,241 @@
+/**
+ * @file KdTree.cpp
+ * @brief Implementation of the KdTree class
+ */
+#include "../include/KdTree.h"
+#include <algorithm>
+#include <limits>
+
+namespace {
+// Ranges this small are scanned rather than split further
+constexpr size_t kLeafSize = 6;
+
+Real coordinate(const Vector2D& position, uint8_t axis) {
+    return axis == 0 ? position.x : position.y;
+}
+}
+
+KdTree::KdTree(std::pmr::memory_resource* resource)
+    : nodes(resource), slotOf(resource) {
+}
+
+void KdTree::build(std::span<const Vector2D> points) {
+    nodes.clear();
+    nodes.reserve(points.size());
+    for (size_t i = 0; i < points.size(); i++) {
+        nodes.push_back(Node{points[i], static_cast<uint32_t>(i), 0, false, 0});
+    }
+    buildRange(0, nodes.size());
+
+    slotOf.resize(nodes.size());
+    for (size_t slot = 0; slot < nodes.size(); slot++) {
+        slotOf[nodes[slot].point] = static_cast<uint32_t>(slot);
+    }
+}
+
+uint32_t KdTree::findNearest(const Vector2D& point) const {
+    Best best{std::numeric_limits<Real>::max(), kNone};
+    searchNearest(0, nodes.size(), point, best);
+    return best.point;
+}
+
+size_t KdTree::findNearest(const Vector2D& point, std::span<uint32_t> out, uint32_t exclude) const {
+    // Kept sorted, nearest first; small enough to insert into directly
+    Best bestStorage[64];
+    std::span<Best> best(bestStorage, std::min<size_t>(out.size(), 64));
+    size_t found = 0;
+    searchNearest(0, nodes.size(), point, best, found, exclude);
+    for (size_t i = 0; i < found; i++) {
+        out[i] = best[i].point;
+    }
+    return found;
+}
+
+void KdTree::remove(uint32_t point) {
+    Node& node = nodes[slotOf[point]];
+    if (!node.removed) {
+        node.removed = true;
+        adjustCounts(point, -1);
+    }
+}
+
+void KdTree::restore(uint32_t point) {
+    Node& node = nodes[slotOf[point]];
+    if (node.removed) {
+        node.removed = false;
+        adjustCounts(point, 1);
+    }
+}
+
+void KdTree::restoreAll() {
+    for (Node& node : nodes) {
+        node.removed = false;
+    }
+    // Subtree sizes again, as build() left them
+    struct Range {
+        size_t begin, end;
+    };
+    std::vector<Range> stack{{0, nodes.size()}};
+    while (!stack.empty()) {
+        Range range = stack.back();
+        stack.pop_back();
+        if (range.begin >= range.end) {
+            continue;
+        }
+        size_t mid = range.begin + (range.end - range.begin) / 2;
+        nodes[mid].remaining = static_cast<uint32_t>(range.end - range.begin);
+        if (range.end - range.begin <= kLeafSize) {
+            continue;
+        }
+        stack.push_back({range.begin, mid});
+        stack.push_back({mid + 1, range.end});
+    }
+}
+
+size_t KdTree::size() const {
+    return nodes.size();
+}
+
+size_t KdTree::getRemaining() const {
+    return nodes.empty() ? 0 : nodes[nodes.size() / 2].remaining;
+}
+
+bool KdTree::isRemoved(uint32_t point) const {
+    return nodes[slotOf[point]].removed;
+}
+
+void KdTree::buildRange(size_t begin, size_t end) {
+    if (begin >= end) {
+        return;
+    }
+    size_t mid = begin + (end - begin) / 2;
+    if (end - begin <= kLeafSize) {
+        nodes[mid].remaining = static_cast<uint32_t>(end - begin);
+        return;
+    }
+
+    // Split on the wider side of the range's bounding box
+    Vector2D min = nodes[begin].position;
+    Vector2D max = min;
+    for (size_t i = begin + 1; i < end; i++) {
+        const Vector2D& p = nodes[i].position;
+        min = Vector2D(std::min(min.x, p.x), std::min(min.y, p.y));
+        max = Vector2D(std::max(max.x, p.x), std::max(max.y, p.y));
+    }
+    uint8_t axis = (max.x - min.x) >= (max.y - min.y) ? 0 : 1;
+
+    std::nth_element(nodes.begin() + begin, nodes.begin() + mid, nodes.begin() + end,
+                     [axis](const Node& a, const Node& b) {
+                         return coordinate(a.position, axis) < coordinate(b.position, axis);
+                     });
+    nodes[mid].axis = axis;
+    nodes[mid].remaining = static_cast<uint32_t>(end - begin);
+    buildRange(begin, mid);
+    buildRange(mid + 1, end);
+}
+
+void KdTree::adjustCounts(uint32_t point, int32_t delta) {
+    // Every node from the root down to the point's own
+    size_t slot = slotOf[point];
+    size_t begin = 0;
+    size_t end = nodes.size();
+    while (begin < end) {
+        size_t mid = begin + (end - begin) / 2;
+        nodes[mid].remaining += delta;
+        if (slot == mid || end - begin <= kLeafSize) {
+            return;
+        }
+        if (slot < mid) {
+            end = mid;
+        } else {
+            begin = mid + 1;
+        }
+    }
+}
+
+void KdTree::searchNearest(size_t begin, size_t end, const Vector2D& point, Best& best) const {
+    if (begin >= end) {
+        return;
+    }
+    size_t mid = begin + (end - begin) / 2;
+    const Node& node = nodes[mid];
+    if (node.remaining == 0) {
+        return;
+    }
+    if (end - begin <= kLeafSize) {
+        for (size_t i = begin; i < end; i++) {
+            Real distanceSquared = nodes[i].position.distanceSquared(point);
+            if (!nodes[i].removed && distanceSquared < best.distanceSquared) {
+                best = Best{distanceSquared, nodes[i].point};
+            }
+        }
+        return;
+    }
+    if (!node.removed) {
+        Real distanceSquared = node.position.distanceSquared(point);
+        if (distanceSquared < best.distanceSquared) {
+            best = Best{distanceSquared, node.point};
+        }
+    }
+
+    // The side the point is on first; the other only if the split line is closer than the best so far
+    Real offset = coordinate(point, node.axis) - coordinate(node.position, node.axis);
+    if (offset < 0) {
+        searchNearest(begin, mid, point, best);
+        if (offset * offset < best.distanceSquared) {
+            searchNearest(mid + 1, end, point, best);
+        }
+    } else {
+        searchNearest(mid + 1, end, point, best);
+        if (offset * offset < best.distanceSquared) {
+            searchNearest(begin, mid, point, best);
+        }
+    }
+}
+
+void KdTree::searchNearest(size_t begin, size_t end, const Vector2D& point, std::span<Best> best, size_t& found,
+                           uint32_t exclude) const {
+    if (begin >= end || best.empty()) {
+        return;
+    }
+    size_t mid = begin + (end - begin) / 2;
+    const Node& node = nodes[mid];
+    if (node.remaining == 0) {
+        return;
+    }
+    auto worst = [&]() {
+        return found < best.size() ? std::numeric_limits<Real>::max() : best[found - 1].distanceSquared;
+    };
+    auto consider = [&](const Node& candidate) {
+        if (candidate.removed || candidate.point == exclude) {
+            return;
+        }
+        Real distanceSquared = candidate.position.distanceSquared(point);
+        if (distanceSquared < worst()) {
+            size_t i = std::min(found, best.size() - 1);
+            while (i > 0 && best[i - 1].distanceSquared > distanceSquared) {
+                best[i] = best[i - 1];
+                i--;
+            }
+            best[i] = Best{distanceSquared, candidate.point};
+            found = std::min(found + 1, best.size());
+        }
+    };
+    if (end - begin <= kLeafSize) {
+        for (size_t i = begin; i < end; i++) {
+            consider(nodes[i]);
+        }
+        return;
+    }
+    consider(node);
+
+    Real offset = coordinate(point, node.axis) - coordinate(node.position, node.axis);
+    size_t nearBegin = offset < 0 ? begin : mid + 1;
+    size_t nearEnd = offset < 0 ? mid : end;
+    size_t farBegin = offset < 0 ? mid + 1 : begin;
+    size_t farEnd = offset < 0 ? end : mid;
+    searchNearest(nearBegin, nearEnd, point, best, found, exclude);
+    if (offset * offset < worst()) {
+        searchNearest(farBegin, farEnd, point, best, found, exclude);
+    }
+}
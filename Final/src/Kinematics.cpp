@@ -0,0 +1,59 @@
+/**
+ * @file Kinematics.cpp
+ * @brief Implementation of the dual-number kinematics helpers
+ */
+#include "../include/Kinematics.h"
+#include <iostream>
+
+std::vector<EndEffectorGradient> computeEndEffectorGradients(const Body& body,
+                                                             const std::vector<std::string>& segmentNames) {
+    std::vector<EndEffectorGradient> results;
+    std::vector<std::string> jointNames = body.getSegmentNames();
+    
+    if (jointNames.size() > kMaxKinematicJoints) {
+        std::cerr << "Cannot differentiate " << jointNames.size() << " joints (maximum is "
+                  << kMaxKinematicJoints << ")" << std::endl;
+        return results;
+    }
+    
+    // Copy the current pose and seed one derivative slot per joint angle
+    BasicBody<KinematicDual> dualBody(body);
+    for (size_t i = 0; i < jointNames.size(); i++) {
+        auto segment = dualBody.getSegment(jointNames[i]);
+        segment->setRawAngle(KinematicDual::variable(segment->getAngle().value, i));
+    }
+    
+    // Single forward pass: every segment end now carries its full gradient
+    dualBody.updateSegments();
+    
+    for (const auto& name : segmentNames) {
+        const auto segment = dualBody.getSegment(name);
+        if (!segment) {
+            std::cerr << "Segment '" << name << "' not found!" << std::endl;
+            continue;
+        }
+        
+        BasicVector2D<KinematicDual> end = segment->getEnd();
+        
+        EndEffectorGradient gradient;
+        gradient.segmentName = name;
+        gradient.position = Vector2D(end.x.value, end.y.value);
+        gradient.jointNames = jointNames;
+        for (size_t i = 0; i < jointNames.size(); i++) {
+            gradient.jointGradients.emplace_back(end.x.derivatives[i], end.y.derivatives[i]);
+        }
+        results.push_back(gradient);
+    }
+    
+    return results;
+}
+
+EndEffectorGradient computeEndEffectorGradient(const Body& body, const std::string& segmentName) {
+    std::vector<EndEffectorGradient> results = computeEndEffectorGradients(body, {segmentName});
+    if (results.empty()) {
+        EndEffectorGradient empty;
+        empty.segmentName = segmentName;
+        return empty;
+    }
+    return results.front();
+}
@@ -33,6 +33,7 @@ void Logger::logMessage(const std::string& message) {
         return;
     }
     
+    std::lock_guard<std::mutex> lock(writeLock);     // std::localtime is not thread-safe either
     std::string timestamp = getTimestamp();
     logFile << timestamp << " - " << message << std::endl;
     std::cout << "LOG: " << timestamp << " - " << message << std::endl;
@@ -44,6 +45,7 @@ void Logger::logError(const std::string& error) {
         return;
     }
     
+    std::lock_guard<std::mutex> lock(writeLock);     // std::localtime is not thread-safe either
     std::string timestamp = getTimestamp();
     logFile << timestamp << " - ERROR: " << error << std::endl;
     std::cerr << "ERROR: " << timestamp << " - " << error << std::endl;
@@ -55,6 +57,7 @@ void Logger::logWarning(const std::string& warning) {
         return;
     }
     
+    std::lock_guard<std::mutex> lock(writeLock);     // std::localtime is not thread-safe either
     std::string timestamp = getTimestamp();
     logFile << timestamp << " - WARNING: " << warning << std::endl;
     std::cout << "WARNING: " << timestamp << " - " << warning << std::endl;
@@ -3,6 +3,12 @@
  * @brief Implementation of the MovementStrategy abstract base class
  */
 #include "../include/MovementStrategy.h"
+#include "../include/World.h"
 
-// Since MovementStrategy is an abstract base class with implementation in the header,
-// no additional implementation is needed here.
\ No newline at end of file
+Body* MovementStrategy::getBody() const {
+    return world->getBody(bodyHandle);
+}
+
+Circle* MovementStrategy::getTarget() const {
+    return world->getCircle(targetHandle);
+}
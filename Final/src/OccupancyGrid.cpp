@@ -0,0 +1,248 @@
+/**
+ * @file OccupancyGrid.cpp
+ * @brief Implementation of the Obstacle and OccupancyGrid classes
+ */
+#include "../include/OccupancyGrid.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace {
+// Cell coordinates are kept well inside int32_t (as in SpatialGrid)
+constexpr Real kMaxCellCoordinate = Real(1 << 30);
+
+size_t wordsFor(int32_t cells) {
+    return (static_cast<size_t>(cells) + 63) / 64;
+}
+}
+
+Obstacle Obstacle::circle(const Vector2D& center, Real radius) {
+    return Obstacle{Shape::CIRCLE, center, Vector2D(radius, radius)};
+}
+
+Obstacle Obstacle::box(const Vector2D& min, const Vector2D& max) {
+    return Obstacle{Shape::BOX, (min + max) * Real(0.5), (max - min) * Real(0.5)};
+}
+
+Aabb Obstacle::getBounds() const {
+    return Aabb{center - halfSize, center + halfSize};
+}
+
+OccupancyGrid::OccupancyGrid(std::pmr::memory_resource* resource)
+    : origin(0, 0), cellSize(1), inverseCellSize(1), width(0), height(0), wordsPerRow(0), wordsPerColumn(0),
+      rows(resource), columns(resource), blockedLine(resource) {
+}
+
+void OccupancyGrid::resize(const Vector2D& origin, Real cellSize, int32_t width, int32_t height) {
+    this->origin = origin;
+    this->cellSize = cellSize;
+    inverseCellSize = Real(1) / cellSize;
+    this->width = std::max(width, 0);
+    this->height = std::max(height, 0);
+    wordsPerRow = wordsFor(this->width);
+    wordsPerColumn = wordsFor(this->height);
+    blockedLine.assign(std::max(wordsPerRow, wordsPerColumn), ~uint64_t(0));
+    clear();
+}
+
+void OccupancyGrid::clear() {
+    rows.assign(static_cast<size_t>(height) * wordsPerRow, 0);
+    columns.assign(static_cast<size_t>(width) * wordsPerColumn, 0);
+
+    // Padding past the last cell reads as blocked, so scans stop at the edge
+    if (width % 64 != 0) {
+        for (int32_t y = 0; y < height; y++) {
+            rows[y * wordsPerRow + wordsPerRow - 1] |= ~uint64_t(0) << (width % 64);
+        }
+    }
+    if (height % 64 != 0) {
+        for (int32_t x = 0; x < width; x++) {
+            columns[x * wordsPerColumn + wordsPerColumn - 1] |= ~uint64_t(0) << (height % 64);
+        }
+    }
+}
+
+bool OccupancyGrid::isBlocked(int32_t x, int32_t y) const {
+    if (x < 0 || y < 0 || x >= width || y >= height) {
+        return true;
+    }
+    return (rows[y * wordsPerRow + x / 64] >> (x % 64)) & 1;
+}
+
+bool OccupancyGrid::isBlocked(GridCell cell) const {
+    return isBlocked(cell.x, cell.y);
+}
+
+void OccupancyGrid::setBlocked(int32_t x, int32_t y, bool blocked) {
+    if (x < 0 || y < 0 || x >= width || y >= height) {
+        return;
+    }
+    fillRow(y, x, x, blocked);
+}
+
+bool OccupancyGrid::contains(GridCell cell) const {
+    return cell.x >= 0 && cell.y >= 0 && cell.x < width && cell.y < height;
+}
+
+void OccupancyGrid::markObstacle(const Obstacle& obstacle, Real clearance) {
+    Vector2D grownHalf = obstacle.halfSize + Vector2D(clearance, clearance);
+    Vector2D min = obstacle.center - grownHalf;
+    Vector2D max = obstacle.center + grownHalf;
+    int32_t minY = std::max(toCellY(min.y), 0);
+    int32_t maxY = std::min(toCellY(max.y), height - 1);
+
+    if (obstacle.shape == Obstacle::Shape::BOX) {
+        int32_t minX = std::max(toCellX(min.x), 0);
+        int32_t maxX = std::min(toCellX(max.x), width - 1);
+        for (int32_t y = minY; y <= maxY; y++) {
+            fillRow(y, minX, maxX, true);
+        }
+        return;
+    }
+
+    // Circle: per row, the cells within radius of the center horizontally
+    // once the vertical distance to the row is taken off
+    Real radius = grownHalf.x;
+    for (int32_t y = minY; y <= maxY; y++) {
+        Real rowMin = origin.y + y * cellSize;
+        Real dy = std::max(std::max(rowMin - obstacle.center.y, obstacle.center.y - (rowMin + cellSize)), Real(0));
+        if (dy > radius) {
+            continue;
+        }
+        Real halfWidth = std::sqrt(radius * radius - dy * dy);
+        int32_t minX = std::max(toCellX(obstacle.center.x - halfWidth), 0);
+        int32_t maxX = std::min(toCellX(obstacle.center.x + halfWidth), width - 1);
+        fillRow(y, minX, maxX, true);
+    }
+}
+
+void OccupancyGrid::clearCells(const Aabb& box) {
+    int32_t minX = std::max(toCellX(box.min.x), 0);
+    int32_t maxX = std::min(toCellX(box.max.x), width - 1);
+    int32_t minY = std::max(toCellY(box.min.y), 0);
+    int32_t maxY = std::min(toCellY(box.max.y), height - 1);
+    for (int32_t y = minY; y <= maxY; y++) {
+        fillRow(y, minX, maxX, false);
+    }
+}
+
+GridCell OccupancyGrid::toCell(const Vector2D& point) const {
+    return GridCell{toCellX(point.x), toCellY(point.y)};
+}
+
+Vector2D OccupancyGrid::getCellCenter(GridCell cell) const {
+    return Vector2D(origin.x + (cell.x + Real(0.5)) * cellSize, origin.y + (cell.y + Real(0.5)) * cellSize);
+}
+
+bool OccupancyGrid::hasLineOfSight(GridCell from, GridCell to) const {
+    // Walk the cells the center-to-center segment passes through; error
+    // tracks which cell boundary the segment crosses next
+    int32_t dx = std::abs(to.x - from.x);
+    int32_t dy = std::abs(to.y - from.y);
+    int32_t stepX = to.x > from.x ? 1 : -1;
+    int32_t stepY = to.y > from.y ? 1 : -1;
+    int64_t error = int64_t(dx) - dy;
+    int32_t x = from.x;
+    int32_t y = from.y;
+
+    for (int32_t remaining = dx + dy; ; ) {
+        if (isBlocked(x, y)) {
+            return false;
+        }
+        if (remaining <= 0) {
+            return true;
+        }
+        if (error > 0) {
+            x += stepX;
+            error -= 2 * int64_t(dy);
+            remaining--;
+        } else if (error < 0) {
+            y += stepY;
+            error += 2 * int64_t(dx);
+            remaining--;
+        } else {
+            // Through a corner: both cells beside it must be free
+            if (isBlocked(x + stepX, y) || isBlocked(x, y + stepY)) {
+                return false;
+            }
+            x += stepX;
+            y += stepY;
+            error += 2 * (int64_t(dx) - dy);
+            remaining -= 2;
+        }
+    }
+}
+
+const uint64_t* OccupancyGrid::getRowBits(int32_t y) const {
+    if (y < 0 || y >= height) {
+        return blockedLine.data();
+    }
+    return rows.data() + y * wordsPerRow;
+}
+
+const uint64_t* OccupancyGrid::getColumnBits(int32_t x) const {
+    if (x < 0 || x >= width) {
+        return blockedLine.data();
+    }
+    return columns.data() + x * wordsPerColumn;
+}
+
+size_t OccupancyGrid::getWordsPerRow() const {
+    return wordsPerRow;
+}
+
+size_t OccupancyGrid::getWordsPerColumn() const {
+    return wordsPerColumn;
+}
+
+int32_t OccupancyGrid::getWidth() const {
+    return width;
+}
+
+int32_t OccupancyGrid::getHeight() const {
+    return height;
+}
+
+Real OccupancyGrid::getCellSize() const {
+    return cellSize;
+}
+
+Vector2D OccupancyGrid::getOrigin() const {
+    return origin;
+}
+
+bool OccupancyGrid::isEmpty() const {
+    return width == 0 || height == 0;
+}
+
+void OccupancyGrid::fillRow(int32_t y, int32_t minX, int32_t maxX, bool blocked) {
+    if (minX > maxX) {
+        return;
+    }
+
+    // Row: whole words at a time
+    uint64_t* row = rows.data() + y * wordsPerRow;
+    for (int32_t word = minX / 64; word <= maxX / 64; word++) {
+        int32_t first = std::max(minX, word * 64) - word * 64;
+        int32_t last = std::min(maxX, word * 64 + 63) - word * 64;
+        uint64_t mask = (~uint64_t(0) << first) & (~uint64_t(0) >> (63 - last));
+        row[word] = blocked ? (row[word] | mask) : (row[word] & ~mask);
+    }
+
+    // Columns: one bit in each
+    uint64_t bit = uint64_t(1) << (y % 64);
+    for (int32_t x = minX; x <= maxX; x++) {
+        uint64_t& word = columns[x * wordsPerColumn + y / 64];
+        word = blocked ? (word | bit) : (word & ~bit);
+    }
+}
+
+int32_t OccupancyGrid::toCellX(Real x) const {
+    Real cell = std::clamp((x - origin.x) * inverseCellSize, -kMaxCellCoordinate, kMaxCellCoordinate);
+    return static_cast<int32_t>(std::floor(cell));
+}
+
+int32_t OccupancyGrid::toCellY(Real y) const {
+    Real cell = std::clamp((y - origin.y) * inverseCellSize, -kMaxCellCoordinate, kMaxCellCoordinate);
+    return static_cast<int32_t>(std::floor(cell));
+}
@@ -0,0 +1,323 @@
+/**
+ * @file PathPlanner.cpp
+ * @brief Implementation of the PathPlanner class
+ */
+#include "../include/PathPlanner.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdlib>
+
+namespace {
+constexpr float kDiagonalCost = 1.41421356f;
+
+// Cost of the cheapest 8-connected move sequence between two cells
+float octileDistance(int32_t dx, int32_t dy) {
+    int32_t straight = std::abs(dx);
+    int32_t diagonal = std::abs(dy);
+    if (straight < diagonal) {
+        std::swap(straight, diagonal);
+    }
+    return static_cast<float>(straight - diagonal) + kDiagonalCost * static_cast<float>(diagonal);
+}
+
+int32_t sign(int32_t value) {
+    return (value > 0) - (value < 0);
+}
+
+uint32_t hashCell(uint32_t cell) {
+    return cell * 2654435761u;
+}
+}
+
+PathPlanner::PathPlanner(std::pmr::memory_resource* resource)
+    : nodes(resource), nodeCount(0), search(0), open(resource), grid(nullptr), goal{0, 0}, expandedNodes(0) {
+}
+
+bool PathPlanner::findPath(const OccupancyGrid& grid, GridCell start, GridCell goal, std::vector<GridCell>& path) {
+    path.clear();
+    open.clear();
+    nodeCount = 0;
+    if (++search == 0) {
+        // Stamps wrapped around: forget every slot once
+        for (Node& node : nodes) {
+            node.search = 0;
+        }
+        search = 1;
+    }
+    expandedNodes = 0;
+    if (grid.isBlocked(start) || grid.isBlocked(goal)) {
+        return false;
+    }
+    this->grid = &grid;
+    this->goal = goal;
+
+    uint32_t width = static_cast<uint32_t>(grid.getWidth());
+    uint32_t goalCell = goal.y * width + goal.x;
+    push(start.y * width + start.x, kNoNode, 0.0f);
+
+    while (!open.empty()) {
+        std::pop_heap(open.begin(), open.end());
+        uint32_t cell = open.back().cell;
+        open.pop_back();
+
+        // A cell is pushed again when a cheaper way to it turns up; only the first pop counts
+        Node* node = findNode(cell);
+        if (node->closed) {
+            continue;
+        }
+        node->closed = true;
+        expandedNodes++;
+
+        if (cell == goalCell) {
+            for (uint32_t c = cell; c != kNoNode; c = findNode(c)->parent) {
+                path.push_back(GridCell{static_cast<int32_t>(c % width), static_cast<int32_t>(c / width)});
+            }
+            std::reverse(path.begin(), path.end());
+            return true;
+        }
+        expand(cell, node->cost, node->parent);
+    }
+    return false;
+}
+
+void PathPlanner::smoothPath(const OccupancyGrid& grid, std::vector<GridCell>& path) const {
+    if (path.size() < 3) {
+        return;
+    }
+
+    // Keep a point only when the last kept one cannot see the point after it
+    size_t kept = 0;
+    for (size_t i = 1; i + 1 < path.size(); i++) {
+        if (!grid.hasLineOfSight(path[kept], path[i + 1])) {
+            path[++kept] = path[i];
+        }
+    }
+    path[++kept] = path.back();
+    path.resize(kept + 1);
+}
+
+bool PathPlanner::planPath(const OccupancyGrid& grid, const Vector2D& from, const Vector2D& to,
+                           std::vector<Vector2D>& waypoints) {
+    waypoints.clear();
+    std::vector<GridCell> cells;
+    if (!findPath(grid, grid.toCell(from), grid.toCell(to), cells)) {
+        return false;
+    }
+    smoothPath(grid, cells);
+
+    // The walker is already in the first cell and ends exactly at 'to'
+    for (size_t i = 1; i + 1 < cells.size(); i++) {
+        waypoints.push_back(grid.getCellCenter(cells[i]));
+    }
+    waypoints.push_back(to);
+    return true;
+}
+
+size_t PathPlanner::getExpandedNodes() const {
+    return expandedNodes;
+}
+
+PathPlanner::Node* PathPlanner::findNode(uint32_t cell) {
+    size_t mask = nodes.size() - 1;
+    for (size_t slot = hashCell(cell) & mask; ; slot = (slot + 1) & mask) {
+        Node& node = nodes[slot];
+        if (node.search != search) {
+            return nullptr;
+        }
+        if (node.cell == cell) {
+            return &node;
+        }
+    }
+}
+
+PathPlanner::Node& PathPlanner::insertNode(uint32_t cell, bool& inserted) {
+    // At most half full, so probes stay short
+    if (2 * (nodeCount + 1) > nodes.size()) {
+        std::pmr::vector<Node> old(std::max<size_t>(1024, 2 * nodes.size()), Node{0, 0, 0.0f, kNoNode, false},
+                                   nodes.get_allocator());
+        old.swap(nodes);
+        nodeCount = 0;
+        for (const Node& node : old) {
+            if (node.search == search) {
+                bool unused;
+                insertNode(node.cell, unused) = node;
+            }
+        }
+    }
+
+    size_t mask = nodes.size() - 1;
+    for (size_t slot = hashCell(cell) & mask; ; slot = (slot + 1) & mask) {
+        Node& node = nodes[slot];
+        if (node.search != search) {
+            node = Node{cell, search, 0.0f, kNoNode, false};
+            nodeCount++;
+            inserted = true;
+            return node;
+        }
+        if (node.cell == cell) {
+            inserted = false;
+            return node;
+        }
+    }
+}
+
+void PathPlanner::expand(uint32_t cell, float cost, uint32_t parent) {
+    int32_t width = grid->getWidth();
+    int32_t x = static_cast<int32_t>(cell % width);
+    int32_t y = static_cast<int32_t>(cell / width);
+
+    // Directions worth jumping in, pruned by the direction we arrived from
+    int32_t directions[8][2];
+    int count = 0;
+    auto add = [&](int32_t dx, int32_t dy) {
+        directions[count][0] = dx;
+        directions[count][1] = dy;
+        count++;
+    };
+    if (parent == kNoNode) {
+        for (int32_t dy = -1; dy <= 1; dy++) {
+            for (int32_t dx = -1; dx <= 1; dx++) {
+                if (dx != 0 || dy != 0) {
+                    add(dx, dy);
+                }
+            }
+        }
+    } else {
+        int32_t dx = sign(x - static_cast<int32_t>(parent % width));
+        int32_t dy = sign(y - static_cast<int32_t>(parent / width));
+        if (dx != 0 && dy != 0) {
+            add(dx, 0);
+            add(0, dy);
+            add(dx, dy);
+        } else if (dx != 0) {
+            add(dx, 0);
+            for (int32_t side : {-1, 1}) {
+                // Forced: the cell beside us is only reachable cheaply through here
+                if (!grid->isBlocked(x, y + side) && grid->isBlocked(x - dx, y + side)) {
+                    add(0, side);
+                    add(dx, side);
+                }
+            }
+        } else {
+            add(0, dy);
+            for (int32_t side : {-1, 1}) {
+                if (!grid->isBlocked(x + side, y) && grid->isBlocked(x + side, y - dy)) {
+                    add(side, 0);
+                    add(side, dy);
+                }
+            }
+        }
+    }
+
+    for (int i = 0; i < count; i++) {
+        int32_t dx = directions[i][0];
+        int32_t dy = directions[i][1];
+        int32_t jump;
+        if (dx != 0 && dy != 0) {
+            // No cutting corners
+            if (grid->isBlocked(x + dx, y) || grid->isBlocked(x, y + dy)) {
+                continue;
+            }
+            jump = jumpDiagonal(x + dx, y + dy, dx, dy);
+        } else {
+            jump = jumpStraight(x + dx, y + dy, dx, dy);
+        }
+        if (jump >= 0) {
+            int32_t jumpX = jump % width;
+            int32_t jumpY = jump / width;
+            push(static_cast<uint32_t>(jump), cell, cost + octileDistance(jumpX - x, jumpY - y));
+        }
+    }
+}
+
+void PathPlanner::push(uint32_t cell, uint32_t parent, float cost) {
+    bool inserted;
+    Node& node = insertNode(cell, inserted);
+    if (!inserted && (node.closed || node.cost <= cost)) {
+        return;
+    }
+    node.cost = cost;
+    node.parent = parent;
+    int32_t width = grid->getWidth();
+    open.push_back(OpenEntry{cost + heuristic(static_cast<int32_t>(cell % width), static_cast<int32_t>(cell / width)),
+                             cell});
+    std::push_heap(open.begin(), open.end());
+}
+
+int32_t PathPlanner::jumpStraight(int32_t x, int32_t y, int32_t dx, int32_t dy) const {
+    int32_t width = grid->getWidth();
+    if (grid->isBlocked(x, y)) {
+        return -1;
+    }
+    if (dx != 0) {
+        int32_t stop = scanLine(grid->getRowBits(y), grid->getRowBits(y - 1), grid->getRowBits(y + 1),
+                                grid->getWordsPerRow(), x, dx, goal.y == y ? goal.x : -1);
+        return stop < 0 ? -1 : y * width + stop;
+    }
+    int32_t stop = scanLine(grid->getColumnBits(x), grid->getColumnBits(x - 1), grid->getColumnBits(x + 1),
+                            grid->getWordsPerColumn(), y, dy, goal.x == x ? goal.y : -1);
+    return stop < 0 ? -1 : stop * width + x;
+}
+
+int32_t PathPlanner::jumpDiagonal(int32_t x, int32_t y, int32_t dx, int32_t dy) const {
+    int32_t width = grid->getWidth();
+    while (!grid->isBlocked(x, y)) {
+        // A turn is needed here if a straight jump from here finds something
+        if (GridCell{x, y} == goal || jumpStraight(x + dx, y, dx, 0) >= 0 || jumpStraight(x, y + dy, 0, dy) >= 0) {
+            return y * width + x;
+        }
+        if (grid->isBlocked(x + dx, y) || grid->isBlocked(x, y + dy)) {
+            return -1;
+        }
+        x += dx;
+        y += dy;
+    }
+    return -1;
+}
+
+int32_t PathPlanner::scanLine(const uint64_t* line, const uint64_t* sideA, const uint64_t* sideB,
+                              size_t words, int32_t position, int32_t direction, int32_t goal) {
+    // Stops are blocked cells on the line and forced cells: free beside the
+    // line with the cell behind them (against the direction) blocked. Each
+    // word of the side lines is shifted by one cell to line up "behind".
+    int32_t word = position / 64;
+    if (direction > 0) {
+        uint64_t mask = ~uint64_t(0) << (position % 64);
+        for (size_t w = word; w < words; w++) {
+            uint64_t behindA = (sideA[w] << 1) | (w > 0 ? sideA[w - 1] >> 63 : 1);
+            uint64_t behindB = (sideB[w] << 1) | (w > 0 ? sideB[w - 1] >> 63 : 1);
+            uint64_t stops = (line[w] | (~sideA[w] & behindA) | (~sideB[w] & behindB)) & mask;
+            mask = ~uint64_t(0);
+            if (stops != 0) {
+                int32_t stop = static_cast<int32_t>(w * 64) + std::countr_zero(stops);
+                if (goal >= position && goal <= stop) {
+                    return goal;
+                }
+                return ((line[w] >> (stop % 64)) & 1) ? -1 : stop;
+            }
+        }
+        return goal >= position ? goal : -1;
+    }
+
+    uint64_t mask = ~uint64_t(0) >> (63 - position % 64);
+    for (int32_t w = word; w >= 0; w--) {
+        bool last = static_cast<size_t>(w) + 1 >= words;
+        uint64_t behindA = (sideA[w] >> 1) | ((last ? 1 : sideA[w + 1] & 1) << 63);
+        uint64_t behindB = (sideB[w] >> 1) | ((last ? 1 : sideB[w + 1] & 1) << 63);
+        uint64_t stops = (line[w] | (~sideA[w] & behindA) | (~sideB[w] & behindB)) & mask;
+        mask = ~uint64_t(0);
+        if (stops != 0) {
+            int32_t stop = w * 64 + 63 - std::countl_zero(stops);
+            if (goal >= 0 && goal <= position && goal >= stop) {
+                return goal;
+            }
+            return ((line[w] >> (stop % 64)) & 1) ? -1 : stop;
+        }
+    }
+    return (goal >= 0 && goal <= position) ? goal : -1;
+}
+
+float PathPlanner::heuristic(int32_t x, int32_t y) const {
+    return octileDistance(goal.x - x, goal.y - y);
+}
@@ -0,0 +1,384 @@
+/**
+ * @file PointKernels.cpp
+ * @brief Runtime-dispatched implementations of the point kernels
+ */
+#include "../include/PointKernels.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define POINT_KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// One lane at a time: the portable fallback
+template <typename Scalar>
+struct ScalarOps {
+    using T = Scalar;
+    using V = Scalar;
+    static constexpr size_t width = 1;
+    static V load(const T* p) { return *p; }
+    static void store(T* p, V v) { *p = v; }
+    static V set1(T v) { return v; }
+    static V add(V a, V b) { return a + b; }
+    static V sub(V a, V b) { return a - b; }
+    static V mul(V a, V b) { return a * b; }
+    static V div(V a, V b) { return a / b; }
+    static V min(V a, V b) { return std::min(a, b); }
+    static V max(V a, V b) { return std::max(a, b); }
+    static V sqrt(V a) { return std::sqrt(a); }
+    static unsigned lessEqualBits(V a, V b) { return a <= b ? 1u : 0u; }
+    using M = bool;
+    static M lessMask(V a, V b) { return a < b; }
+    static V select(M m, V a, V b) { return m ? a : b; }
+};
+
+} // namespace
+
+#define POINT_KERNELS_NAMESPACE portable
+#include "PointKernelsSimd.inl"
+#undef POINT_KERNELS_NAMESPACE
+
+#ifdef POINT_KERNELS_X86
+
+#pragma GCC push_options
+#pragma GCC target("sse2")
+
+namespace {
+
+struct Sse2Double {
+    using T = double;
+    using V = __m128d;
+    static constexpr size_t width = 2;
+    static V load(const T* p) { return _mm_loadu_pd(p); }
+    static void store(T* p, V v) { _mm_storeu_pd(p, v); }
+    static V set1(T v) { return _mm_set1_pd(v); }
+    static V add(V a, V b) { return _mm_add_pd(a, b); }
+    static V sub(V a, V b) { return _mm_sub_pd(a, b); }
+    static V mul(V a, V b) { return _mm_mul_pd(a, b); }
+    static V div(V a, V b) { return _mm_div_pd(a, b); }
+    static V min(V a, V b) { return _mm_min_pd(a, b); }
+    static V max(V a, V b) { return _mm_max_pd(a, b); }
+    static V sqrt(V a) { return _mm_sqrt_pd(a); }
+    static unsigned lessEqualBits(V a, V b) { return static_cast<unsigned>(_mm_movemask_pd(_mm_cmple_pd(a, b))); }
+    using M = __m128d;
+    static M lessMask(V a, V b) { return _mm_cmplt_pd(a, b); }
+    static V select(M m, V a, V b) { return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b)); }
+};
+
+struct Sse2Float {
+    using T = float;
+    using V = __m128;
+    static constexpr size_t width = 4;
+    static V load(const T* p) { return _mm_loadu_ps(p); }
+    static void store(T* p, V v) { _mm_storeu_ps(p, v); }
+    static V set1(T v) { return _mm_set1_ps(v); }
+    static V add(V a, V b) { return _mm_add_ps(a, b); }
+    static V sub(V a, V b) { return _mm_sub_ps(a, b); }
+    static V mul(V a, V b) { return _mm_mul_ps(a, b); }
+    static V div(V a, V b) { return _mm_div_ps(a, b); }
+    static V min(V a, V b) { return _mm_min_ps(a, b); }
+    static V max(V a, V b) { return _mm_max_ps(a, b); }
+    static V sqrt(V a) { return _mm_sqrt_ps(a); }
+    static unsigned lessEqualBits(V a, V b) { return static_cast<unsigned>(_mm_movemask_ps(_mm_cmple_ps(a, b))); }
+    using M = __m128;
+    static M lessMask(V a, V b) { return _mm_cmplt_ps(a, b); }
+    static V select(M m, V a, V b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+};
+
+} // namespace
+
+#define POINT_KERNELS_NAMESPACE sse2
+#include "PointKernelsSimd.inl"
+#undef POINT_KERNELS_NAMESPACE
+
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx2")
+
+namespace {
+
+struct Avx2Double {
+    using T = double;
+    using V = __m256d;
+    static constexpr size_t width = 4;
+    static V load(const T* p) { return _mm256_loadu_pd(p); }
+    static void store(T* p, V v) { _mm256_storeu_pd(p, v); }
+    static V set1(T v) { return _mm256_set1_pd(v); }
+    static V add(V a, V b) { return _mm256_add_pd(a, b); }
+    static V sub(V a, V b) { return _mm256_sub_pd(a, b); }
+    static V mul(V a, V b) { return _mm256_mul_pd(a, b); }
+    static V div(V a, V b) { return _mm256_div_pd(a, b); }
+    static V min(V a, V b) { return _mm256_min_pd(a, b); }
+    static V max(V a, V b) { return _mm256_max_pd(a, b); }
+    static V sqrt(V a) { return _mm256_sqrt_pd(a); }
+    static unsigned lessEqualBits(V a, V b) {
+        return static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_LE_OQ)));
+    }
+    using M = __m256d;
+    static M lessMask(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+    static V select(M m, V a, V b) { return _mm256_blendv_pd(b, a, m); }
+};
+
+struct Avx2Float {
+    using T = float;
+    using V = __m256;
+    static constexpr size_t width = 8;
+    static V load(const T* p) { return _mm256_loadu_ps(p); }
+    static void store(T* p, V v) { _mm256_storeu_ps(p, v); }
+    static V set1(T v) { return _mm256_set1_ps(v); }
+    static V add(V a, V b) { return _mm256_add_ps(a, b); }
+    static V sub(V a, V b) { return _mm256_sub_ps(a, b); }
+    static V mul(V a, V b) { return _mm256_mul_ps(a, b); }
+    static V div(V a, V b) { return _mm256_div_ps(a, b); }
+    static V min(V a, V b) { return _mm256_min_ps(a, b); }
+    static V max(V a, V b) { return _mm256_max_ps(a, b); }
+    static V sqrt(V a) { return _mm256_sqrt_ps(a); }
+    static unsigned lessEqualBits(V a, V b) {
+        return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_LE_OQ)));
+    }
+    using M = __m256;
+    static M lessMask(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static V select(M m, V a, V b) { return _mm256_blendv_ps(b, a, m); }
+};
+
+} // namespace
+
+#define POINT_KERNELS_NAMESPACE avx2
+#include "PointKernelsSimd.inl"
+#undef POINT_KERNELS_NAMESPACE
+
+#pragma GCC pop_options
+
+#endif // POINT_KERNELS_X86
+
+namespace {
+
+// Entry points of one instruction set for one scalar type
+template <typename T>
+struct KernelTable {
+    void (*translate)(T*, T*, size_t, T, T);
+    void (*rotate)(T*, T*, size_t, T, T);
+    void (*scale)(T*, T*, size_t, T);
+    void (*dot)(const T*, const T*, size_t, T, T, T*);
+    void (*distanceToPoint)(const T*, const T*, size_t, T, T, T*);
+    void (*distanceToSegment)(const T*, const T*, size_t, T, T, T, T, T, T*);
+    size_t (*inCircle)(const T*, const T*, size_t, T, T, T, unsigned char*);
+    void (*sinCos)(const T*, size_t, T*, T*);
+    void (*clampAngles)(T*, const T*, const T*, size_t);
+    void (*segmentPairDistance)(const T*, const T*, const T*, const T*,
+                                const T*, const T*, const T*, const T*, size_t, T*);
+};
+
+enum class InstructionSet { PORTABLE, SSE2, AVX2 };
+
+InstructionSet detectInstructionSet() {
+#ifdef POINT_KERNELS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return InstructionSet::AVX2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return InstructionSet::SSE2;
+    }
+#endif
+    return InstructionSet::PORTABLE;
+}
+
+InstructionSet detectedInstructionSet() {
+    static const InstructionSet instructionSet = detectInstructionSet();
+    return instructionSet;
+}
+
+// The best the CPU has, unless setPointKernelInstructionSet stepped it down
+InstructionSet& activeInstructionSet() {
+    static InstructionSet instructionSet = detectedInstructionSet();
+    return instructionSet;
+}
+
+#define POINT_KERNEL_TABLE(ns, Ops) \
+    KernelTable<Ops::T>{ \
+        &ns::translate<Ops>, &ns::rotate<Ops>, &ns::scale<Ops>, &ns::dot<Ops>, \
+        &ns::distanceToPoint<Ops>, &ns::distanceToSegment<Ops>, &ns::inCircle<Ops>, &ns::sinCos<Ops>, \
+        &ns::clampAngles<Ops>, &ns::segmentPairDistance<Ops> \
+    }
+
+template <typename T>
+KernelTable<T> selectKernels(InstructionSet instructionSet);
+
+template <>
+KernelTable<double> selectKernels<double>(InstructionSet instructionSet) {
+#ifdef POINT_KERNELS_X86
+    switch (instructionSet) {
+        case InstructionSet::AVX2:
+            return POINT_KERNEL_TABLE(avx2, Avx2Double);
+        case InstructionSet::SSE2:
+            return POINT_KERNEL_TABLE(sse2, Sse2Double);
+        case InstructionSet::PORTABLE:
+            break;
+    }
+#endif
+    return POINT_KERNEL_TABLE(portable, ScalarOps<double>);
+}
+
+template <>
+KernelTable<float> selectKernels<float>(InstructionSet instructionSet) {
+#ifdef POINT_KERNELS_X86
+    switch (instructionSet) {
+        case InstructionSet::AVX2:
+            return POINT_KERNEL_TABLE(avx2, Avx2Float);
+        case InstructionSet::SSE2:
+            return POINT_KERNEL_TABLE(sse2, Sse2Float);
+        case InstructionSet::PORTABLE:
+            break;
+    }
+#endif
+    return POINT_KERNEL_TABLE(portable, ScalarOps<float>);
+}
+
+template <typename T>
+const KernelTable<T>& kernels() {
+    static const KernelTable<T> tables[] = {
+        selectKernels<T>(InstructionSet::PORTABLE), selectKernels<T>(InstructionSet::SSE2),
+        selectKernels<T>(InstructionSet::AVX2)
+    };
+    return tables[static_cast<size_t>(activeInstructionSet())];
+}
+
+} // namespace
+
+template <typename Scalar>
+void translatePoints(std::span<Scalar> xs, std::span<Scalar> ys, const BasicVector2D<Scalar>& offset) {
+    size_t count = std::min(xs.size(), ys.size());
+    kernels<Scalar>().translate(xs.data(), ys.data(), count, offset.x, offset.y);
+}
+
+template <typename Scalar>
+void rotatePoints(std::span<Scalar> xs, std::span<Scalar> ys, Scalar angle) {
+    size_t count = std::min(xs.size(), ys.size());
+    SinCos<Scalar> sc = sinCos(angle);
+    kernels<Scalar>().rotate(xs.data(), ys.data(), count, sc.cos, sc.sin);
+}
+
+template <typename Scalar>
+void scalePoints(std::span<Scalar> xs, std::span<Scalar> ys, Scalar factor) {
+    size_t count = std::min(xs.size(), ys.size());
+    kernels<Scalar>().scale(xs.data(), ys.data(), count, factor);
+}
+
+template <typename Scalar>
+void dotPoints(std::span<const Scalar> xs, std::span<const Scalar> ys,
+               const BasicVector2D<Scalar>& v, std::span<Scalar> out) {
+    size_t count = std::min({xs.size(), ys.size(), out.size()});
+    kernels<Scalar>().dot(xs.data(), ys.data(), count, v.x, v.y, out.data());
+}
+
+template <typename Scalar>
+void distancesToPoint(std::span<const Scalar> xs, std::span<const Scalar> ys,
+                      const BasicVector2D<Scalar>& point, std::span<Scalar> out) {
+    size_t count = std::min({xs.size(), ys.size(), out.size()});
+    kernels<Scalar>().distanceToPoint(xs.data(), ys.data(), count, point.x, point.y, out.data());
+}
+
+template <typename Scalar>
+void distancesToSegment(std::span<const Scalar> xs, std::span<const Scalar> ys,
+                        const BasicVector2D<Scalar>& start, const BasicVector2D<Scalar>& end,
+                        std::span<Scalar> out) {
+    size_t count = std::min({xs.size(), ys.size(), out.size()});
+    BasicVector2D<Scalar> direction = end - start;
+    Scalar lengthSquared = direction.lengthSquared();
+    
+    // A degenerate segment measures the distance to its start point
+    Scalar inverseLengthSquared = lengthSquared > 0 ? Scalar(1) / lengthSquared : Scalar(0);
+    kernels<Scalar>().distanceToSegment(xs.data(), ys.data(), count, start.x, start.y,
+                                        direction.x, direction.y, inverseLengthSquared, out.data());
+}
+
+template <typename Scalar>
+size_t pointsInCircle(std::span<const Scalar> xs, std::span<const Scalar> ys,
+                      const BasicVector2D<Scalar>& center, Scalar radius,
+                      std::span<unsigned char> inside) {
+    size_t count = std::min({xs.size(), ys.size(), inside.size()});
+    return kernels<Scalar>().inCircle(xs.data(), ys.data(), count, center.x, center.y, radius, inside.data());
+}
+
+template <typename Scalar>
+void sinCosAngles(std::span<const Scalar> angles, std::span<Scalar> sines, std::span<Scalar> cosines) {
+    size_t count = std::min({angles.size(), sines.size(), cosines.size()});
+#ifdef OOCATCHER_LIBM_TRIG
+    for (size_t i = 0; i < count; i++) {
+        sines[i] = std::sin(angles[i]);
+        cosines[i] = std::cos(angles[i]);
+    }
+#else
+    kernels<Scalar>().sinCos(angles.data(), count, sines.data(), cosines.data());
+#endif
+}
+
+template <typename Scalar>
+void clampAngles(std::span<Scalar> angles, std::span<const Scalar> centers, std::span<const Scalar> halfWidths) {
+    size_t count = std::min({angles.size(), centers.size(), halfWidths.size()});
+    kernels<Scalar>().clampAngles(angles.data(), centers.data(), halfWidths.data(), count);
+}
+
+template <typename Scalar>
+void segmentPairDistancesSquared(const SegmentArrays<Scalar>& a, const SegmentArrays<Scalar>& b,
+                                 std::span<Scalar> out) {
+    size_t count = std::min({a.size(), b.size(), out.size()});
+    kernels<Scalar>().segmentPairDistance(a.startXs.data(), a.startYs.data(), a.endXs.data(), a.endYs.data(),
+                                          b.startXs.data(), b.startYs.data(), b.endXs.data(), b.endYs.data(),
+                                          count, out.data());
+}
+
+const char* getPointKernelInstructionSet() {
+    switch (activeInstructionSet()) {
+        case InstructionSet::AVX2:
+            return "avx2";
+        case InstructionSet::SSE2:
+            return "sse2";
+        case InstructionSet::PORTABLE:
+            break;
+    }
+    return "portable";
+}
+
+bool setPointKernelInstructionSet(std::string_view name) {
+    InstructionSet instructionSet;
+    if (name == "avx2") {
+        instructionSet = InstructionSet::AVX2;
+    } else if (name == "sse2") {
+        instructionSet = InstructionSet::SSE2;
+    } else if (name == "portable") {
+        instructionSet = InstructionSet::PORTABLE;
+    } else {
+        return false;
+    }
+    
+    // The sets are ordered: a CPU with one has the ones before it
+    if (instructionSet > detectedInstructionSet()) {
+        return false;
+    }
+    activeInstructionSet() = instructionSet;
+    return true;
+}
+
+// Explicit instantiations for the supported scalar types
+#define POINT_KERNELS_INSTANTIATE(T) \
+    template void translatePoints<T>(std::span<T>, std::span<T>, const BasicVector2D<T>&); \
+    template void rotatePoints<T>(std::span<T>, std::span<T>, T); \
+    template void scalePoints<T>(std::span<T>, std::span<T>, T); \
+    template void dotPoints<T>(std::span<const T>, std::span<const T>, const BasicVector2D<T>&, std::span<T>); \
+    template void distancesToPoint<T>(std::span<const T>, std::span<const T>, const BasicVector2D<T>&, std::span<T>); \
+    template void distancesToSegment<T>(std::span<const T>, std::span<const T>, const BasicVector2D<T>&, \
+                                        const BasicVector2D<T>&, std::span<T>); \
+    template size_t pointsInCircle<T>(std::span<const T>, std::span<const T>, const BasicVector2D<T>&, T, \
+                                      std::span<unsigned char>); \
+    template void sinCosAngles<T>(std::span<const T>, std::span<T>, std::span<T>); \
+    template void clampAngles<T>(std::span<T>, std::span<const T>, std::span<const T>); \
+    template void segmentPairDistancesSquared<T>(const SegmentArrays<T>&, const SegmentArrays<T>&, std::span<T>);
+
+POINT_KERNELS_INSTANTIATE(float)
+POINT_KERNELS_INSTANTIATE(double)
@@ -0,0 +1,306 @@
+/**
+ * @file PointKernelsSimd.inl
+ * @brief Point kernel bodies shared by every instruction set
+ *
+ * Included by PointKernels.cpp once per instruction set (inside a
+ * matching target region) with POINT_KERNELS_NAMESPACE defined. Ops
+ * supplies the register type, its width and the lane-wise operations;
+ * the points after the last full register use scalar code.
+ */
+namespace POINT_KERNELS_NAMESPACE {
+
+template <typename Ops>
+void translate(typename Ops::T* xs, typename Ops::T* ys, size_t count,
+               typename Ops::T dx, typename Ops::T dy) {
+    auto offsetX = Ops::set1(dx);
+    auto offsetY = Ops::set1(dy);
+    size_t i = 0;
+    for (; i + Ops::width <= count; i += Ops::width) {
+        Ops::store(xs + i, Ops::add(Ops::load(xs + i), offsetX));
+        Ops::store(ys + i, Ops::add(Ops::load(ys + i), offsetY));
+    }
+    for (; i < count; i++) {
+        xs[i] += dx;
+        ys[i] += dy;
+    }
+}
+
+template <typename Ops>
+void rotate(typename Ops::T* xs, typename Ops::T* ys, size_t count,
+            typename Ops::T cosA, typename Ops::T sinA) {
+    auto c = Ops::set1(cosA);
+    auto s = Ops::set1(sinA);
+    size_t i = 0;
+    for (; i + Ops::width <= count; i += Ops::width) {
+        auto x = Ops::load(xs + i);
+        auto y = Ops::load(ys + i);
+        Ops::store(xs + i, Ops::sub(Ops::mul(x, c), Ops::mul(y, s)));
+        Ops::store(ys + i, Ops::add(Ops::mul(x, s), Ops::mul(y, c)));
+    }
+    for (; i < count; i++) {
+        typename Ops::T x = xs[i];
+        typename Ops::T y = ys[i];
+        xs[i] = x * cosA - y * sinA;
+        ys[i] = x * sinA + y * cosA;
+    }
+}
+
+template <typename Ops>
+void scale(typename Ops::T* xs, typename Ops::T* ys, size_t count, typename Ops::T factor) {
+    auto f = Ops::set1(factor);
+    size_t i = 0;
+    for (; i + Ops::width <= count; i += Ops::width) {
+        Ops::store(xs + i, Ops::mul(Ops::load(xs + i), f));
+        Ops::store(ys + i, Ops::mul(Ops::load(ys + i), f));
+    }
+    for (; i < count; i++) {
+        xs[i] *= factor;
+        ys[i] *= factor;
+    }
+}
+
+template <typename Ops>
+void dot(const typename Ops::T* xs, const typename Ops::T* ys, size_t count,
+         typename Ops::T vx, typename Ops::T vy, typename Ops::T* out) {
+    auto x = Ops::set1(vx);
+    auto y = Ops::set1(vy);
+    size_t i = 0;
+    for (; i + Ops::width <= count; i += Ops::width) {
+        Ops::store(out + i, Ops::add(Ops::mul(Ops::load(xs + i), x), Ops::mul(Ops::load(ys + i), y)));
+    }
+    for (; i < count; i++) {
+        out[i] = xs[i] * vx + ys[i] * vy;
+    }
+}
+
+template <typename Ops>
+void distanceToPoint(const typename Ops::T* xs, const typename Ops::T* ys, size_t count,
+                     typename Ops::T px, typename Ops::T py, typename Ops::T* out) {
+    auto x = Ops::set1(px);
+    auto y = Ops::set1(py);
+    size_t i = 0;
+    for (; i + Ops::width <= count; i += Ops::width) {
+        auto dx = Ops::sub(Ops::load(xs + i), x);
+        auto dy = Ops::sub(Ops::load(ys + i), y);
+        Ops::store(out + i, Ops::sqrt(Ops::add(Ops::mul(dx, dx), Ops::mul(dy, dy))));
+    }
+    for (; i < count; i++) {
+        typename Ops::T dx = xs[i] - px;
+        typename Ops::T dy = ys[i] - py;
+        out[i] = std::sqrt(dx * dx + dy * dy);
+    }
+}
+
+template <typename Ops>
+void distanceToSegment(const typename Ops::T* xs, const typename Ops::T* ys, size_t count,
+                       typename Ops::T sx, typename Ops::T sy,
+                       typename Ops::T dirX, typename Ops::T dirY,
+                       typename Ops::T inverseLengthSquared, typename Ops::T* out) {
+    using T = typename Ops::T;
+    auto startX = Ops::set1(sx);
+    auto startY = Ops::set1(sy);
+    auto directionX = Ops::set1(dirX);
+    auto directionY = Ops::set1(dirY);
+    auto inverse = Ops::set1(inverseLengthSquared);
+    auto zero = Ops::set1(T(0));
+    auto one = Ops::set1(T(1));
+    size_t i = 0;
+    for (; i + Ops::width <= count; i += Ops::width) {
+        auto px = Ops::sub(Ops::load(xs + i), startX);
+        auto py = Ops::sub(Ops::load(ys + i), startY);
+        auto t = Ops::mul(Ops::add(Ops::mul(px, directionX), Ops::mul(py, directionY)), inverse);
+        t = Ops::min(Ops::max(t, zero), one);
+        auto dx = Ops::sub(px, Ops::mul(directionX, t));
+        auto dy = Ops::sub(py, Ops::mul(directionY, t));
+        Ops::store(out + i, Ops::sqrt(Ops::add(Ops::mul(dx, dx), Ops::mul(dy, dy))));
+    }
+    for (; i < count; i++) {
+        T px = xs[i] - sx;
+        T py = ys[i] - sy;
+        T t = std::min(std::max((px * dirX + py * dirY) * inverseLengthSquared, T(0)), T(1));
+        T dx = px - dirX * t;
+        T dy = py - dirY * t;
+        out[i] = std::sqrt(dx * dx + dy * dy);
+    }
+}
+
+template <typename Ops>
+size_t inCircle(const typename Ops::T* xs, const typename Ops::T* ys, size_t count,
+                typename Ops::T cx, typename Ops::T cy, typename Ops::T radius,
+                unsigned char* inside) {
+    auto x = Ops::set1(cx);
+    auto y = Ops::set1(cy);
+    auto radiusSquared = Ops::set1(radius * radius);
+    size_t total = 0;
+    size_t i = 0;
+    for (; i + Ops::width <= count; i += Ops::width) {
+        auto dx = Ops::sub(Ops::load(xs + i), x);
+        auto dy = Ops::sub(Ops::load(ys + i), y);
+        unsigned bits = Ops::lessEqualBits(Ops::add(Ops::mul(dx, dx), Ops::mul(dy, dy)), radiusSquared);
+        for (size_t lane = 0; lane < Ops::width; lane++) {
+            inside[i + lane] = static_cast<unsigned char>((bits >> lane) & 1u);
+            total += inside[i + lane];
+        }
+    }
+    for (; i < count; i++) {
+        typename Ops::T dx = xs[i] - cx;
+        typename Ops::T dy = ys[i] - cy;
+        inside[i] = dx * dx + dy * dy <= radius * radius ? 1 : 0;
+        total += inside[i];
+    }
+    return total;
+}
+
+// Squared distance from p to the segment a + t * d, t in [0, 1] (inverseLengthSquared = 0 if d = 0)
+template <typename Ops, typename V>
+V pointToSegmentSquared(V px, V py, V ax, V ay, V dx, V dy, V inverseLengthSquared, V zero, V one) {
+    auto rx = Ops::sub(px, ax);
+    auto ry = Ops::sub(py, ay);
+    auto t = Ops::mul(Ops::add(Ops::mul(rx, dx), Ops::mul(ry, dy)), inverseLengthSquared);
+    t = Ops::min(Ops::max(t, zero), one);
+    auto ex = Ops::sub(rx, Ops::mul(dx, t));
+    auto ey = Ops::sub(ry, Ops::mul(dy, t));
+    return Ops::add(Ops::mul(ex, ex), Ops::mul(ey, ey));
+}
+
+// Squared distance between segment pairs i .. i + Ops::width - 1
+template <typename Ops>
+void segmentPairDistanceAt(const typename Ops::T* ax0, const typename Ops::T* ay0,
+                           const typename Ops::T* ax1, const typename Ops::T* ay1,
+                           const typename Ops::T* bx0, const typename Ops::T* by0,
+                           const typename Ops::T* bx1, const typename Ops::T* by1,
+                           size_t i, typename Ops::T* out) {
+    using T = typename Ops::T;
+    auto zero = Ops::set1(T(0));
+    auto one = Ops::set1(T(1));
+    auto p0x = Ops::load(ax0 + i);
+    auto p0y = Ops::load(ay0 + i);
+    auto p1x = Ops::load(ax1 + i);
+    auto p1y = Ops::load(ay1 + i);
+    auto q0x = Ops::load(bx0 + i);
+    auto q0y = Ops::load(by0 + i);
+    auto q1x = Ops::load(bx1 + i);
+    auto q1y = Ops::load(by1 + i);
+    auto d1x = Ops::sub(p1x, p0x);
+    auto d1y = Ops::sub(p1y, p0y);
+    auto d2x = Ops::sub(q1x, q0x);
+    auto d2y = Ops::sub(q1y, q0y);
+    
+    // Closest pair through an endpoint (degenerate segments act as points)
+    auto length1 = Ops::add(Ops::mul(d1x, d1x), Ops::mul(d1y, d1y));
+    auto length2 = Ops::add(Ops::mul(d2x, d2x), Ops::mul(d2y, d2y));
+    auto inverse1 = Ops::select(Ops::lessMask(zero, length1), Ops::div(one, length1), zero);
+    auto inverse2 = Ops::select(Ops::lessMask(zero, length2), Ops::div(one, length2), zero);
+    auto distance = Ops::min(
+        Ops::min(pointToSegmentSquared<Ops>(p0x, p0y, q0x, q0y, d2x, d2y, inverse2, zero, one),
+                 pointToSegmentSquared<Ops>(p1x, p1y, q0x, q0y, d2x, d2y, inverse2, zero, one)),
+        Ops::min(pointToSegmentSquared<Ops>(q0x, q0y, p0x, p0y, d1x, d1y, inverse1, zero, one),
+                 pointToSegmentSquared<Ops>(q1x, q1y, p0x, p0y, d1x, d1y, inverse1, zero, one)));
+    
+    // Proper crossing: each segment's endpoints strictly on opposite sides of the other
+    auto side1 = Ops::sub(Ops::mul(d1x, Ops::sub(q0y, p0y)), Ops::mul(d1y, Ops::sub(q0x, p0x)));
+    auto side2 = Ops::sub(Ops::mul(d1x, Ops::sub(q1y, p0y)), Ops::mul(d1y, Ops::sub(q1x, p0x)));
+    auto side3 = Ops::sub(Ops::mul(d2x, Ops::sub(p0y, q0y)), Ops::mul(d2y, Ops::sub(p0x, q0x)));
+    auto side4 = Ops::sub(Ops::mul(d2x, Ops::sub(p1y, q0y)), Ops::mul(d2y, Ops::sub(p1x, q0x)));
+    auto crossing = Ops::select(Ops::lessMask(Ops::mul(side3, side4), zero), zero, distance);
+    Ops::store(out + i, Ops::select(Ops::lessMask(Ops::mul(side1, side2), zero), crossing, distance));
+}
+
+template <typename Ops>
+void segmentPairDistance(const typename Ops::T* ax0, const typename Ops::T* ay0,
+                         const typename Ops::T* ax1, const typename Ops::T* ay1,
+                         const typename Ops::T* bx0, const typename Ops::T* by0,
+                         const typename Ops::T* bx1, const typename Ops::T* by1,
+                         size_t count, typename Ops::T* out) {
+    size_t i = 0;
+    for (; i + Ops::width <= count; i += Ops::width) {
+        segmentPairDistanceAt<Ops>(ax0, ay0, ax1, ay1, bx0, by0, bx1, by1, i, out);
+    }
+    for (; i < count; i++) {
+        segmentPairDistanceAt<ScalarOps<typename Ops::T>>(ax0, ay0, ax1, ay1, bx0, by0, bx1, by1, i, out);
+    }
+}
+
+// Round to the nearest integer with the magic-number trick (no int conversion)
+template <typename Ops, typename V>
+V roundNearest(V v, V magic) {
+    return Ops::sub(Ops::add(v, magic), magic);
+}
+
+template <typename Ops>
+void sinCos(const typename Ops::T* angles, size_t count, typename Ops::T* sines, typename Ops::T* cosines) {
+    using T = typename Ops::T;
+    using C = TrigCoefficients<T>;
+    auto magic = Ops::set1(C::roundingMagic);
+    auto twoOverPi = Ops::set1(C::twoOverPi);
+    auto half = Ops::set1(T(0.5));
+    auto quarter = Ops::set1(T(0.25));
+    auto two = Ops::set1(T(2));
+    auto one = Ops::set1(T(1));
+    auto zero = Ops::set1(T(0));
+    
+    size_t i = 0;
+    for (; i + Ops::width <= count; i += Ops::width) {
+        auto angle = Ops::load(angles + i);
+        auto q = roundNearest<Ops>(Ops::mul(angle, twoOverPi), magic);
+        auto r = Ops::sub(angle, Ops::mul(q, Ops::set1(C::piOverTwo1)));
+        r = Ops::sub(r, Ops::mul(q, Ops::set1(C::piOverTwo2)));
+        r = Ops::sub(r, Ops::mul(q, Ops::set1(C::piOverTwo3)));
+        auto r2 = Ops::mul(r, r);
+        
+        auto sinPoly = Ops::set1(C::sinCoefficients[C::sinTerms - 1]);
+        for (int k = C::sinTerms - 2; k >= 0; k--) {
+            sinPoly = Ops::add(Ops::mul(sinPoly, r2), Ops::set1(C::sinCoefficients[k]));
+        }
+        auto cosPoly = Ops::set1(C::cosCoefficients[C::cosTerms - 1]);
+        for (int k = C::cosTerms - 2; k >= 0; k--) {
+            cosPoly = Ops::add(Ops::mul(cosPoly, r2), Ops::set1(C::cosCoefficients[k]));
+        }
+        auto s = Ops::add(r, Ops::mul(Ops::mul(r, r2), sinPoly));
+        auto c = Ops::add(Ops::sub(one, Ops::mul(half, r2)), Ops::mul(Ops::mul(r2, r2), cosPoly));
+        
+        // Quadrant q mod 4 from parities: q = 2h + odd, sin negates when h is odd,
+        // cos negates when floor((q + 1) / 2) is odd
+        auto h = roundNearest<Ops>(Ops::sub(Ops::mul(q, half), quarter), magic);
+        auto odd = Ops::sub(q, Ops::mul(two, h));
+        auto hOdd = Ops::sub(h, Ops::mul(two, roundNearest<Ops>(Ops::sub(Ops::mul(h, half), quarter), magic)));
+        auto g = roundNearest<Ops>(Ops::add(Ops::mul(q, half), quarter), magic);
+        auto gOdd = Ops::sub(g, Ops::mul(two, roundNearest<Ops>(Ops::sub(Ops::mul(g, half), quarter), magic)));
+        
+        auto swap = Ops::lessMask(half, odd);
+        auto baseSin = Ops::select(swap, c, s);
+        auto baseCos = Ops::select(swap, s, c);
+        Ops::store(sines + i, Ops::select(Ops::lessMask(half, hOdd), Ops::sub(zero, baseSin), baseSin));
+        Ops::store(cosines + i, Ops::select(Ops::lessMask(half, gOdd), Ops::sub(zero, baseCos), baseCos));
+    }
+    for (; i < count; i++) {
+        SinCos<T> sc = polySinCos(angles[i]);
+        sines[i] = sc.sin;
+        cosines[i] = sc.cos;
+    }
+}
+
+template <typename Ops>
+void clampAngles(typename Ops::T* angles, const typename Ops::T* centers, const typename Ops::T* halfWidths,
+                 size_t count) {
+    using T = typename Ops::T;
+    auto magic = Ops::set1(TrigCoefficients<T>::roundingMagic);
+    auto twoPi = Ops::set1(T(2 * M_PI));
+    auto inverseTwoPi = Ops::set1(T(1 / (2 * M_PI)));
+    auto zero = Ops::set1(T(0));
+    size_t i = 0;
+    for (; i + Ops::width <= count; i += Ops::width) {
+        auto center = Ops::load(centers + i);
+        auto halfWidth = Ops::load(halfWidths + i);
+        auto offset = Ops::sub(Ops::load(angles + i), center);
+        offset = Ops::sub(offset, Ops::mul(twoPi, roundNearest<Ops>(Ops::mul(offset, inverseTwoPi), magic)));
+        offset = Ops::min(Ops::max(offset, Ops::sub(zero, halfWidth)), halfWidth);
+        Ops::store(angles + i, Ops::add(center, offset));
+    }
+    for (; i < count; i++) {
+        BasicJointLimits<T> limits{centers[i], halfWidths[i]};
+        angles[i] = limits.clamp(angles[i]);
+    }
+}
+
+} // namespace POINT_KERNELS_NAMESPACE
@@ -0,0 +1,80 @@
+/**
+ * @file ProjectileArray.cpp
+ * @brief Implementation of the ProjectileArray class
+ */
+#include "../include/ProjectileArray.h"
+
+ProjectileArray::ProjectileArray(std::pmr::memory_resource* resource)
+    : table(resource) {
+}
+
+ProjectileHandle ProjectileArray::create(const ProjectileState& state) {
+    return table.create(Transform{state.position}, ProjectilePhysics{state.velocity},
+                        ProjectileShape{state.radius, state.groundLevel}, ProjectileLinks{state.target, state.thrower},
+                        state.status);
+}
+
+bool ProjectileArray::destroy(ProjectileHandle handle) {
+    return table.destroy(handle);
+}
+
+bool ProjectileArray::contains(ProjectileHandle handle) const {
+    return table.contains(handle);
+}
+
+std::optional<ProjectileState> ProjectileArray::get(ProjectileHandle handle) const {
+    if (!contains(handle)) {
+        return std::nullopt;
+    }
+    size_t i = table.getIndex(handle);
+    const ProjectileShape& shape = table.get<ProjectileShape>(i);
+    const ProjectileLinks& links = table.get<ProjectileLinks>(i);
+    return ProjectileState{table.get<Transform>(i).position, table.get<ProjectilePhysics>(i).velocity,
+                           shape.radius, shape.groundLevel, links.target, links.thrower, table.get<ProjectileStatus>(i)};
+}
+
+size_t ProjectileArray::getIndex(ProjectileHandle handle) const {
+    return table.getIndex(handle);
+}
+
+size_t ProjectileArray::size() const {
+    return table.size();
+}
+
+void ProjectileArray::integrate(Real timeStep, Real gravity) {
+    integrate(timeStep, gravity, 0, table.getChunkCount());
+}
+
+void ProjectileArray::integrate(Real timeStep, Real gravity, size_t firstChunk, size_t lastChunk) {
+    // Branch-free over each chunk's arrays so the loop vectorizes
+    table.forEachChunk<Transform, ProjectilePhysics, ProjectileStatus>(
+        firstChunk, lastChunk,
+        [&](size_t count, Transform* transforms, ProjectilePhysics* physics, const ProjectileStatus* status) {
+            for (size_t i = 0; i < count; i++) {
+                Real dt = (status[i] == ProjectileStatus::FLYING) ? timeStep : Real(0);
+                transforms[i].position.x += physics[i].velocity.x * dt;
+                transforms[i].position.y += physics[i].velocity.y * dt;
+                physics[i].velocity.y += gravity * dt;
+            }
+        });
+}
+
+void ProjectileArray::advance(Real timeStep, Real gravity, uint64_t ticks) {
+    // k ticks of integrate(): x += vx k dt, y += vy k dt + g dt^2 k (k - 1) / 2, vy += g k dt
+    Real k = static_cast<Real>(ticks);
+    Real span = k * timeStep;
+    Real fall = gravity * timeStep * timeStep * k * (k - 1) / 2;
+    table.forEachChunk<Transform, ProjectilePhysics, ProjectileStatus>(
+        [&](size_t count, Transform* transforms, ProjectilePhysics* physics, const ProjectileStatus* status) {
+            for (size_t i = 0; i < count; i++) {
+                Real flying = (status[i] == ProjectileStatus::FLYING) ? Real(1) : Real(0);
+                transforms[i].position.x += physics[i].velocity.x * span * flying;
+                transforms[i].position.y += (physics[i].velocity.y * span + fall) * flying;
+                physics[i].velocity.y += gravity * span * flying;
+            }
+        });
+}
+
+ProjectileHandle ProjectileArray::getHandleAt(size_t index) const {
+    return table.handleAt(index);
+}
@@ -0,0 +1,79 @@
+/**
+ * @file ScenarioArena.cpp
+ * @brief Implementation of the ScenarioArena and CountingResource classes
+ */
+#include "../include/ScenarioArena.h"
+
+CountingResource::CountingResource(std::pmr::memory_resource* upstream)
+    : upstream(upstream), allocations(0), bytes(0), deallocations(0) {
+}
+
+size_t CountingResource::getAllocationCount() const {
+    return allocations;
+}
+
+size_t CountingResource::getAllocatedBytes() const {
+    return bytes;
+}
+
+size_t CountingResource::getDeallocationCount() const {
+    return deallocations;
+}
+
+void CountingResource::resetCounts() {
+    allocations = 0;
+    bytes = 0;
+    deallocations = 0;
+}
+
+void* CountingResource::do_allocate(size_t size, size_t alignment) {
+    allocations++;
+    bytes += size;
+    return upstream->allocate(size, alignment);
+}
+
+void CountingResource::do_deallocate(void* p, size_t size, size_t alignment) {
+    deallocations++;
+    upstream->deallocate(p, size, alignment);
+}
+
+bool CountingResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+ScenarioArena::ScenarioArena(size_t initialBytes)
+    : capacity(0), upstream(std::pmr::new_delete_resource()) {
+    resetBuffer(initialBytes);
+}
+
+std::pmr::memory_resource* ScenarioArena::getResource() {
+    return &*arena;
+}
+
+void ScenarioArena::release() {
+    if (upstream.getAllocationCount() == 0) {
+        // Everything fit in the buffer: just rewind it
+        monotonic->release();
+    } else {
+        // Grow once to the peak so the next scenario fits
+        resetBuffer(capacity + upstream.getAllocatedBytes());
+    }
+    arena->resetCounts();
+    upstream.resetCounts();
+}
+
+ScenarioArena::Report ScenarioArena::getReport() const {
+    return {arena->getAllocationCount(), arena->getAllocatedBytes(),
+            upstream.getAllocationCount(), upstream.getAllocatedBytes(), capacity};
+}
+
+void ScenarioArena::resetBuffer(size_t bytes) {
+    arena.reset();
+    monotonic.reset();
+    if (bytes != capacity) {
+        buffer = std::make_unique<std::byte[]>(bytes);
+        capacity = bytes;
+    }
+    monotonic.emplace(buffer.get(), capacity, &upstream);
+    arena.emplace(&*monotonic);
+}
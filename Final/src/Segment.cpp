@@ -3,91 +3,143 @@
  * @brief Implementation of the Segment class
  */
 #include "../include/Segment.h"
+#include "../include/Dual.h"
 #include <cmath>
 #include <algorithm>
 
-Segment::Segment(const std::string& id, const Vector2D& start, double length, double angle,
-                 double minAngle, double maxAngle)
-    : id(id),
+template <typename Scalar>
+BasicSegment<Scalar>::BasicSegment(std::string_view id, const Vec& start, Scalar length, Scalar angle,
+                                   Scalar minAngle, Scalar maxAngle, std::pmr::memory_resource* resource)
+    : id(id, resource),
       start(start),
-      length(std::max(0.1, length)),  // Ensure a minimum length
-      angle(clampAngle(angle)),
-      minAngle(minAngle),
-      maxAngle(maxAngle) {
+      length(std::max(Scalar(0.1), length)),  // Ensure a minimum length
+      limits(Limits::fromRange(minAngle, maxAngle)),
+      orientation(clampAngle(angle)) {
 }
 
-std::string Segment::getId() const {
+template <typename Scalar>
+template <typename OtherScalar>
+BasicSegment<Scalar>::BasicSegment(const BasicSegment<OtherScalar>& other)
+    : id(other.id),
+      start(other.start),
+      length(static_cast<Scalar>(other.length)),
+      limits{static_cast<Scalar>(other.limits.center), static_cast<Scalar>(other.limits.halfWidth)},
+      orientation(static_cast<Scalar>(other.getAngle())) {
+}
+
+template <typename Scalar>
+std::string_view BasicSegment<Scalar>::getId() const {
     return id;
 }
 
-Vector2D Segment::getStart() const {
+template <typename Scalar>
+BasicVector2D<Scalar> BasicSegment<Scalar>::getStart() const {
     return start;
 }
 
-Vector2D Segment::getEnd() const {
-    // Calculate end point based on start, length, and angle
-    return Vector2D(
-        start.x + length * std::cos(angle),
-        start.y + length * std::sin(angle)
+template <typename Scalar>
+BasicVector2D<Scalar> BasicSegment<Scalar>::getEnd() const {
+    // Calculate end point based on start, length, and the cached cos/sin of the angle
+    return Vec(
+        start.x + length * orientation.getCos(),
+        start.y + length * orientation.getSin()
     );
 }
 
-double Segment::getLength() const {
+template <typename Scalar>
+Scalar BasicSegment<Scalar>::getLength() const {
     return length;
 }
 
-double Segment::getAngle() const {
-    return angle;
+template <typename Scalar>
+Scalar BasicSegment<Scalar>::getAngle() const {
+    return orientation.getAngle();
+}
+
+template <typename Scalar>
+Scalar BasicSegment<Scalar>::getMinAngle() const {
+    return limits.getMin();
 }
 
-double Segment::getMinAngle() const {
-    return minAngle;
+template <typename Scalar>
+Scalar BasicSegment<Scalar>::getMaxAngle() const {
+    return limits.getMax();
 }
 
-double Segment::getMaxAngle() const {
-    return maxAngle;
+template <typename Scalar>
+const BasicJointLimits<Scalar>& BasicSegment<Scalar>::getLimits() const {
+    return limits;
 }
 
-void Segment::setStart(const Vector2D& newStart) {
+template <typename Scalar>
+void BasicSegment<Scalar>::setStart(const Vec& newStart) {
     start = newStart;
 }
 
-void Segment::setAngle(double newAngle) {
-    angle = clampAngle(newAngle);
+template <typename Scalar>
+void BasicSegment<Scalar>::setAngle(Scalar newAngle) {
+    orientation = Rotation(clampAngle(newAngle));
 }
 
-void Segment::setAngleLimits(double newMin, double newMax) {
-    // Ensure min is less than max
-    if (newMin <= newMax) {
-        minAngle = newMin;
-        maxAngle = newMax;
-        // Re-clamp current angle to ensure it's within new limits
-        angle = clampAngle(angle);
-    }
+template <typename Scalar>
+void BasicSegment<Scalar>::setRawAngle(Scalar newAngle) {
+    orientation = Rotation(newAngle);
+}
+
+template <typename Scalar>
+void BasicSegment<Scalar>::setAngleLimits(Scalar newMin, Scalar newMax) {
+    // min > max is an arc through 0, as in the constructor
+    limits = Limits::fromRange(newMin, newMax);
+    // Re-clamp current angle to ensure it's within new limits
+    orientation = Rotation(clampAngle(getAngle()));
 }
 
-bool Segment::rotate(double deltaAngle) {
-    double targetAngle = angle + deltaAngle;
+template <typename Scalar>
+bool BasicSegment<Scalar>::rotate(Scalar deltaAngle) {
+    Scalar targetAngle = getAngle() + deltaAngle;
     return rotateTo(targetAngle);
 }
 
-bool Segment::rotateTo(double targetAngle) {
-    double clampedAngle = clampAngle(targetAngle);
+template <typename Scalar>
+bool BasicSegment<Scalar>::rotate(const Rotation& delta) {
+    using std::abs;
+    Scalar targetAngle = getAngle() + delta.getAngle();
+    
+    if (limits.contains(targetAngle)) {
+        if (abs(targetAngle - limits.center) <= Scalar(M_PI)) {
+            orientation = (orientation * delta).normalized();
+        } else {
+            // Went round a whole turn: back into the limits' convention
+            orientation = Rotation(limits.wrap(targetAngle));
+        }
+        return true;
+    }
+    
+    // Limited: start again from the clamped angle
+    orientation = Rotation(clampAngle(targetAngle));
+    return false;
+}
+
+template <typename Scalar>
+bool BasicSegment<Scalar>::rotateTo(Scalar targetAngle) {
+    Scalar clampedAngle = clampAngle(targetAngle);
     
-    // Check if we had to clamp the angle
-    bool wasConstrained = (clampedAngle != targetAngle);
+    // Check if we had to clamp the angle (wrapping by full turns does not count)
+    bool wasConstrained = (clampedAngle != limits.wrap(targetAngle));
     
     // Set the new angle
-    angle = clampedAngle;
+    orientation = Rotation(clampedAngle);
     
     return !wasConstrained; // Return true if we didn't have to constrain
 }
 
-void Segment::move(const Vector2D& displacement) {
+template <typename Scalar>
+void BasicSegment<Scalar>::move(const Vec& displacement) {
     start += displacement;
 }
 
-void Segment::connectTo(std::shared_ptr<Segment> parentSegment) {
+template <typename Scalar>
+void BasicSegment<Scalar>::connectTo(std::shared_ptr<BasicSegment> parentSegment) {
     parent = parentSegment;
     
     if (auto sharedParent = parent.lock()) {
@@ -96,72 +148,103 @@ void Segment::connectTo(std::shared_ptr<Segment> parentSegment) {
     }
 }
 
-void Segment::updateConnectedSegments() {
+template <typename Scalar>
+void BasicSegment<Scalar>::updateConnectedSegments() {
     // If we have a parent, update our start position
     if (auto sharedParent = parent.lock()) {
         start = sharedParent->getEnd();
     }
 }
 
-bool Segment::containsPoint(const Vector2D& point, double threshold) const {
+template <typename Scalar>
+bool BasicSegment<Scalar>::containsPoint(const Vec& point, Scalar threshold) const {
     return distanceToPoint(point) <= threshold;
 }
 
-Vector2D Segment::closestPointTo(const Vector2D& point) const {
-    Vector2D segmentStart = start;
-    Vector2D segmentEnd = getEnd();
-    Vector2D segmentVec = segmentEnd - segmentStart;
-    Vector2D pointVec = point - segmentStart;
+template <typename Scalar>
+BasicVector2D<Scalar> BasicSegment<Scalar>::closestPointTo(const Vec& point) const {
+    Vec segmentStart = start;
+    Vec segmentEnd = getEnd();
+    Vec segmentVec = segmentEnd - segmentStart;
+    Vec pointVec = point - segmentStart;
     
     // Calculate projection of point onto segment
-    double projection = pointVec.dot(segmentVec) / segmentVec.lengthSquared();
+    Scalar projection = pointVec.dot(segmentVec) / segmentVec.lengthSquared();
     
     // Clamp to segment
-    projection = std::max(0.0, std::min(1.0, projection));
+    projection = std::max(Scalar(0.0), std::min(Scalar(1.0), projection));
     
     // Calculate the closest point
     return segmentStart + segmentVec * projection;
 }
 
-double Segment::distanceToPoint(const Vector2D& point) const {
-    Vector2D closestPoint = closestPointTo(point);
+template <typename Scalar>
+Scalar BasicSegment<Scalar>::distanceToPoint(const Vec& point) const {
+    Vec closestPoint = closestPointTo(point);
     return point.distance(closestPoint);
 }
 
-bool Segment::isStartContactingGround(double groundLevel, double threshold) const {
+template <typename Scalar>
+Scalar BasicSegment<Scalar>::distanceSquaredToSegment(const BasicSegment& other) const {
+    Vec p0 = start;
+    Vec p1 = getEnd();
+    Vec q0 = other.start;
+    Vec q1 = other.getEnd();
+    
+    // Proper crossing: each segment's endpoints lie strictly on opposite sides of the other
+    Vec d1 = p1 - p0;
+    Vec d2 = q1 - q0;
+    if (d1.cross(q0 - p0) * d1.cross(q1 - p0) < Scalar(0) &&
+        d2.cross(p0 - q0) * d2.cross(p1 - q0) < Scalar(0)) {
+        return Scalar(0);
+    }
+    
+    // Otherwise the closest pair involves an endpoint (also covers touching and collinear segments)
+    auto pointToSegment = [](const Vec& point, const Vec& a, const Vec& direction) {
+        Scalar lengthSquared = direction.lengthSquared();
+        Scalar t = lengthSquared > Scalar(0) ? (point - a).dot(direction) / lengthSquared : Scalar(0);
+        t = std::max(Scalar(0), std::min(Scalar(1), t));
+        return (point - (a + direction * t)).lengthSquared();
+    };
+    return std::min(std::min(pointToSegment(p0, q0, d2), pointToSegment(p1, q0, d2)),
+                    std::min(pointToSegment(q0, p0, d1), pointToSegment(q1, p0, d1)));
+}
+
+template <typename Scalar>
+bool BasicSegment<Scalar>::isStartContactingGround(Scalar groundLevel, Scalar threshold) const {
     // Check if the start point is close to the ground level
-    return std::abs(start.y - groundLevel) <= threshold;
+    using std::abs;
+    return abs(start.y - groundLevel) <= threshold;
 }
 
-bool Segment::isEndContactingGround(double groundLevel, double threshold) const {
+template <typename Scalar>
+bool BasicSegment<Scalar>::isEndContactingGround(Scalar groundLevel, Scalar threshold) const {
     // Check if the end point is close to the ground level
-    Vector2D end = getEnd();
-    return std::abs(end.y - groundLevel) <= threshold;
+    using std::abs;
+    Vec end = getEnd();
+    return abs(end.y - groundLevel) <= threshold;
 }
 
-double Segment::clampAngle(double angleToClamp) const {
-    // First, normalize angle to be within [0, 2π)
-    double normalizedAngle = std::fmod(angleToClamp, 2 * M_PI);
-    if (normalizedAngle < 0) {
-        normalizedAngle += 2 * M_PI;
-    }
-    
-    // Check if the angle is within the allowed range
-    if (minAngle <= maxAngle) {
-        // Simple case: range doesn't cross 0
-        return std::min(std::max(normalizedAngle, minAngle), maxAngle);
-    } else {
-        // Complex case: range crosses 0 (e.g., min=270°, max=90°)
-        if (normalizedAngle >= minAngle || normalizedAngle <= maxAngle) {
-            return normalizedAngle;  // Already in range
-        } else {
-            // Find the closest bound
-            double distToMin = std::min(std::abs(normalizedAngle - minAngle), 
-                                       std::abs(normalizedAngle - (minAngle - 2 * M_PI)));
-            double distToMax = std::min(std::abs(normalizedAngle - maxAngle),
-                                       std::abs(normalizedAngle - (maxAngle + 2 * M_PI)));
-            
-            return (distToMin <= distToMax) ? minAngle : maxAngle;
-        }
-    }
-}
\ No newline at end of file
+template <typename Scalar>
+Scalar BasicSegment<Scalar>::clampAngle(Scalar angleToClamp) const {
+    return limits.clamp(angleToClamp);
+}
+
+template <typename Scalar>
+bool BasicSegment<Scalar>::isStartContactingGround(const BasicTerrain<Scalar>& terrain, Scalar threshold) const {
+    return terrain.isTouching(start, threshold);
+}
+
+template <typename Scalar>
+bool BasicSegment<Scalar>::isEndContactingGround(const BasicTerrain<Scalar>& terrain, Scalar threshold) const {
+    return terrain.isTouching(getEnd(), threshold);
+}
+
+// Explicit instantiations for the supported scalar types
+template class BasicSegment<float>;
+template class BasicSegment<double>;
+template class BasicSegment<KinematicDual>;
+template BasicSegment<float>::BasicSegment(const BasicSegment<double>& other);
+template BasicSegment<double>::BasicSegment(const BasicSegment<float>& other);
+template BasicSegment<KinematicDual>::BasicSegment(const BasicSegment<float>& other);
+template BasicSegment<KinematicDual>::BasicSegment(const BasicSegment<double>& other);
\ No newline at end of file
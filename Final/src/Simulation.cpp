@@ -3,12 +3,15 @@
  * @brief Implementation of the Simulation class
  */
 #include "../include/Simulation.h"
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <sstream>
 
 Simulation::Simulation() 
-    : currentMode(Mode::WALKER), 
+    : commands(kCommandCapacity),
+      maxCommandLatency(0),
+      currentMode(Mode::WALKER), 
       simulationComplete(false),
       groundLevel(400.0),
       windowSize(800.0f, 600.0f) {
@@ -24,7 +27,8 @@ void Simulation::initialize(const std::string& configFile) {
     logger->logMessage("Simulation initialized");
     
     // Create target object
-    target = std::make_shared<Circle>(Vector2D(500.0, 350.0), 20.0);
+    // At shoulder height, where both hands can close on it
+    target = world.createCircle(Vector2D(500.0, groundLevel - Body::kStandingHeight - 60.0), 20.0);
     
     // Create body using the Builder pattern
     body = createBody();
@@ -51,6 +55,12 @@ void Simulation::setMode(Mode mode) {
 }
 
 void Simulation::update(float deltaTime) {
+    // Input lands at the tick boundary, before the frame's move
+    processCommands();
+    advance(deltaTime);
+}
+
+void Simulation::advance(float deltaTime) {
     if (simulationComplete) return;
     
     // Update the current strategy
@@ -84,17 +94,21 @@ void Simulation::draw(sf::RenderWindow& window) {
     window.draw(ground);
     
     // Draw target
-    sf::CircleShape targetShape(target->getRadius());
+    sf::CircleShape targetShape(getTarget()->getRadius());
     targetShape.setFillColor(sf::Color(200, 50, 50));
     targetShape.setPosition(
-        target->getCenter().x - target->getRadius(),
-        target->getCenter().y - target->getRadius()
+        getTarget()->getCenter().x - getTarget()->getRadius(),
+        getTarget()->getCenter().y - getTarget()->getRadius()
     );
     window.draw(targetShape);
     
     // Draw body segments
-    const auto& lines = body->getSegmentLines();
-    for (const auto& line : lines) {
+    if (segmentLines.size() < getBody()->getSegmentCount()) {
+        segmentLines.resize(getBody()->getSegmentCount());
+    }
+    size_t lineCount = getBody()->getSegmentLines(segmentLines);
+    for (size_t i = 0; i < lineCount; i++) {
+        const auto& line = segmentLines[i];
         sf::Vertex sfLine[] = {
             sf::Vertex(sf::Vector2f(line.first.x, line.first.y), sf::Color(50, 50, 200)),
             sf::Vertex(sf::Vector2f(line.second.x, line.second.y), sf::Color(50, 50, 200))
@@ -153,22 +167,22 @@ void Simulation::handleInput(const sf::Event& event) {
         switch (event.key.code) {
             case sf::Keyboard::W:
                 // Switch to Walker mode
-                setMode(Mode::WALKER);
+                submitCommand(makeCommand(CommandType::WALKER_MODE));
                 break;
                 
             case sf::Keyboard::S:
                 // Switch to Snowball mode
-                setMode(Mode::SNOWBALL);
+                submitCommand(makeCommand(CommandType::SNOWBALL_MODE));
                 break;
                 
             case sf::Keyboard::Space:
                 // Execute next step
-                update(0.1f);
+                submitCommand(makeCommand(CommandType::STEP, 0.1f));
                 break;
                 
             case sf::Keyboard::R:
                 // Reset the current mode
-                setMode(currentMode);
+                submitCommand(makeCommand(CommandType::RESET));
                 break;
                 
             default:
@@ -177,32 +191,71 @@ void Simulation::handleInput(const sf::Event& event) {
     }
 }
 
+bool Simulation::submitCommand(const SimulationCommand& command) {
+    // A full queue drops the key press; the count shows it
+    return commands.tryPush(command);
+}
+
+size_t Simulation::processCommands() {
+    // Commands pushed while these run wait for the next tick, so one tick
+    // applies at most a queue's worth
+    return commands.drain([this](const SimulationCommand& command) {
+        applyCommand(command);
+    }, commands.getCapacity());
+}
+
+void Simulation::applyCommand(const SimulationCommand& command) {
+    maxCommandLatency = std::max(maxCommandLatency, getCommandClock() - command.issuedAt);
+    switch (command.type) {
+        case CommandType::WALKER_MODE:
+            setMode(Mode::WALKER);
+            break;
+        case CommandType::SNOWBALL_MODE:
+            setMode(Mode::SNOWBALL);
+            break;
+        case CommandType::STEP:
+            advance(command.deltaTime);
+            break;
+        case CommandType::RESET:
+            setMode(currentMode);
+            break;
+    }
+}
+
 bool Simulation::isComplete() const {
     return simulationComplete;
 }
 
+size_t Simulation::getDroppedCommandCount() const {
+    return commands.getDroppedCount();
+}
+
+int64_t Simulation::getMaxCommandLatency() const {
+    return maxCommandLatency;
+}
+
 void Simulation::initializeWalkerMode() {
     // Create a WalkerStrategy
-    auto walkerStrategy = std::make_unique<WalkerStrategy>(body, target);
+    auto walkerStrategy = std::make_unique<WalkerStrategy>(world, body, target);
     walkerStrategy->enableLogging(logger);
-    walkerStrategy->planSequence(target->getCenter());
+    walkerStrategy->planSequence(getTarget()->getCenter());
     currentStrategy = std::move(walkerStrategy);
 }
 
 void Simulation::initializeSnowballMode() {
     // Create a SnowballStrategy
-    auto snowballStrategy = std::make_unique<SnowballStrategy>(body, target);
+    auto snowballStrategy = std::make_unique<SnowballStrategy>(world, body, target);
     snowballStrategy->enableLogging(logger);
     snowballStrategy->planSequence();
     currentStrategy = std::move(snowballStrategy);
 }
 
-std::shared_ptr<Body> Simulation::createBody() {
+BodyHandle Simulation::createBody() {
     // Use the BodyBuilder to create a body with a humanoid structure
     BodyBuilder builder;
-    builder.setBasePosition(Vector2D(100.0, 400.0))
+    builder.setBasePosition(Vector2D(100.0, groundLevel - Body::kStandingHeight))
            .setGroundLevel(groundLevel)
            .buildHumanoidBody();
     
-    return builder.build();
+    return builder.build(world);
 }
\ No newline at end of file
@@ -0,0 +1,53 @@
+/**
+ * @file SimulationCommand.cpp
+ * @brief Implementation of the simulation command helpers
+ */
+#include "../include/SimulationCommand.h"
+#include <chrono>
+#include <iostream>
+
+SimulationCommand makeCommand(CommandType type, float deltaTime) {
+    return SimulationCommand{type, deltaTime, getCommandClock()};
+}
+
+int64_t getCommandClock() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool parseCommand(char key, SimulationCommand& command, float stepTime) {
+    switch (key) {
+        case 's':
+            command = makeCommand(CommandType::STEP, stepTime);
+            return true;
+        case 'w':
+            command = makeCommand(CommandType::WALKER_MODE);
+            return true;
+        case 'b':
+            command = makeCommand(CommandType::SNOWBALL_MODE);
+            return true;
+        case 'r':
+            command = makeCommand(CommandType::RESET);
+            return true;
+        default:
+            return false;
+    }
+}
+
+size_t submitScript(std::istream& script, SimulationCommandQueue& queue, float stepTime) {
+    size_t pushed = 0;
+    char key;
+    while (script >> key) {
+        SimulationCommand command;
+        if (!parseCommand(key, command, stepTime)) {
+            std::cerr << "Unknown command in script: " << key << std::endl;
+            continue;
+        }
+        if (!queue.tryPush(command)) {
+            std::cerr << "Command queue full; dropped script command " << key << std::endl;
+            continue;
+        }
+        pushed++;
+    }
+    return pushed;
+}
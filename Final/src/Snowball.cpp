@@ -6,21 +6,22 @@
 #include <cmath>
 #include <iostream>
 
-Snowball::Snowball(double radius, double gravityValue)
+Snowball::Snowball(World& world, double radius, double gravityValue)
     : snowball(Vector2D(0, 0), radius),
       gravity(gravityValue),
       active(false),
       hitTarget(false),
       hitGround(false),
-      groundLevel(400) {  // Default ground level, can be updated by Body
+      world(&world),
+      terrain(400) {  // Default ground level, can be updated by Body
 }
 
-void Snowball::setThrower(const std::shared_ptr<Body>& body) {
+void Snowball::setThrower(BodyHandle body) {
     thrower = body;
     
-    // Update ground level from thrower
-    if (auto sharedThrower = thrower.lock()) {
-        groundLevel = sharedThrower->getGroundLevel();
+    // Update the ground from the thrower
+    if (const Body* throwingBody = world->getBody(thrower)) {
+        terrain = throwingBody->getTerrain();
     }
 }
 
@@ -64,10 +65,14 @@ void Snowball::update(double timeStep) {
     }
     
     // Update snowball position based on physics
+    Vector2D previous = snowball.getCenter();
     snowball.updatePosition(timeStep);
     
-    // Check for collisions with ground
-    if (snowball.isOnGround(groundLevel)) {
+    // Check for collisions with ground along the whole step (the lowest point
+    // of the ball), so a fast ball cannot pass through a ridge between updates
+    Vector2D bottom(0, snowball.getRadius());
+    Real impact;
+    if (terrain.intersectSegment(previous + bottom, snowball.getCenter() + bottom, impact)) {
         hitGround = true;
         active = false;
         
@@ -113,7 +118,7 @@ double Snowball::getRadius() const {
     return snowball.getRadius();
 }
 
-void Snowball::setTarget(const std::shared_ptr<Circle>& newTarget) {
+void Snowball::setTarget(CircleHandle newTarget) {
     target = newTarget;
 }
 
@@ -122,15 +127,15 @@ bool Snowball::checkTargetHit() {
         return false;
     }
     
-    if (auto sharedTarget = target.lock()) {
-        if (snowball.intersects(*sharedTarget)) {
+    if (const Circle* targetCircle = world->getCircle(target)) {
+        if (snowball.intersects(*targetCircle)) {
             hitTarget = true;
             active = false;
             
             if (logger) {
-                logger->logSnowballHit(sharedTarget->getCenter(), true);
+                logger->logSnowballHit(targetCircle->getCenter(), true);
                 logger->logMessage("TARGET HIT! Distance to center: " + 
-                                  std::to_string(snowball.distanceToCenter(*sharedTarget)));
+                                  std::to_string(snowball.distanceToCenter(*targetCircle)));
             }
             
             return true;
@@ -0,0 +1,255 @@
+/**
+ * @file SnowballFight.cpp
+ * @brief Implementation of the SnowballFight class
+ */
+#include "../include/SnowballFight.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+namespace {
+constexpr uint32_t kNoFighter = UINT32_MAX;
+}
+
+SnowballFight::Team::Team(std::pmr::memory_resource* resource)
+    : members(resource), positions(resource), tree(resource), score(0) {
+}
+
+SnowballFight::SnowballFight(World& world)
+    : world(&world), fighters(world.getMemoryResource()), fighterOfBody(world.getMemoryResource()),
+      unscheduled(world.getMemoryResource()),
+      moveSpeed(30.0), paceRange(60.0), throwInterval(1.0), snowballRadius(8.0), hitRadius(30.0),
+      hitHeight(60.0), releaseHeight(50.0), throws(0), hits(0), misses(0) {
+    world.enableImpactEvents(moveSpeed);
+}
+
+void SnowballFight::addFighter(BodyHandle body, uint32_t team) {
+    const Body* fighterBody = world->getBody(body);
+    if (!fighterBody) {
+        std::cerr << "Cannot add a fighter: the body no longer exists" << std::endl;
+        return;
+    }
+
+    Vector2D base = fighterBody->getBasePosition();
+    uint32_t index = static_cast<uint32_t>(fighters.size());
+    CircleHandle hitCircle = world->createCircle(Vector2D(base.x, base.y - hitHeight), hitRadius);
+
+    // Alternate directions so a team does not pace in lockstep
+    Real direction = (index % 2 == 0) ? Real(1) : Real(-1);
+    fighters.push_back(Fighter{body, hitCircle, team, base.x, direction * static_cast<Real>(moveSpeed), TimerHandle()});
+    unscheduled.push_back(index);
+
+    while (teams.size() <= team) {
+        teams.emplace_back(world->getMemoryResource());
+    }
+    teams[team].members.push_back(index);
+    if (fighterOfBody.size() <= body.index) {
+        fighterOfBody.resize(body.index + 1, kNoFighter);
+    }
+    fighterOfBody[body.index] = index;
+}
+
+void SnowballFight::step(double timeStep) {
+    Real dt = static_cast<Real>(timeStep);
+    moveFighters(dt);
+    rebuildTeamTrees();
+
+    // First throws staggered so a team does not throw in lockstep either
+    for (uint32_t index : unscheduled) {
+        scheduleThrow(index, throwInterval * (index % 16) / 16.0, timeStep);
+    }
+    unscheduled.clear();
+
+    // Only the fighters whose throw fell due during the last world step
+    for (const ExpiredTimer& due : world->getDueTimers()) {
+        if (due.payload >= fighters.size() || fighters[due.payload].throwTimer != due.timer) {
+            continue;   // Someone else's timer
+        }
+        uint32_t index = static_cast<uint32_t>(due.payload);
+        scheduleThrow(index, throwInterval, timeStep);
+        uint32_t enemy = findNearestEnemy(fighters[index]);
+        if (enemy != kNoFighter) {
+            throwAt(fighters[index], fighters[enemy], dt);
+        }
+    }
+
+    world->step(timeStep);
+    scoreImpacts();
+}
+
+size_t SnowballFight::getFighterCount() const {
+    return fighters.size();
+}
+
+size_t SnowballFight::getTeamCount() const {
+    return teams.size();
+}
+
+size_t SnowballFight::getScore(uint32_t team) const {
+    return team < teams.size() ? teams[team].score : 0;
+}
+
+size_t SnowballFight::getThrows() const {
+    return throws;
+}
+
+size_t SnowballFight::getHits() const {
+    return hits;
+}
+
+size_t SnowballFight::getMisses() const {
+    return misses;
+}
+
+double SnowballFight::getMoveSpeed() const {
+    return moveSpeed;
+}
+
+void SnowballFight::setMoveSpeed(double speed) {
+    moveSpeed = speed;
+    for (Fighter& fighter : fighters) {
+        fighter.velocityX = std::copysign(static_cast<Real>(speed), fighter.velocityX);
+    }
+    world->enableImpactEvents(speed);
+}
+
+double SnowballFight::getThrowInterval() const {
+    return throwInterval;
+}
+
+void SnowballFight::setThrowInterval(double seconds) {
+    throwInterval = seconds;
+}
+
+double SnowballFight::getSnowballRadius() const {
+    return snowballRadius;
+}
+
+void SnowballFight::setSnowballRadius(double radius) {
+    snowballRadius = radius;
+}
+
+double SnowballFight::getHitRadius() const {
+    return hitRadius;
+}
+
+void SnowballFight::setHitRadius(double radius) {
+    hitRadius = radius;
+}
+
+void SnowballFight::moveFighters(Real timeStep) {
+    // Pace back and forth around home; the hit circle moves with the body
+    for (Fighter& fighter : fighters) {
+        Body* body = world->getBody(fighter.body);
+        Circle* hitCircle = world->getCircle(fighter.hitCircle);
+        if (!body || !hitCircle) {
+            continue;
+        }
+        Vector2D base = body->getBasePosition();
+        Real x = base.x + fighter.velocityX * timeStep;
+        if (std::abs(x - fighter.homeX) > paceRange) {
+            fighter.velocityX = -fighter.velocityX;
+            x = std::clamp(x, fighter.homeX - static_cast<Real>(paceRange), fighter.homeX + static_cast<Real>(paceRange));
+        }
+        body->moveBaseTo(Vector2D(x, base.y));
+        hitCircle->setCenter(Vector2D(x, base.y - hitHeight));
+    }
+}
+
+void SnowballFight::rebuildTeamTrees() {
+    for (Team& team : teams) {
+        team.positions.clear();
+        for (uint32_t member : team.members) {
+            const Circle* hitCircle = world->getCircle(fighters[member].hitCircle);
+            team.positions.push_back(hitCircle ? hitCircle->getCenter() : Vector2D());
+        }
+        team.tree.build(team.positions);
+
+        // Fighters whose body or circle is gone cannot be aimed at
+        for (size_t i = 0; i < team.members.size(); i++) {
+            const Fighter& fighter = fighters[team.members[i]];
+            if (!world->getBody(fighter.body) || !world->getCircle(fighter.hitCircle)) {
+                team.tree.remove(static_cast<uint32_t>(i));
+            }
+        }
+    }
+}
+
+uint32_t SnowballFight::findNearestEnemy(const Fighter& fighter) const {
+    const Circle* hitCircle = world->getCircle(fighter.hitCircle);
+    if (!hitCircle) {
+        return kNoFighter;
+    }
+    Vector2D position = hitCircle->getCenter();
+    uint32_t nearest = kNoFighter;
+    Real nearestDistance = std::numeric_limits<Real>::max();
+    for (size_t t = 0; t < teams.size(); t++) {
+        if (t == fighter.team) {
+            continue;
+        }
+        uint32_t member = teams[t].tree.findNearest(position);
+        if (member == KdTree::kNone) {
+            continue;
+        }
+        Real distance = teams[t].positions[member].distanceSquared(position);
+        if (distance < nearestDistance) {
+            nearestDistance = distance;
+            nearest = teams[t].members[member];
+        }
+    }
+    return nearest;
+}
+
+void SnowballFight::throwAt(const Fighter& thrower, const Fighter& target, Real timeStep) {
+    const Body* body = world->getBody(thrower.body);
+    const Circle* hitCircle = world->getCircle(target.hitCircle);
+    double gravity = world->getGravity();
+    if (!body || !hitCircle || gravity <= 0.0) {
+        return;
+    }
+
+    // Lead the target: the flight time depends on where it will be, so
+    // settle both over a few rounds (whole ticks, since the arc is aimed
+    // for the world's integration)
+    Vector2D release(body->getBasePosition().x, body->getBasePosition().y - releaseHeight);
+    Vector2D aim = hitCircle->getCenter();
+    double ticks = 1.0;
+    for (int round = 0; round < 3; round++) {
+        double flight = std::sqrt(2.0 * std::abs(aim.x - release.x) / gravity);
+        ticks = std::max(1.0, std::round(flight / timeStep));
+        aim = hitCircle->getCenter() + Vector2D(target.velocityX * static_cast<Real>(ticks * timeStep), 0);
+    }
+
+    // After k ticks integrate() has moved y by vy k dt + g dt^2 k (k - 1) / 2
+    double flight = ticks * timeStep;
+    double drop = 0.5 * gravity * timeStep * timeStep * ticks * (ticks - 1.0);
+    Vector2D velocity(static_cast<Real>((aim.x - release.x) / flight),
+                      static_cast<Real>((aim.y - release.y - drop) / flight));
+
+    world->createProjectile(ProjectileState{release, velocity, static_cast<Real>(snowballRadius),
+                                            body->getGroundLevel(), target.hitCircle, thrower.body,
+                                            ProjectileStatus::FLYING});
+    throws++;
+}
+
+void SnowballFight::scheduleThrow(uint32_t fighter, double delay, double timeStep) {
+    uint64_t ticks = static_cast<uint64_t>(std::max(1.0, std::round(delay / timeStep)));
+    fighters[fighter].throwTimer = world->scheduleTimer(ticks, fighter);
+}
+
+void SnowballFight::scoreImpacts() {
+    for (const ProjectileImpact& impact : world->getImpacts()) {
+        if (impact.status == ProjectileStatus::HIT_TARGET) {
+            hits++;
+            uint32_t thrower = impact.thrower.index < fighterOfBody.size() ? fighterOfBody[impact.thrower.index]
+                                                                           : kNoFighter;
+            if (thrower != kNoFighter) {
+                teams[fighters[thrower].team].score++;
+            }
+        } else {
+            misses++;
+        }
+        world->destroyProjectile(impact.projectile);
+    }
+}
@@ -7,12 +7,13 @@
 #include <iostream>
 #include <sstream>
 
-SnowballStrategy::SnowballStrategy(std::shared_ptr<Body> body, std::shared_ptr<Circle> target, 
+SnowballStrategy::SnowballStrategy(World& world, BodyHandle body, CircleHandle target, 
                                    double snowballRadius, double gravity)
-    : MovementStrategy(body, target), active(false), gravity(gravity), radius(snowballRadius),
+    : MovementStrategy(world, body, target), active(false), gravity(gravity), radius(snowballRadius),
       hitTarget(false), hitGround(false) {
     // Default starting position (will be updated before throw)
     position = Vector2D(0, 0);
+    previousPosition = position;
     velocity = Vector2D(0, 0);
 }
 
@@ -30,6 +31,11 @@ bool SnowballStrategy::executeNextMove() {
     if (!active && !hitTarget && !hitGround) {
         // Auto-calculate a good throwing position and velocity if not set
         if (position.x == 0 && position.y == 0) {
+            const Body* body = getBody();
+            const Circle* target = getTarget();
+            if (!body || !target) {
+                return false;
+            }
             Vector2D bodyPos = body->getBasePosition();
             Vector2D targetPos = target->getCenter();
             
@@ -74,6 +80,7 @@ void SnowballStrategy::throwSnowball() {
     active = true;
     hitTarget = false;
     hitGround = false;
+    previousPosition = position;
     
     if (logger) {
         std::stringstream ss;
@@ -130,6 +137,7 @@ void SnowballStrategy::updatePhysics(double deltaTime) {
     velocity.y += gravity * deltaTime;
     
     // Update position
+    previousPosition = position;
     position.x += velocity.x * deltaTime;
     position.y += velocity.y * deltaTime;
 }
@@ -163,13 +171,17 @@ void SnowballStrategy::checkCollisions() {
 }
 
 bool SnowballStrategy::checkGroundCollision() const {
+    const Body* body = getBody();
     if (!body) return false;
     
-    // Check if the snowball's bottom edge is at or below ground level
-    return position.y + radius >= body->getGroundLevel();
+    // Did the snowball's bottom edge reach the ground during the last step?
+    Vector2D bottom(0, radius);
+    Real impact;
+    return body->getTerrain().intersectSegment(previousPosition + bottom, position + bottom, impact);
 }
 
 bool SnowballStrategy::checkTargetCollision() const {
+    const Circle* target = getTarget();
     if (!target) return false;
     
     // Calculate distance between circle centers
@@ -0,0 +1,122 @@
+/**
+ * @file SpatialGrid.cpp
+ * @brief Implementation of the SpatialGrid class
+ */
+#include "../include/SpatialGrid.h"
+
+namespace {
+// Cell coordinates are kept well inside int32_t so ranges and hashes never overflow
+constexpr Real kMaxCellCoordinate = Real(1 << 30);
+}
+
+SpatialGrid::SpatialGrid(Real cellSize, std::pmr::memory_resource* resource)
+    : cellSize(cellSize), inverseCellSize(Real(1) / cellSize),
+      items(resource), largeItems(resource), entries(resource), bucketStarts(resource), bucketMask(0) {
+}
+
+void SpatialGrid::clear() {
+    items.clear();
+    largeItems.clear();
+    entries.clear();
+    bucketStarts.clear();
+}
+
+void SpatialGrid::insert(uint32_t value, const Vector2D& min, const Vector2D& max) {
+    items.push_back(Item{min, max, CellRange{}, value, false});
+}
+
+void SpatialGrid::build() {
+    // Cell ranges first (the cell size may have changed since insert())
+    size_t entryCount = 0;
+    largeItems.clear();
+    for (uint32_t i = 0; i < items.size(); i++) {
+        Item& item = items[i];
+        item.cells = toCells(item.min, item.max);
+        uint64_t cells = uint64_t(int64_t(item.cells.maxX) - item.cells.minX + 1) *
+                         uint64_t(int64_t(item.cells.maxY) - item.cells.minY + 1);
+        item.large = cells > kMaxCellsPerItem;
+        if (item.large) {
+            largeItems.push_back(i);
+        } else {
+            entryCount += cells;
+        }
+    }
+
+    // Power-of-two bucket count, at least one bucket per entry
+    uint32_t bucketCount = 16;
+    while (bucketCount < entryCount) {
+        bucketCount *= 2;
+    }
+    bucketMask = bucketCount - 1;
+
+    // Counting sort of the (item, cell) entries by bucket: count, prefix sum, scatter
+    bucketStarts.assign(bucketCount + 1, 0);
+    for (const Item& item : items) {
+        if (item.large) {
+            continue;
+        }
+        for (int32_t cellY = item.cells.minY; cellY <= item.cells.maxY; cellY++) {
+            for (int32_t cellX = item.cells.minX; cellX <= item.cells.maxX; cellX++) {
+                bucketStarts[bucketOf(cellX, cellY) + 1]++;
+            }
+        }
+    }
+    for (uint32_t b = 0; b < bucketCount; b++) {
+        bucketStarts[b + 1] += bucketStarts[b];
+    }
+
+    // bucketStarts[b] serves as the write cursor and ends at the start of b + 1
+    entries.resize(entryCount);
+    for (uint32_t i = 0; i < items.size(); i++) {
+        const Item& item = items[i];
+        if (item.large) {
+            continue;
+        }
+        for (int32_t cellY = item.cells.minY; cellY <= item.cells.maxY; cellY++) {
+            for (int32_t cellX = item.cells.minX; cellX <= item.cells.maxX; cellX++) {
+                entries[bucketStarts[bucketOf(cellX, cellY)]++] = Entry{i, cellX, cellY};
+            }
+        }
+    }
+    for (uint32_t b = bucketCount; b > 0; b--) {
+        bucketStarts[b] = bucketStarts[b - 1];
+    }
+    bucketStarts[0] = 0;
+}
+
+size_t SpatialGrid::size() const {
+    return items.size();
+}
+
+Real SpatialGrid::getCellSize() const {
+    return cellSize;
+}
+
+void SpatialGrid::setCellSize(Real cellSize) {
+    this->cellSize = cellSize;
+    inverseCellSize = Real(1) / cellSize;
+}
+
+int32_t SpatialGrid::toCell(Real coordinate) const {
+    Real cell = coordinate * inverseCellSize;
+    // Written so that NaN ends up at the lower bound
+    cell = (cell > -kMaxCellCoordinate) ? cell : -kMaxCellCoordinate;
+    cell = (cell < kMaxCellCoordinate) ? cell : kMaxCellCoordinate;
+    // Floor without a libm call: truncate, then step down for negative fractions
+    int32_t truncated = static_cast<int32_t>(cell);
+    return truncated - (cell < static_cast<Real>(truncated) ? 1 : 0);
+}
+
+SpatialGrid::CellRange SpatialGrid::toCells(const Vector2D& min, const Vector2D& max) const {
+    return CellRange{toCell(min.x), toCell(min.y), toCell(max.x), toCell(max.y)};
+}
+
+uint32_t SpatialGrid::bucketOf(int32_t cellX, int32_t cellY) const {
+    uint32_t hash = static_cast<uint32_t>(cellX) * 73856093u ^ static_cast<uint32_t>(cellY) * 19349663u;
+    return hash & bucketMask;
+}
+
+bool SpatialGrid::overlaps(const Item& item, const Vector2D& min, const Vector2D& max) {
+    return item.min.x <= max.x && min.x <= item.max.x &&
+           item.min.y <= max.y && min.y <= item.max.y;
+}
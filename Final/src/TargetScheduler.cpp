@@ -0,0 +1,322 @@
+/**
+ * @file TargetScheduler.cpp
+ * @brief Implementation of the TargetScheduler class
+ */
+#include "../include/TargetScheduler.h"
+#include "../include/World.h"
+#include "../include/JobSystem.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Smaller gains are rounding, and taking them could cycle
+constexpr double kMinGain = 1e-9;
+// Steps between clock reads while improving
+constexpr size_t kTimeCheckInterval = 64;
+// Cities per neighbour-list job
+constexpr size_t kNeighbourGrain = 256;
+}
+
+TargetScheduler::TargetScheduler(std::pmr::memory_resource* resource)
+    : timeBudget(0.02), neighbourCount(8), cities(resource), tour(resource), positionOf(resource),
+      neighbours(resource), tree(resource), timeChecks(0), outOfTime(false), greedyLength(0.0),
+      tourLength(0.0), improvingMoves(0) {
+}
+
+void TargetScheduler::planTour(const Vector2D& start, std::span<const Vector2D> points, std::vector<uint32_t>& order) {
+    order.clear();
+    improvingMoves = 0;
+    cities.clear();
+    cities.push_back(start);
+    cities.insert(cities.end(), points.begin(), points.end());
+
+    tree.build(cities);
+    buildNeighbourLists();
+    buildGreedyTour();
+    greedyLength = 0.0;
+    for (size_t i = 0; i + 1 < tour.size(); i++) {
+        greedyLength += distance(tour[i], tour[i + 1]);
+    }
+    tourLength = greedyLength;
+
+    deadline = std::chrono::steady_clock::now() +
+               std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(timeBudget));
+    timeChecks = 0;
+    outOfTime = false;
+
+    // Alternate until neither finds anything (or time is up)
+    bool improved = true;
+    while (improved && !isOutOfTime()) {
+        improved = improveTwoOpt();
+        improved = improveOrOpt() || improved;
+    }
+
+    for (size_t i = 1; i < tour.size(); i++) {
+        order.push_back(tour[i] - 1);
+    }
+}
+
+size_t TargetScheduler::planRoute(const World& world, const Body& body, std::span<const CircleHandle> targets,
+                                  std::vector<CircleHandle>& route) {
+    route.clear();
+    std::vector<CircleHandle> reachable;
+    std::vector<Vector2D> positions;
+    for (CircleHandle handle : targets) {
+        const Circle* target = world.getCircle(handle);
+        if (target && isReachable(world, body, *target)) {
+            reachable.push_back(handle);
+            positions.push_back(target->getCenter());
+        }
+    }
+
+    std::vector<uint32_t> order;
+    planTour(body.getBasePosition(), positions, order);
+    for (uint32_t index : order) {
+        route.push_back(reachable[index]);
+    }
+    return targets.size() - route.size();
+}
+
+bool TargetScheduler::isReachable(const World& world, const Body& body, const Circle& target) {
+    // The base stays as high above the ground as it is now (as walking keeps it)
+    const Terrain& terrain = body.getTerrain();
+    Vector2D base = body.getBasePosition();
+    Vector2D center = target.getCenter();
+    Real ground = terrain.getHeightAt(center.x);
+    Real baseHeight = terrain.getHeightAt(base.x) - base.y;
+    if (center.y - target.getRadius() >= ground) {
+        return false;
+    }
+    if (ground - center.y - target.getRadius() > baseHeight + getReachDistance(body)) {
+        return false;
+    }
+    if (world.hasNavigationGrid()) {
+        const OccupancyGrid& grid = world.getNavigationGrid();
+        if (grid.isBlocked(grid.toCell(center))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Real TargetScheduler::getReachDistance(const Body& body) {
+    // Along each chain: the first joint's distance from the base, then every segment straightened out
+    size_t count = body.getSegmentCount();
+    std::vector<Real> reach(count, Real(-1));
+    Real furthest = 0;
+    for (size_t i = 0; i < count; i++) {
+        size_t chain[64];
+        size_t depth = 0;
+        for (size_t j = i; j != Body::kNoSegment && reach[j] < 0 && depth < 64; j = body.getParentIndex(j)) {
+            chain[depth++] = j;
+        }
+        while (depth > 0) {
+            size_t j = chain[--depth];
+            size_t parent = body.getParentIndex(j);
+            const Segment& segment = body.getSegmentAt(j);
+            Real start = parent == Body::kNoSegment ? segment.getStart().distance(body.getBasePosition()) : reach[parent];
+            reach[j] = start + segment.getLength();
+        }
+        furthest = std::max(furthest, reach[i]);
+    }
+    return furthest;
+}
+
+double TargetScheduler::getTimeBudget() const {
+    return timeBudget;
+}
+
+void TargetScheduler::setTimeBudget(double seconds) {
+    timeBudget = seconds;
+}
+
+size_t TargetScheduler::getNeighbourCount() const {
+    return neighbourCount;
+}
+
+void TargetScheduler::setNeighbourCount(size_t count) {
+    neighbourCount = std::clamp<size_t>(count, 1, 64);
+}
+
+double TargetScheduler::getGreedyLength() const {
+    return greedyLength;
+}
+
+double TargetScheduler::getTourLength() const {
+    return tourLength;
+}
+
+size_t TargetScheduler::getImprovingMoves() const {
+    return improvingMoves;
+}
+
+void TargetScheduler::buildGreedyTour() {
+    // Each step takes the nearest target not yet in the tour
+    tour.clear();
+    tour.push_back(0);
+    tree.remove(0);
+    for (uint32_t current = 0; tree.getRemaining() > 0; ) {
+        current = tree.findNearest(cities[current]);
+        tree.remove(current);
+        tour.push_back(current);
+    }
+    positionOf.resize(cities.size());
+    updatePositions(0, tour.size() - 1);
+}
+
+void TargetScheduler::buildNeighbourLists() {
+    // Each city writes only its own list, so the jobs need no ordering
+    neighbours.assign(cities.size() * neighbourCount, kNoCity);
+    JobSystem::shared().parallelFor(0, cities.size(), kNeighbourGrain, [this](size_t first, size_t last) {
+        for (size_t city = first; city < last; city++) {
+            std::span<uint32_t> list(neighbours.data() + city * neighbourCount, neighbourCount);
+            tree.findNearest(cities[city], list, static_cast<uint32_t>(city));
+        }
+    });
+}
+
+bool TargetScheduler::improveTwoOpt() {
+    // Replace edges (a, b) and (c, d) with (a, c) and (b, d), where c is
+    // near a, by reversing the stretch between them
+    bool improved = false;
+    for (size_t i = 0; i < tour.size() && !isOutOfTime(); i++) {
+        uint32_t a = tour[i];
+        uint32_t b = cityAt(i + 1);
+        double ab = distance(a, b);
+        for (size_t k = 0; k < neighbourCount; k++) {
+            uint32_t c = neighbours[a * neighbourCount + k];
+            if (c == kNoCity) {
+                break;
+            }
+            size_t j = positionOf[c];
+            double gain = 0.0;
+            if (j > i + 1) {
+                // a b ... c d  ->  a c ... b d
+                uint32_t d = cityAt(j + 1);
+                gain = ab + distance(c, d) - distance(a, c) - distance(b, d);
+                if (gain > kMinGain) {
+                    reverseTour(i + 1, j);
+                }
+            } else if (j + 1 < i) {
+                // c e ... a b  ->  c a ... e b
+                uint32_t e = tour[j + 1];
+                gain = distance(c, e) + ab - distance(c, a) - distance(e, b);
+                if (gain > kMinGain) {
+                    reverseTour(j + 1, i);
+                }
+            }
+            if (gain > kMinGain) {
+                tourLength -= gain;
+                improvingMoves++;
+                improved = true;
+                break;
+            }
+        }
+    }
+    return improved;
+}
+
+bool TargetScheduler::improveOrOpt() {
+    // Take out tour[first..last] and put it between two consecutive cities
+    // next to one of its ends, forwards or reversed
+    bool improved = false;
+    for (size_t length = 1; length <= 3; length++) {
+        for (size_t first = 1; first + length <= tour.size() && !isOutOfTime(); first++) {
+            size_t last = first + length - 1;
+            uint32_t p = tour[first - 1];
+            uint32_t f = tour[first];
+            uint32_t l = tour[last];
+            uint32_t n = cityAt(last + 1);
+            double removal = distance(p, f) + distance(l, n) - distance(p, n);
+            if (removal <= kMinGain) {
+                continue;
+            }
+
+            double bestGain = kMinGain;
+            size_t bestAfter = 0;
+            bool bestReversed = false;
+            for (uint32_t end : {f, l}) {
+                for (size_t k = 0; k < neighbourCount; k++) {
+                    uint32_t c = neighbours[end * neighbourCount + k];
+                    if (c == kNoCity) {
+                        break;
+                    }
+                    // The edge leaving c and the edge entering it
+                    size_t position = positionOf[c];
+                    for (size_t after : {position, position - 1}) {
+                        if (after >= tour.size() || (after + 1 >= first && after <= last)) {
+                            continue;
+                        }
+                        uint32_t u = tour[after];
+                        uint32_t v = cityAt(after + 1);
+                        double uv = distance(u, v);
+                        double forward = removal + uv - distance(u, f) - distance(l, v);
+                        double reversed = removal + uv - distance(u, l) - distance(f, v);
+                        if (forward > bestGain) {
+                            bestGain = forward;
+                            bestAfter = after;
+                            bestReversed = false;
+                        }
+                        if (reversed > bestGain) {
+                            bestGain = reversed;
+                            bestAfter = after;
+                            bestReversed = true;
+                        }
+                    }
+                }
+            }
+            if (bestGain <= kMinGain) {
+                continue;
+            }
+
+            size_t newFirst;
+            if (bestAfter < first) {
+                std::rotate(tour.begin() + bestAfter + 1, tour.begin() + first, tour.begin() + last + 1);
+                updatePositions(bestAfter + 1, last);
+                newFirst = bestAfter + 1;
+            } else {
+                std::rotate(tour.begin() + first, tour.begin() + last + 1, tour.begin() + bestAfter + 1);
+                updatePositions(first, bestAfter);
+                newFirst = bestAfter + 1 - length;
+            }
+            if (bestReversed) {
+                reverseTour(newFirst, newFirst + length - 1);
+            }
+            tourLength -= bestGain;
+            improvingMoves++;
+            improved = true;
+        }
+    }
+    return improved;
+}
+
+void TargetScheduler::reverseTour(size_t first, size_t last) {
+    std::reverse(tour.begin() + first, tour.begin() + last + 1);
+    updatePositions(first, last);
+}
+
+void TargetScheduler::updatePositions(size_t first, size_t last) {
+    for (size_t i = first; i <= last; i++) {
+        positionOf[tour[i]] = static_cast<uint32_t>(i);
+    }
+}
+
+double TargetScheduler::distance(uint32_t a, uint32_t b) const {
+    if (a == kNoCity || b == kNoCity) {
+        return 0.0;
+    }
+    double dx = static_cast<double>(cities[a].x) - static_cast<double>(cities[b].x);
+    double dy = static_cast<double>(cities[a].y) - static_cast<double>(cities[b].y);
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+uint32_t TargetScheduler::cityAt(size_t position) const {
+    return position < tour.size() ? tour[position] : kNoCity;
+}
+
+bool TargetScheduler::isOutOfTime() {
+    if (!outOfTime && ++timeChecks % kTimeCheckInterval == 0) {
+        outOfTime = std::chrono::steady_clock::now() >= deadline;
+    }
+    return outOfTime;
+}
@@ -0,0 +1,208 @@
+/**
+ * @file Terrain.cpp
+ * @brief Implementation of the Terrain class
+ */
+#include "../include/Terrain.h"
+#include "../include/Dual.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Plain value of a scalar, for picking sample indices
+template <typename Scalar>
+double primal(const Scalar& value) {
+    return static_cast<double>(value);
+}
+
+template <typename T, std::size_t N>
+double primal(const Dual<T, N>& value) {
+    return static_cast<double>(value.value);
+}
+}
+
+template <typename Scalar>
+BasicTerrain<Scalar>::BasicTerrain(Scalar groundLevel)
+    : groundLevel(groundLevel), originX(0), spacing(1), inverseSpacing(1) {
+}
+
+template <typename Scalar>
+BasicTerrain<Scalar>::BasicTerrain(Scalar originX, Scalar spacing, std::vector<Scalar> heights)
+    : groundLevel(heights.empty() ? Scalar(0) : heights.front()), originX(originX), spacing(spacing),
+      inverseSpacing(Scalar(1) / spacing) {
+    // One sample is just flat ground
+    if (heights.size() >= 2) {
+        this->heights = std::make_shared<const std::vector<Scalar>>(std::move(heights));
+    }
+}
+
+template <typename Scalar>
+template <typename OtherScalar>
+BasicTerrain<Scalar>::BasicTerrain(const BasicTerrain<OtherScalar>& other)
+    : groundLevel(static_cast<Scalar>(other.groundLevel)), originX(static_cast<Scalar>(other.originX)),
+      spacing(static_cast<Scalar>(other.spacing)), inverseSpacing(static_cast<Scalar>(other.inverseSpacing)) {
+    if (other.heights) {
+        std::vector<Scalar> converted;
+        converted.reserve(other.heights->size());
+        for (const OtherScalar& height : *other.heights) {
+            converted.push_back(static_cast<Scalar>(height));
+        }
+        heights = std::make_shared<const std::vector<Scalar>>(std::move(converted));
+    }
+}
+
+template <typename Scalar>
+Scalar BasicTerrain<Scalar>::getHeightAt(Scalar x) const {
+    if (!heights) {
+        return groundLevel;
+    }
+    Scalar t;
+    size_t i = intervalAt(x, t);
+    const std::vector<Scalar>& h = *heights;
+    return h[i] + (h[i + 1] - h[i]) * t;
+}
+
+template <typename Scalar>
+Scalar BasicTerrain<Scalar>::getSlopeAt(Scalar x) const {
+    if (!heights) {
+        return Scalar(0);
+    }
+    // Held flat beyond the samples
+    double u = primal((x - originX) * inverseSpacing);
+    if (u <= 0.0 || u >= static_cast<double>(heights->size() - 1)) {
+        return Scalar(0);
+    }
+    Scalar t;
+    size_t i = intervalAt(x, t);
+    return ((*heights)[i + 1] - (*heights)[i]) * inverseSpacing;
+}
+
+template <typename Scalar>
+typename BasicTerrain<Scalar>::Vec BasicTerrain<Scalar>::getNormalAt(Scalar x) const {
+    if (!heights) {
+        return Vec(0, -1);
+    }
+    // Up is -y: the normal of y = h(x) pointing out of the ground is (h', -1)
+    using std::sqrt;
+    Scalar slope = getSlopeAt(x);
+    Scalar inverseLength = Scalar(1) / sqrt(Scalar(1) + slope * slope);
+    return Vec(slope * inverseLength, -inverseLength);
+}
+
+template <typename Scalar>
+bool BasicTerrain<Scalar>::isTouching(const Vec& point, Scalar threshold) const {
+    using std::abs;
+    return abs(point.y - getHeightAt(point.x)) <= threshold;
+}
+
+template <typename Scalar>
+bool BasicTerrain<Scalar>::isBelow(const Vec& point) const {
+    return point.y >= getHeightAt(point.x);
+}
+
+template <typename Scalar>
+bool BasicTerrain<Scalar>::intersectSegment(const Vec& from, const Vec& to, Scalar& fraction) const {
+    if (isBelow(from)) {
+        fraction = Scalar(0);
+        return true;
+    }
+    Vec delta = to - from;
+    if (!heights) {
+        if (to.y < groundLevel) {
+            return false;
+        }
+        fraction = (groundLevel - from.y) / delta.y;
+        return true;
+    }
+
+    // Between two samples the ground is a line, so the height of the
+    // segment above it is linear in s: find the first piece where it
+    // changes sign
+    Scalar s0 = Scalar(0);
+    Scalar above0 = getHeightAt(from.x) - from.y;
+    auto reachesGroundBy = [&](Scalar s1) {
+        Vec point = from + delta * s1;
+        Scalar above1 = getHeightAt(point.x) - point.y;
+        if (above1 <= Scalar(0)) {
+            fraction = s0 + (s1 - s0) * above0 / (above0 - above1);
+            return true;
+        }
+        s0 = s1;
+        above0 = above1;
+        return false;
+    };
+
+    // Sample positions strictly between from.x and to.x
+    if (delta.x != Scalar(0)) {
+        double last = static_cast<double>(heights->size() - 1);
+        double u0 = primal((from.x - originX) * inverseSpacing);
+        double u1 = primal((to.x - originX) * inverseSpacing);
+        if (delta.x > Scalar(0)) {
+            for (double k = std::max(std::floor(u0) + 1.0, 0.0); k <= last && k < u1; k += 1.0) {
+                Scalar s1 = (originX + Scalar(k) * spacing - from.x) / delta.x;
+                if (s1 > s0 && s1 < Scalar(1) && reachesGroundBy(s1)) {
+                    return true;
+                }
+            }
+        } else {
+            for (double k = std::min(std::ceil(u0) - 1.0, last); k >= 0.0 && k > u1; k -= 1.0) {
+                Scalar s1 = (originX + Scalar(k) * spacing - from.x) / delta.x;
+                if (s1 > s0 && s1 < Scalar(1) && reachesGroundBy(s1)) {
+                    return true;
+                }
+            }
+        }
+    }
+    return reachesGroundBy(Scalar(1));
+}
+
+template <typename Scalar>
+bool BasicTerrain<Scalar>::isFlat() const {
+    return !heights;
+}
+
+template <typename Scalar>
+Scalar BasicTerrain<Scalar>::getGroundLevel() const {
+    return groundLevel;
+}
+
+template <typename Scalar>
+Scalar BasicTerrain<Scalar>::getOriginX() const {
+    return originX;
+}
+
+template <typename Scalar>
+Scalar BasicTerrain<Scalar>::getSpacing() const {
+    return spacing;
+}
+
+template <typename Scalar>
+size_t BasicTerrain<Scalar>::getSampleCount() const {
+    return heights ? heights->size() : 0;
+}
+
+template <typename Scalar>
+size_t BasicTerrain<Scalar>::intervalAt(Scalar x, Scalar& t) const {
+    Scalar u = (x - originX) * inverseSpacing;
+    double last = static_cast<double>(heights->size() - 1);
+    double position = primal(u);
+    if (!(position > 0.0)) {
+        t = Scalar(0);
+        return 0;
+    }
+    if (position >= last) {
+        t = Scalar(1);
+        return heights->size() - 2;
+    }
+    double index = std::floor(position);
+    t = u - Scalar(index);
+    return static_cast<size_t>(index);
+}
+
+// Explicit instantiations for the supported scalar types
+template class BasicTerrain<float>;
+template class BasicTerrain<double>;
+template class BasicTerrain<KinematicDual>;
+template BasicTerrain<double>::BasicTerrain(const BasicTerrain<float>&);
+template BasicTerrain<float>::BasicTerrain(const BasicTerrain<double>&);
+template BasicTerrain<KinematicDual>::BasicTerrain(const BasicTerrain<float>&);
+template BasicTerrain<KinematicDual>::BasicTerrain(const BasicTerrain<double>&);
@@ -0,0 +1,1470 @@
+/**
+ * @file TextBenchmarks.cpp
+ * @brief Benchmark and check modes of the text front end
+ */
+#include "../include/TextBenchmarks.h"
+#include "../include/World.h"
+#include "../include/ScenarioArena.h"
+#include "../include/WalkerStrategy.h"
+#include "../include/SnowballStrategy.h"
+#include "../include/SpatialGrid.h"
+#include "../include/TargetScheduler.h"
+#include "../include/SnowballFight.h"
+#include "../include/TimingWheel.h"
+#include "../include/JobSystem.h"
+#include "../include/BodyBehaviours.h"
+#include "../include/SimulationCommand.h"
+#include "../include/PointKernels.h"
+#include "../include/Kinematics.h"
+#include "../include/InverseKinematics.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <random>
+#include <thread>
+
+namespace {
+
+// Run one walker and one snowball scenario entirely inside the arena
+void runArenaScenario(ScenarioArena& arena, int index) {
+    World world(arena.getResource());
+    double offset = 10.0 * (index % 5);
+    
+    const double groundLevel = 400.0;
+    BodyHandle body = world.createBody(Vector2D(100.0 + offset, groundLevel - Body::kStandingHeight), groundLevel);
+    CircleHandle target = world.createCircle(Vector2D(400.0 + offset, groundLevel - Body::kStandingHeight - 60.0), 20.0);
+    
+    WalkerStrategy walker(world, body, target, 5.0);
+    walker.planSequence();
+    while (!walker.isSequenceComplete()) {
+        walker.executeNextMove();
+    }
+    
+    SnowballStrategy snowball(world, body, target, 10.0, 9.81);
+    snowball.planSequence();
+    snowball.executeNextMove();
+    for (int step = 0; step < 1000 && !snowball.isSequenceComplete(); step++) {
+        snowball.update(0.1);
+    }
+}
+
+// Print the arena's traffic over back-to-back scenarios, and what reached
+// the default resource meanwhile: anything the arena was not threaded to
+void runArenaReport(int scenarios) {
+    ScenarioArena arena;
+    CountingResource fallback(std::pmr::get_default_resource());
+    std::pmr::memory_resource* previous = std::pmr::set_default_resource(&fallback);
+    
+    std::cout << "scenario  default-allocs  arena-allocs  arena-bytes  upstream-allocs  capacity" << std::endl;
+    size_t steadyAllocations = 0;
+    for (int i = 0; i < scenarios; i++) {
+        fallback.resetCounts();
+        runArenaScenario(arena, i);
+        ScenarioArena::Report report = arena.getReport();
+        arena.release();
+        size_t allocations = fallback.getAllocationCount();
+        
+        // The first scenario warms up the library and may grow the arena
+        if (i > 0) {
+            steadyAllocations += allocations;
+        }
+        
+        std::printf("%8d  %14zu  %12zu  %11zu  %15zu  %8zu\n", i, allocations, report.arenaAllocations,
+                    report.arenaBytes, report.upstreamAllocations, report.capacity);
+    }
+    std::pmr::set_default_resource(previous);
+    std::cout << "Default-resource allocations after warm-up: " << steadyAllocations << std::endl;
+}
+
+// Time "does any end segment touch this circle" on a rig of extraSegments
+// randomly attached segments of widely varying length: brute force, a
+// segment grid at several cell sizes, and the body's segment tree
+void runContactBench(int extraSegments, int queries) {
+    std::mt19937 random(7);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    
+    Body body(Vector2D(0.0, 0.0), 1e9);
+    std::vector<std::string> names = {"torso"};
+    for (int i = 0; i < extraSegments; i++) {
+        std::string name = "segment" + std::to_string(i);
+        body.addSegment(name, 2.0 * std::pow(200.0, unit(random)), angle(random));   // 2 to 400 units
+        body.connectSegment(names[random() % names.size()], name);
+        names.push_back(name);
+    }
+    body.updateSegments();
+    size_t segmentCount = body.getSegmentCount();
+    
+    // Probe circles near random segment ends
+    std::vector<Circle> probes;
+    for (int q = 0; q < queries; q++) {
+        Vector2D end = body.getSegmentAt(random() % segmentCount).getEnd();
+        probes.emplace_back(end + Vector2D(40.0 * angle(random), 40.0 * angle(random)), 5.0 + 30.0 * unit(random));
+    }
+    
+    auto timeQueries = [&](const char* name, auto&& reaches) {
+        int reached = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (const Circle& probe : probes) {
+            reached += reaches(probe) ? 1 : 0;
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::printf("  %-24s %9.1f ns/query  (%d reached)\n", name, seconds * 1e9 / queries, reached);
+    };
+    
+    std::cout << "Segments: " << segmentCount << ", queries: " << queries << std::endl;
+    body.setSegmentTreeThreshold(static_cast<size_t>(-1));
+    timeQueries("brute force", [&](const Circle& probe) { return body.canReachObject(probe, 1); });
+    
+    for (double cellSize : {16.0, 64.0, 256.0}) {
+        SpatialGrid grid(cellSize);
+        for (size_t i = 0; i < segmentCount; i++) {
+            Aabb box = Aabb::fromSegment(body.getSegmentAt(i).getStart(), body.getSegmentAt(i).getEnd());
+            grid.insert(static_cast<uint32_t>(i), box.min, box.max);
+        }
+        grid.build();
+        
+        std::string name = "grid, cell " + std::to_string(static_cast<int>(cellSize));
+        timeQueries(name.c_str(), [&](const Circle& probe) {
+            Vector2D extent(probe.getRadius(), probe.getRadius());
+            bool touching = false;
+            grid.query(probe.getCenter() - extent, probe.getCenter() + extent, [&](uint32_t i) {
+                const Segment& segment = body.getSegmentAt(i);
+                touching = touching || (body.isEndPoint(static_cast<size_t>(i)) &&
+                                        (probe.contains(segment.getEnd()) ||
+                                         segment.distanceToPoint(probe.getCenter()) <= probe.getRadius()));
+            });
+            return touching;
+        });
+    }
+    
+    body.setSegmentTreeThreshold(0);
+    timeQueries("segment tree", [&](const Circle& probe) { return body.canReachObject(probe, 1); });
+}
+
+// Time self-collision checks while the arms sweep through small steps
+void runSelfCollisionBench(int checks) {
+    // Legs apart: the rest pose has them on top of each other
+    Body body(Vector2D(0.0, 0.0), 1e9);
+    body.rotateSegment("left_upper_leg", 0.5);
+    body.rotateSegment("right_upper_leg", -0.5);
+    const double step = 0.01;
+    auto sweepArms = [&](auto&& check) {
+        int colliding = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < checks; i++) {
+            double direction = (i / 300) % 2 == 0 ? 1.0 : -1.0;
+            body.rotateSegment("left_upper_arm", direction * step);
+            body.rotateSegment("right_lower_arm", -direction * step);
+            colliding += check() ? 1 : 0;
+        }
+        return std::make_pair(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), colliding);
+    };
+    
+    double poseSeconds = sweepArms([] { return false; }).first;
+    auto [checkSeconds, colliding] = sweepArms([&] { return body.hasSelfCollision(); });
+    auto [clearanceSeconds, close] = sweepArms([&] { return body.hasSelfCollision(5.0); });
+    
+    std::cout << "Segments: " << body.getSegmentCount() << ", checks: " << checks << std::endl;
+    std::printf("  %-24s %9.1f ns/check\n", "pose update only", poseSeconds * 1e9 / checks);
+    std::printf("  %-24s %9.1f ns/check  (%d colliding)\n", "self-collision",
+                (checkSeconds - poseSeconds) * 1e9 / checks, colliding);
+    std::printf("  %-24s %9.1f ns/check  (%d colliding)\n", "self-collision, 5 units",
+                (clearanceSeconds - poseSeconds) * 1e9 / checks, close);
+}
+
+// Time Body::moveBaseTo (a walking step: every segment re-posed from its
+// parent's end) against the same Vector2D arithmetic over a flat array,
+// which is all the header-only vector leaves to the call
+void runMoveBench(int moves) {
+    Body body(Vector2D(0.0, 400.0 - Body::kStandingHeight), 400.0);
+    size_t segmentCount = body.getSegmentCount();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < moves; i++) {
+        double x = (i % 200 < 100) ? i % 100 : 100 - i % 100;
+        body.moveBaseTo(Vector2D(x, 400.0 - Body::kStandingHeight));
+    }
+    double moveSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    // A chain of as many segments, each starting at the end of the one before
+    std::vector<Vector2D> starts(segmentCount), directions(segmentCount);
+    for (size_t i = 0; i < segmentCount; i++) {
+        const Segment& segment = body.getSegmentAt(i);
+        starts[i] = segment.getStart();
+        directions[i] = segment.getEnd() - segment.getStart();
+    }
+    Vector2D base = body.getBasePosition();
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < moves; i++) {
+        double x = (i % 200 < 100) ? i % 100 : 100 - i % 100;
+        Vector2D next(x, 400.0 - Body::kStandingHeight);
+        Vector2D displacement = next - base;
+        base = next;
+        starts[0] += displacement;
+        for (size_t k = 1; k < segmentCount; k++) {
+            starts[k] = starts[k - 1] + directions[k - 1];
+        }
+    }
+    double arraySeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    std::cout << "Segments: " << segmentCount << ", moves: " << moves << " (base ends at x = "
+              << body.getBasePosition().x << ", chain at x = " << starts.back().x << ")" << std::endl;
+    std::printf("  %-24s %8.1f ns/move  %6.2f ns/segment\n", "Body::moveBaseTo", moveSeconds * 1e9 / moves,
+                moveSeconds * 1e9 / moves / segmentCount);
+    std::printf("  %-24s %8.1f ns/move  %6.2f ns/segment\n", "Vector2D array", arraySeconds * 1e9 / moves,
+                arraySeconds * 1e9 / moves / segmentCount);
+}
+
+// Plan across a size x size navigation grid scattered with obstacles
+void runPathBench(int size, int obstacleCount) {
+    std::mt19937 random(11);
+    std::uniform_real_distribution<double> coordinate(0.0, size);
+    std::uniform_real_distribution<double> extent(2.0, size / 80.0);
+    
+    World world;
+    std::vector<ObstacleHandle> obstacles;
+    for (int i = 0; i < obstacleCount; i++) {
+        Vector2D center(coordinate(random), coordinate(random));
+        if (i % 2 == 0) {
+            obstacles.push_back(world.createObstacle(Obstacle::circle(center, extent(random))));
+        } else {
+            Vector2D half(extent(random), extent(random));
+            obstacles.push_back(world.createObstacle(Obstacle::box(center - half, center + half)));
+        }
+    }
+    
+    auto start = std::chrono::steady_clock::now();
+    world.setNavigationGrid(Vector2D(0.0, 0.0), 1.0, size, size, 1.0);
+    double stampSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    // Corner to corner, and a few random pairs
+    std::vector<std::pair<Vector2D, Vector2D>> queries = {{Vector2D(0.5, 0.5), Vector2D(size - 0.5, size - 0.5)},
+                                                          {Vector2D(size - 0.5, 0.5), Vector2D(0.5, size - 0.5)}};
+    for (int i = 0; i < 8; i++) {
+        queries.emplace_back(Vector2D(coordinate(random), coordinate(random)), Vector2D(coordinate(random), coordinate(random)));
+    }
+    
+    std::cout << "Grid: " << size << "x" << size << ", obstacles: " << obstacleCount << std::endl;
+    std::printf("  %-24s %9.3f ms\n", "stamp obstacles", stampSeconds * 1e3);
+    std::vector<Vector2D> waypoints;
+    auto timePlans = [&](const char* name) {
+        double worst = 0.0;
+        double total = 0.0;
+        int found = 0;
+        size_t waypointCount = 0;
+        for (const auto& query : queries) {
+            auto begin = std::chrono::steady_clock::now();
+            bool ok = world.planPath(query.first, query.second, waypoints);
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+            worst = std::max(worst, seconds);
+            total += seconds;
+            found += ok ? 1 : 0;
+            waypointCount += ok ? waypoints.size() : 0;
+        }
+        std::printf("  %-24s %9.3f ms mean, %.3f ms worst  (%d/%zu found, %zu waypoints)\n", name,
+                    total * 1e3 / queries.size(), worst * 1e3, found, queries.size(), waypointCount);
+    };
+    timePlans("plan");
+    
+    // Move every obstacle a little, then plan again
+    std::uniform_real_distribution<double> nudge(-5.0, 5.0);
+    start = std::chrono::steady_clock::now();
+    for (ObstacleHandle handle : obstacles) {
+        Vector2D center = world.getObstacle(handle)->center;
+        world.moveObstacle(handle, center + Vector2D(nudge(random), nudge(random)));
+    }
+    double moveSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::printf("  %-24s %9.1f us/obstacle\n", "grid update on move", moveSeconds * 1e6 / std::max(obstacleCount, 1));
+    timePlans("plan after moves");
+}
+
+// Order N targets scattered over a wide field into one walker's route
+void runRouteBench(int targetCount) {
+    std::mt19937 random(13);
+    double fieldWidth = 40.0 * std::sqrt(static_cast<double>(targetCount)) * 20.0;
+    std::uniform_real_distribution<double> x(0.0, fieldWidth);
+    std::uniform_real_distribution<double> height(20.0, 400.0);
+    
+    World world;
+    BodyHandle body = world.createBody(Vector2D(0.0, 400.0), 400.0);
+    std::vector<CircleHandle> targets;
+    for (int i = 0; i < targetCount; i++) {
+        targets.push_back(world.createCircle(Vector2D(x(random), 400.0 - height(random)), 10.0));
+    }
+    
+    std::cout << "Targets: " << targetCount << " over " << fieldWidth << " units" << std::endl;
+    std::vector<CircleHandle> route;
+    for (double budget : {0.0, 0.005, 0.02, 0.1}) {
+        TargetScheduler scheduler;
+        scheduler.setTimeBudget(budget);
+        auto start = std::chrono::steady_clock::now();
+        size_t unreachable = scheduler.planRoute(world, *world.getBody(body), targets, route);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::printf("  budget %5.0f ms: %8.2f ms  greedy %10.0f  tour %10.0f (%5.1f%% shorter, %zu moves, %zu unreachable)\n",
+                    budget * 1e3, seconds * 1e3, scheduler.getGreedyLength(), scheduler.getTourLength(),
+                    100.0 * (1.0 - scheduler.getTourLength() / scheduler.getGreedyLength()),
+                    scheduler.getImprovingMoves(), unreachable);
+    }
+}
+
+// Two teams of fighters in alternating blocks, throwing at each other
+void runFight(int fighterCount, int ticks) {
+    const double groundLevel = 400.0;
+    const double timeStep = 1.0 / 60.0;
+    for (bool events : {true, false}) {
+        World world;
+        world.setGravity(300.0);
+        SnowballFight fight(world);
+        fight.setThrowInterval(0.1);
+        for (int i = 0; i < fighterCount; i++) {
+            uint32_t team = static_cast<uint32_t>((i / 25) % 2);
+            double x = 600.0 * (i / 25) + 20.0 * (i % 25);
+            fight.addFighter(world.createBody(Vector2D(x, groundLevel), groundLevel), team);
+        }
+        if (!events) {
+            world.disableImpactEvents();
+        }
+        
+        size_t inFlight = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int tick = 0; tick < ticks; tick++) {
+            fight.step(timeStep);
+            inFlight += world.getProjectileCount();
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::printf("%-16s %8.3f ms/tick  %7zu in flight (mean)  %8zu throws  %8zu hits  %8zu misses  score %zu:%zu"
+                    "  %6.0f events/tick\n",
+                    events ? "impact events:" : "per-tick tests:", seconds * 1e3 / ticks, inFlight / ticks,
+                    fight.getThrows(), fight.getHits(), fight.getMisses(), fight.getScore(0), fight.getScore(1),
+                    static_cast<double>(world.getProcessedImpactEvents()) / ticks);
+    }
+    std::cout << "Short throws at pacing targets are predicted again most ticks, and pacing leaves no quiet" << std::endl
+              << "tick to skip: impact events pay off for long, quiet flights (--impact-bench), not here." << std::endl;
+}
+
+// N high lobs at static targets, landing over a minute or so: per-tick
+// tests, impact events, and jumping straight from one impact to the next
+void runImpactBench(int projectileCount) {
+    const double timeStep = 1.0 / 60.0;
+    const double groundLevel = 400.0;
+    std::printf("Projectiles: %d\n", projectileCount);
+    for (int mode = 0; mode < 3; mode++) {
+        World world;
+        world.setGravity(20.0);
+        std::mt19937 random(17);
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+        BodyHandle thrower = world.createBody(Vector2D(0.0, groundLevel), groundLevel);
+        for (int i = 0; i < projectileCount; i++) {
+            Vector2D start(unit(random) * 10000.0, groundLevel - 50.0);
+            CircleHandle target = world.createCircle(Vector2D(start.x + 200.0 + unit(random) * 400.0, groundLevel - 30.0), 20.0);
+            Vector2D velocity(10.0 + unit(random) * 10.0, -200.0 - unit(random) * 400.0);
+            world.createProjectile(ProjectileState{start, velocity, 5.0, groundLevel, target, thrower,
+                                                   ProjectileStatus::FLYING});
+        }
+        if (mode > 0) {
+            world.enableImpactEvents(0.0);
+        }
+        
+        uint64_t ticks = 0;
+        size_t calls = 0;
+        auto start = std::chrono::steady_clock::now();
+        while (world.getProjectileCount() > 0 && ticks < 100000) {
+            if (mode == 2) {
+                ticks += world.advanceToNextImpact(timeStep, 100000 - ticks);
+            } else {
+                world.step(timeStep);
+                ticks++;
+            }
+            calls++;
+            world.removeFinishedProjectiles();
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        WorldStats stats = world.getStats();
+        const char* names[] = {"per-tick tests", "impact events", "advance to impact"};
+        std::printf("  %-20s %9.3f ms  (%llu ticks in %zu calls, %zu hits, %zu misses, %zu events)\n", names[mode],
+                    seconds * 1e3, static_cast<unsigned long long>(ticks), calls, stats.projectileHits,
+                    stats.projectileMisses, world.getProcessedImpactEvents());
+    }
+}
+
+// N repeating per-body timers (0.1 to 10 s at 60 ticks a second): every
+// body counting down each tick against a timing wheel
+void runTimerBench(int timerCount, int ticks) {
+    std::mt19937 random(19);
+    std::uniform_int_distribution<uint64_t> period(6, 600);
+    std::vector<uint64_t> periods(timerCount);
+    for (uint64_t& ticksBetween : periods) {
+        ticksBetween = period(random);
+    }
+    
+    auto start = std::chrono::steady_clock::now();
+    std::vector<uint64_t> countdowns(periods);
+    size_t polledFired = 0;
+    for (int tick = 0; tick < ticks; tick++) {
+        for (size_t i = 0; i < countdowns.size(); i++) {
+            if (--countdowns[i] == 0) {
+                countdowns[i] = periods[i];
+                polledFired++;
+            }
+        }
+    }
+    double pollSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    start = std::chrono::steady_clock::now();
+    TimingWheel wheel;
+    for (size_t i = 0; i < periods.size(); i++) {
+        wheel.schedule(periods[i], i);
+    }
+    size_t wheelFired = 0;
+    for (int tick = 0; tick < ticks; tick++) {
+        wheel.advance(1);
+        for (const ExpiredTimer& due : wheel.getExpired()) {
+            wheel.schedule(periods[due.payload], due.payload);
+            wheelFired++;
+        }
+    }
+    double wheelSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    std::cout << "Timers: " << timerCount << ", ticks: " << ticks << std::endl;
+    std::printf("  %-20s %9.3f us/tick  (%zu fired)\n", "per-body countdown", pollSeconds * 1e6 / ticks, polledFired);
+    std::printf("  %-20s %9.3f us/tick  (%zu fired)\n", "timing wheel", wheelSeconds * 1e6 / ticks, wheelFired);
+}
+
+// One ballistic tick over N entities: a heap object per entity (as a
+// Circle with ballistics, allocated among other objects) against the
+// projectile archetype's chunked component arrays
+void runEcsBench(int entityCount) {
+    const double timeStep = 1.0 / 60.0;
+    const int passes = std::max(1, 20000000 / std::max(entityCount, 1));
+    std::mt19937 random(23);
+    
+    // Interleave other allocations so the objects end up scattered, as
+    // entities created over a session would
+    std::vector<std::unique_ptr<Circle>> objects;
+    std::vector<std::unique_ptr<char[]>> clutter;
+    for (int i = 0; i < entityCount; i++) {
+        objects.push_back(std::make_unique<Circle>(Vector2D(i, 0.0), 5.0));
+        objects.back()->setBallistics(Vector2D(10.0, -20.0), 9.8);
+        clutter.push_back(std::make_unique<char[]>(32 + random() % 512));
+    }
+    std::shuffle(objects.begin(), objects.end(), random);
+    auto start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < passes; pass++) {
+        for (const auto& object : objects) {
+            object->updatePosition(timeStep);
+        }
+    }
+    double objectSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    ProjectileArray projectiles;
+    for (int i = 0; i < entityCount; i++) {
+        projectiles.create(ProjectileState{Vector2D(i, 0.0), Vector2D(10.0, -20.0), 5.0, 400.0, CircleHandle(),
+                                           BodyHandle(), ProjectileStatus::FLYING});
+    }
+    start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < passes; pass++) {
+        projectiles.integrate(timeStep, 9.8);
+    }
+    double chunkSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    // Integration reads and writes position and velocity and reads the status
+    double bytes = static_cast<double>(entityCount) * passes *
+                   (2.0 * (sizeof(Transform) + sizeof(ProjectilePhysics)) + sizeof(ProjectileStatus));
+    std::cout << "Entities: " << entityCount << ", passes: " << passes << std::endl;
+    std::printf("  %-24s %7.2f ns/entity\n", "object per entity", objectSeconds * 1e9 / (double(entityCount) * passes));
+    std::printf("  %-24s %7.2f ns/entity  (%.1f GB/s of components)\n", "archetype chunks",
+                chunkSeconds * 1e9 / (double(entityCount) * passes), bytes / chunkSeconds * 1e-9);
+}
+
+// Job system overheads with the given number of workers: empty jobs
+// submitted and waited for, a chain of continuations, and a parallelFor
+// sum (nested inside jobs too) checked against the serial sum
+void runJobsBench(int workerCount) {
+    JobSystem jobs(static_cast<size_t>(workerCount));
+    const int jobCount = 100000;
+    
+    auto start = std::chrono::steady_clock::now();
+    std::atomic<int> ran{0};
+    std::vector<JobHandle> handles;
+    handles.reserve(jobCount);
+    for (int i = 0; i < jobCount; i++) {
+        handles.push_back(jobs.submit([&ran]() { ran++; }));
+    }
+    for (const JobHandle& handle : handles) {
+        jobs.wait(handle);
+    }
+    double submitSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    // Each link appends its number; they must come out in order
+    start = std::chrono::steady_clock::now();
+    std::vector<int> chain;
+    JobHandle previous = jobs.submit([&chain]() { chain.push_back(0); });
+    for (int i = 1; i < jobCount; i++) {
+        previous = jobs.submitAfter(std::span<const JobHandle>(&previous, 1), [&chain, i]() { chain.push_back(i); });
+    }
+    jobs.wait(previous);
+    double chainSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    bool chainInOrder = chain.size() == static_cast<size_t>(jobCount);
+    for (size_t i = 0; chainInOrder && i < chain.size(); i++) {
+        chainInOrder = chain[i] == static_cast<int>(i);
+    }
+    
+    std::vector<uint32_t> values(1 << 24);
+    std::mt19937 random(5);
+    for (uint32_t& value : values) {
+        value = random() % 1000;
+    }
+    start = std::chrono::steady_clock::now();
+    uint64_t serialSum = 0;
+    for (uint32_t value : values) {
+        serialSum += value;
+    }
+    double serialSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    start = std::chrono::steady_clock::now();
+    std::atomic<uint64_t> parallelSum{0};
+    jobs.parallelFor(0, values.size(), 1 << 16, [&](size_t first, size_t last) {
+        uint64_t sum = 0;
+        for (size_t i = first; i < last; i++) {
+            sum += values[i];
+        }
+        parallelSum += sum;
+    });
+    double parallelSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    // Jobs that each run a parallelFor of their own and wait inside it
+    std::atomic<uint64_t> nestedSum{0};
+    std::vector<JobHandle> outer;
+    const size_t quarter = values.size() / 4;
+    for (size_t part = 0; part < 4; part++) {
+        outer.push_back(jobs.submit([&, part]() {
+            jobs.parallelFor(part * quarter, (part + 1) * quarter, 1 << 14, [&](size_t first, size_t last) {
+                uint64_t sum = 0;
+                for (size_t i = first; i < last; i++) {
+                    sum += values[i];
+                }
+                nestedSum += sum;
+            });
+        }));
+    }
+    for (const JobHandle& handle : outer) {
+        jobs.wait(handle);
+    }
+    
+    std::cout << "Workers: " << jobs.getWorkerCount() << " (hardware threads: " << std::thread::hardware_concurrency()
+              << ")" << std::endl;
+    std::printf("  %-24s %7.3f us/job  (%d ran)\n", "submit + wait", submitSeconds * 1e6 / jobCount, ran.load());
+    std::printf("  %-24s %7.3f us/job  (%s)\n", "continuation chain", chainSeconds * 1e6 / jobCount,
+                chainInOrder ? "in order" : "OUT OF ORDER");
+    std::printf("  %-24s %7.3f ms serial, %7.3f ms parallelFor  (%s)\n", "sum of 16M values", serialSeconds * 1e3,
+                parallelSeconds * 1e3, parallelSum == serialSum ? "equal" : "DIFFERENT");
+    std::printf("  %-24s %s\n", "nested parallelFor", nestedSum == serialSum ? "equal" : "DIFFERENT");
+    std::printf("  %-24s %zu executed, %zu stolen\n", "jobs", jobs.getExecutedCount(), jobs.getStolenCount());
+}
+
+// One crowd world (walkers and a rain of projectiles) stepped on 1 to
+// maxThreads threads; every run must end in the same state, bit for bit
+void runTickBench(int bodyCount, int maxThreads) {
+    const int ticks = 200;
+    const double groundLevel = 400.0;
+    double baseSeconds = 0.0;
+    uint64_t baseChecksum = 0;
+    std::cout << "Bodies: " << bodyCount << ", ticks: " << ticks << std::endl;
+    for (int threads = 1; threads <= maxThreads; threads++) {
+        JobSystem jobs(static_cast<size_t>(threads - 1));
+        World world;
+        world.setJobSystem(&jobs);
+        std::vector<BodyHandle> bodies;
+        std::vector<CircleHandle> targets;
+        for (int i = 0; i < bodyCount; i++) {
+            double x = 1000.0 * (i / 100) + 3.0 * (i % 100);
+            bodies.push_back(world.createBody(Vector2D(x, groundLevel - 40.0), groundLevel));   // Feet on the ground
+            targets.push_back(world.createCircle(Vector2D(x + 400.0 + (i % 7) * 20.0, groundLevel - 50.0), 20.0));
+            world.addWalker(bodies.back(), targets.back());
+        }
+        
+        // FNV-1a over the bytes of everything the tick produced
+        uint64_t checksum = 1469598103934665603ull;
+        auto mix = [&checksum](const void* data, size_t size) {
+            const unsigned char* bytes = static_cast<const unsigned char*>(data);
+            for (size_t i = 0; i < size; i++) {
+                checksum = (checksum ^ bytes[i]) * 1099511628211ull;
+            }
+        };
+        std::mt19937 random(17);
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+        auto start = std::chrono::steady_clock::now();
+        for (int tick = 0; tick < ticks; tick++) {
+            world.removeFinishedProjectiles();
+            for (int i = 0; i < bodyCount / 2; i++) {
+                size_t thrower = random() % bodies.size();
+                Vector2D from = world.getBody(bodies[thrower])->getBasePosition() - Vector2D(0.0, 50.0);
+                world.createProjectile(ProjectileState{from, Vector2D(200.0 * (unit(random) - 0.3), -300.0 * unit(random)),
+                                                       5.0, groundLevel, targets[random() % targets.size()],
+                                                       bodies[thrower], ProjectileStatus::FLYING});
+            }
+            world.step(0.05);
+            for (const ProjectileImpact& impact : world.getImpacts()) {
+                mix(&impact.projectile, sizeof(impact.projectile));
+                mix(&impact.status, sizeof(impact.status));
+            }
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        
+        std::vector<Vector2D> positions(std::max(world.getBodyCount(), world.getProjectileCount()));
+        size_t count = world.getBodyBasePositions(positions);
+        mix(positions.data(), count * sizeof(Vector2D));
+        count = world.getProjectilePositions(positions);
+        mix(positions.data(), count * sizeof(Vector2D));
+        WorldStats stats = world.getStats();
+        mix(&stats.targetsCaught, sizeof(stats.targetsCaught));
+        mix(&stats.projectileHits, sizeof(stats.projectileHits));
+        
+        if (threads == 1) {
+            baseSeconds = seconds;
+            baseChecksum = checksum;
+        }
+        std::printf("  %2d threads %8.3f ms/tick  x%5.2f  checksum %016llx %s\n", threads, seconds * 1e3 / ticks,
+                    baseSeconds / seconds, static_cast<unsigned long long>(checksum),
+                    checksum == baseChecksum ? "(same)" : "(DIFFERENT)");
+    }
+}
+
+// Sleeps a few ticks, now and then waits on a condition instead, forever;
+// the scheduler is its first parameter, so its frame comes from the pool
+Behaviour idleLoop(BehaviourScheduler& scheduler, uint32_t seed, uint64_t* wakeups) {
+    std::minstd_rand random(seed);
+    while (true) {
+        if (random() % 8 == 0) {
+            uint64_t until = scheduler.getTickCount() + 1 + random() % 16;
+            co_await scheduler.until([&scheduler, until]() { return scheduler.getTickCount() >= until; });
+        } else {
+            co_await scheduler.ticks(1 + random() % 16);
+        }
+        ++*wakeups;
+    }
+}
+
+// The same with its frame from the heap (the scheduler is neither first nor second)
+Behaviour idleLoopOnHeap(uint32_t seed, uint64_t* wakeups, BehaviourScheduler& scheduler) {
+    std::minstd_rand random(seed);
+    while (true) {
+        co_await scheduler.ticks(1 + random() % 16);
+        ++*wakeups;
+    }
+}
+
+// N idle behaviours resumed over many ticks, frame allocation from the
+// pool against the heap, then walkers and throwers written as behaviours
+void runBehaviourBench(int behaviourCount, int ticks) {
+    // Frames that miss the pool come from the default resource: count them there
+    CountingResource frames(std::pmr::get_default_resource());
+    std::pmr::memory_resource* previous = std::pmr::set_default_resource(&frames);
+    BehaviourScheduler scheduler(1.0 / 60.0);
+    uint64_t wakeups = 0;
+    std::vector<BehaviourHandle> handles;
+    for (int i = 0; i < behaviourCount; i++) {
+        handles.push_back(scheduler.spawn(idleLoop(scheduler, i + 1, &wakeups)));
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (int tick = 0; tick < ticks; tick++) {
+        scheduler.tick();
+    }
+    double tickSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    size_t resumes = scheduler.getResumeCount() - behaviourCount;
+    
+    // Cancel and spawn again: frames of one shape come back out of the pool
+    auto respawn = [&](auto&& make) {
+        for (BehaviourHandle handle : handles) {
+            scheduler.cancel(handle);
+        }
+        handles.clear();
+        size_t allocationsBefore = frames.getAllocationCount();
+        auto begin = std::chrono::steady_clock::now();
+        for (int i = 0; i < behaviourCount; i++) {
+            handles.push_back(scheduler.spawn(make(i + 1)));
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        return std::make_pair(seconds, frames.getAllocationCount() - allocationsBefore);
+    };
+    auto [pooledSeconds, pooledAllocations] = respawn([&](int seed) { return idleLoop(scheduler, seed, &wakeups); });
+    auto [heapSeconds, heapAllocations] = respawn([&](int seed) { return idleLoopOnHeap(seed, &wakeups, scheduler); });
+    std::pmr::set_default_resource(previous);
+    
+    std::cout << "Behaviours: " << behaviourCount << ", ticks: " << ticks << std::endl;
+    std::printf("  %-24s %8.1f us/tick, %6.1f ns/resume  (%zu resumes)\n", "ticks", tickSeconds * 1e6 / ticks,
+                tickSeconds * 1e9 / std::max<size_t>(resumes, 1), resumes);
+    std::printf("  %-24s %8.1f ns/spawn  (%zu allocations)\n", "respawn, pooled frames",
+                pooledSeconds * 1e9 / behaviourCount, pooledAllocations);
+    std::printf("  %-24s %8.1f ns/spawn  (%zu allocations)\n", "respawn, heap frames",
+                heapSeconds * 1e9 / behaviourCount, heapAllocations);
+    
+    // Walkers and throwers as behaviours in one world
+    World world;
+    BehaviourScheduler bodies(0.1);
+    const double groundLevel = 400.0;
+    const int bodyCount = 200;
+    const int walkerCount = bodyCount / 2;
+    std::unique_ptr<bool[]> caught(new bool[walkerCount]());
+    size_t hits = 0;
+    for (int i = 0; i < bodyCount; i++) {
+        double x = 1000.0 * i;
+        double shoulderHeight = groundLevel - Body::kStandingHeight - 60.0;
+        BodyHandle body = world.createBody(Vector2D(x, groundLevel - Body::kStandingHeight), groundLevel);
+        CircleHandle target = world.createCircle(Vector2D(x + 300.0 + (i % 7) * 20.0, shoulderHeight), 20.0);
+        if (i % 2 == 0) {
+            bodies.spawn(walkAndCatch(bodies, world, body, target, 5.0, &caught[i / 2]));
+        } else {
+            bodies.spawn(throwVolleys(bodies, world, body, target, 3, 1.0, &hits));
+        }
+    }
+    int tick = 0;
+    for (; tick < 2000 && bodies.size() > 0; tick++) {
+        world.step(bodies.getTimeStep());
+        bodies.tick();
+        world.removeFinishedProjectiles();
+    }
+    std::cout << "World: " << walkerCount << " walkers caught " << std::count(caught.get(), caught.get() + walkerCount, true)
+              << ", " << bodyCount / 2 << " throwers hit " << hits << " of " << 3 * bodyCount / 2
+              << " (all done after " << tick << " ticks)" << std::endl;
+}
+
+// Input threads sending key presses while the simulation thread steps a
+// crowd: applied inline under the simulation's lock, then pushed on a
+// command queue and drained at tick boundaries
+void runCommandBench(int producerCount, int commandCount) {
+    const double groundLevel = 400.0;
+    const int crowdSize = 2000;
+    const char keys[] = {'s', 's', 's', 'w', 's', 'b', 'r'};
+    
+    auto run = [&](bool queued) {
+        World world;
+        for (int i = 0; i < crowdSize; i++) {
+            double x = 1000.0 * i;
+            BodyHandle walker = world.createBody(Vector2D(x, groundLevel - 40.0), groundLevel);
+            world.addWalker(walker, world.createCircle(Vector2D(x + 900.0, groundLevel - 50.0), 20.0));
+        }
+        BodyHandle body = world.createBody(Vector2D(-500.0, groundLevel - 40.0), groundLevel);
+        CircleHandle target = world.createCircle(Vector2D(-100.0, groundLevel - 50.0), 20.0);
+        std::unique_ptr<MovementStrategy> strategy;
+        auto apply = [&](const SimulationCommand& command) {
+            switch (command.type) {
+                case CommandType::WALKER_MODE:
+                case CommandType::RESET: {
+                    auto walker = std::make_unique<WalkerStrategy>(world, body, target);
+                    walker->planSequence(world.getCircle(target)->getCenter());
+                    strategy = std::move(walker);
+                    break;
+                }
+                case CommandType::SNOWBALL_MODE: {
+                    auto snowball = std::make_unique<SnowballStrategy>(world, body, target);
+                    snowball->planSequence();
+                    strategy = std::move(snowball);
+                    break;
+                }
+                case CommandType::STEP:
+                    if (strategy && !strategy->isSequenceComplete()) {
+                        strategy->executeNextMove();
+                    }
+                    break;
+            }
+        };
+        
+        SimulationCommandQueue commands(256);
+        std::mutex simulationLock;      // Inline input applies under it
+        std::atomic<int> producersLeft(producerCount);
+        std::vector<std::vector<int64_t>> inputCosts(producerCount);
+        std::vector<int64_t> applyLatencies;
+        std::vector<int64_t> tickTimes;
+        
+        std::vector<std::thread> producers;
+        for (int p = 0; p < producerCount; p++) {
+            producers.emplace_back([&, p] {
+                for (int i = p; i < commandCount; i += producerCount) {
+                    SimulationCommand command;
+                    parseCommand(keys[i % (sizeof(keys) / sizeof(keys[0]))], command);
+                    if (queued) {
+                        while (!commands.tryPush(command)) {
+                            std::this_thread::yield();
+                        }
+                    } else {
+                        std::lock_guard<std::mutex> lock(simulationLock);
+                        apply(command);
+                    }
+                    inputCosts[p].push_back(getCommandClock() - command.issuedAt);
+                    std::this_thread::sleep_for(std::chrono::microseconds(200));
+                }
+                producersLeft--;
+            });
+        }
+        
+        // The simulation thread: commands at the tick boundary, then the tick
+        while (producersLeft > 0 || commands.size() > 0) {
+            int64_t tickStart = getCommandClock();
+            std::lock_guard<std::mutex> lock(simulationLock);
+            commands.drain([&](const SimulationCommand& command) {
+                apply(command);
+                applyLatencies.push_back(getCommandClock() - command.issuedAt);
+            });
+            world.step(1.0 / 60.0);
+            tickTimes.push_back(getCommandClock() - tickStart);
+        }
+        for (std::thread& producer : producers) {
+            producer.join();
+        }
+        
+        std::vector<int64_t> costs;
+        for (const std::vector<int64_t>& perProducer : inputCosts) {
+            costs.insert(costs.end(), perProducer.begin(), perProducer.end());
+        }
+        auto report = [](const char* label, std::vector<int64_t>& values) {
+            if (values.empty()) {
+                return;
+            }
+            std::sort(values.begin(), values.end());
+            double total = 0.0;
+            for (int64_t value : values) {
+                total += static_cast<double>(value);
+            }
+            std::printf("  %-30s mean %9.1f us, p99 %9.1f us, max %9.1f us\n", label, total / values.size() / 1e3,
+                        values[values.size() * 99 / 100] / 1e3, values.back() / 1e3);
+        };
+        std::cout << (queued ? "Queued at tick boundaries:" : "Applied inline under the simulation lock:") << std::endl;
+        report("input thread, per key press", costs);
+        report("key press to applied", applyLatencies);
+        report("tick", tickTimes);
+        if (queued) {
+            std::cout << "  dropped: " << commands.getDroppedCount() << " (retried)" << std::endl;
+        }
+    };
+    
+    std::cout << "Producers: " << producerCount << ", commands: " << commandCount << ", crowd: " << crowdSize
+              << " walkers" << std::endl;
+    run(false);
+    run(true);
+}
+
+// Every point kernel on every instruction set this CPU has, against the
+// scalar classes: the largest rounding difference over lengths around the
+// vector widths (so every tail path runs), whether anything past the end
+// was written, and the time per point on pointCount points
+template <typename Scalar>
+void checkPointKernels(const char* scalarName, int pointCount) {
+    using Vec = BasicVector2D<Scalar>;
+    const size_t lengths[] = {0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 33, static_cast<size_t>(pointCount)};
+    const size_t capacity = std::max<size_t>(pointCount, 33) + 1;
+    const Scalar guard = Scalar(12345.0);
+    std::mt19937 random(55);
+    std::uniform_real_distribution<double> coordinate(-500.0, 500.0), angle(-4 * M_PI, 4 * M_PI), unit(0.0, 1.0);
+    
+    // Inputs, with the reference segments' own endpoints so both sides measure the same ones
+    std::vector<Scalar> xs(capacity), ys(capacity), angles(capacity), centers(capacity), halfWidths(capacity);
+    std::vector<Scalar> ends[8];
+    std::vector<BasicSegment<Scalar>> segments[2];
+    for (size_t i = 0; i < capacity; i++) {
+        xs[i] = static_cast<Scalar>(coordinate(random));
+        ys[i] = static_cast<Scalar>(coordinate(random));
+        angles[i] = static_cast<Scalar>(angle(random));
+        centers[i] = static_cast<Scalar>(M_PI * (2 * unit(random) - 1));
+        halfWidths[i] = static_cast<Scalar>(M_PI * unit(random));
+        for (int k = 0; k < 2; k++) {
+            Vec start(static_cast<Scalar>(coordinate(random)), static_cast<Scalar>(coordinate(random)));
+            segments[k].emplace_back("reference", start, static_cast<Scalar>(100.0 * unit(random)),
+                                     static_cast<Scalar>(M_PI * (2 * unit(random) - 1)), Scalar(-M_PI), Scalar(M_PI));
+            ends[4 * k].push_back(segments[k].back().getStart().x);
+            ends[4 * k + 1].push_back(segments[k].back().getStart().y);
+            ends[4 * k + 2].push_back(segments[k].back().getEnd().x);
+            ends[4 * k + 3].push_back(segments[k].back().getEnd().y);
+        }
+    }
+    const Vec offset(Scalar(3.25), Scalar(-7.5)), point(Scalar(40.0), Scalar(-25.0));
+    const Scalar rotation = Scalar(0.7), factor = Scalar(1.5), radius = Scalar(250.0);
+    const BasicSegment<Scalar>& segment = segments[0][0];
+    const BasicCircle<Scalar> circle(point, radius);
+    
+    // run(n, outputs) applies the kernel to the first n points; check(i, outputs)
+    // is its error against the reference at point i
+    struct Kernel {
+        const char* name;
+        std::function<void(size_t, std::vector<Scalar>&, std::vector<Scalar>&)> run;
+        std::function<double(size_t, const std::vector<Scalar>&, const std::vector<Scalar>&)> check;
+    };
+    auto error = [](Scalar got, Scalar want) {
+        double difference = std::abs(static_cast<double>(got) - static_cast<double>(want));
+        return difference / std::max(1.0, std::abs(static_cast<double>(want)));
+    };
+    std::vector<unsigned char> inside(capacity);
+    SegmentArrays<Scalar> pairA{ends[0], ends[1], ends[2], ends[3]}, pairB{ends[4], ends[5], ends[6], ends[7]};
+    Kernel kernels[] = {
+        {"translate",
+         [&](size_t n, auto& a, auto& b) { translatePoints(std::span(a).first(n), std::span(b).first(n), offset); },
+         [&](size_t i, const auto& a, const auto& b) {
+             Vec want = Vec(xs[i], ys[i]) + offset;
+             return std::max(error(a[i], want.x), error(b[i], want.y));
+         }},
+        {"rotate",
+         [&](size_t n, auto& a, auto& b) { rotatePoints(std::span(a).first(n), std::span(b).first(n), rotation); },
+         [&](size_t i, const auto& a, const auto& b) {
+             Vec want = Vec(xs[i], ys[i]).rotate(rotation);
+             return std::max(error(a[i], want.x), error(b[i], want.y));
+         }},
+        {"scale",
+         [&](size_t n, auto& a, auto& b) { scalePoints(std::span(a).first(n), std::span(b).first(n), factor); },
+         [&](size_t i, const auto& a, const auto& b) {
+             Vec want = Vec(xs[i], ys[i]) * factor;
+             return std::max(error(a[i], want.x), error(b[i], want.y));
+         }},
+        {"dot",
+         [&](size_t n, auto& a, auto&) {
+             dotPoints<Scalar>(std::span(xs).first(n), std::span(ys).first(n), offset, std::span(a).first(n));
+         },
+         [&](size_t i, const auto& a, const auto&) { return error(a[i], Vec(xs[i], ys[i]).dot(offset)); }},
+        {"distance to point",
+         [&](size_t n, auto& a, auto&) {
+             distancesToPoint<Scalar>(std::span(xs).first(n), std::span(ys).first(n), point, std::span(a).first(n));
+         },
+         [&](size_t i, const auto& a, const auto&) { return error(a[i], Vec(xs[i], ys[i]).distance(point)); }},
+        {"distance to segment",
+         [&](size_t n, auto& a, auto&) {
+             distancesToSegment<Scalar>(std::span(xs).first(n), std::span(ys).first(n), segment.getStart(),
+                                        segment.getEnd(), std::span(a).first(n));
+         },
+         [&](size_t i, const auto& a, const auto&) { return error(a[i], segment.distanceToPoint(Vec(xs[i], ys[i]))); }},
+        {"points in circle",
+         [&](size_t n, auto&, auto&) {
+             pointsInCircle<Scalar>(std::span(xs).first(n), std::span(ys).first(n), point, radius,
+                                    std::span(inside).first(n));
+         },
+         [&](size_t i, const auto&, const auto&) {
+             return (inside[i] != 0) == circle.contains(Vec(xs[i], ys[i])) ? 0.0 : 1.0;
+         }},
+        {"sinCos",
+         [&](size_t n, auto& a, auto& b) {
+             sinCosAngles<Scalar>(std::span(angles).first(n), std::span(a).first(n), std::span(b).first(n));
+         },
+         [&](size_t i, const auto& a, const auto& b) {
+             SinCos<Scalar> want = sinCos(angles[i]);
+             return std::max(error(a[i], want.sin), error(b[i], want.cos));
+         }},
+        {"clamp angles",
+         [&](size_t n, auto& a, auto&) {
+             std::copy(angles.begin(), angles.begin() + n, a.begin());
+             clampAngles<Scalar>(std::span(a).first(n), std::span(centers).first(n), std::span(halfWidths).first(n));
+         },
+         [&](size_t i, const auto& a, const auto&) {
+             return error(a[i], BasicJointLimits<Scalar>{centers[i], halfWidths[i]}.clamp(angles[i]));
+         }},
+        {"segment pair distance",
+         [&](size_t n, auto& a, auto&) {
+             SegmentArrays<Scalar> firstA{pairA.startXs.first(n), pairA.startYs.first(n), pairA.endXs.first(n),
+                                          pairA.endYs.first(n)};
+             SegmentArrays<Scalar> firstB{pairB.startXs.first(n), pairB.startYs.first(n), pairB.endXs.first(n),
+                                          pairB.endYs.first(n)};
+             segmentPairDistancesSquared(firstA, firstB, std::span(a).first(n));
+         },
+         [&](size_t i, const auto& a, const auto&) {
+             return error(a[i], segments[0][i].distanceSquaredToSegment(segments[1][i]));
+         }},
+    };
+    
+    const char* instructionSets[] = {"portable", "sse2", "avx2"};
+    const char* detected = getPointKernelInstructionSet();
+    std::vector<Scalar> a(capacity), b(capacity);
+    for (const char* instructionSet : instructionSets) {
+        if (!setPointKernelInstructionSet(instructionSet)) {
+            std::printf("  %-6s %-9s not supported by this CPU\n", scalarName, instructionSet);
+            continue;
+        }
+        for (Kernel& kernel : kernels) {
+            double worst = 0.0;
+            bool tailsIntact = true;
+            for (size_t n : lengths) {
+                // In-place kernels start from the inputs; the guard past n must survive
+                std::copy(xs.begin(), xs.begin() + n, a.begin());
+                std::copy(ys.begin(), ys.begin() + n, b.begin());
+                a[n] = guard;
+                b[n] = guard;
+                inside[n] = 7;
+                kernel.run(n, a, b);
+                for (size_t i = 0; i < n; i++) {
+                    worst = std::max(worst, kernel.check(i, a, b));
+                }
+                tailsIntact = tailsIntact && a[n] == guard && b[n] == guard && inside[n] == 7;
+            }
+            
+            int repeats = std::max(1, 4000000 / pointCount);
+            auto start = std::chrono::steady_clock::now();
+            for (int r = 0; r < repeats; r++) {
+                kernel.run(pointCount, a, b);
+            }
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            std::printf("  %-6s %-9s %-22s %8.2f eps  %-13s %7.2f ns/point\n", scalarName, instructionSet, kernel.name,
+                        worst / std::numeric_limits<Scalar>::epsilon(), tailsIntact ? "tails intact" : "TAIL WRITTEN",
+                        seconds * 1e9 / (static_cast<double>(repeats) * pointCount));
+        }
+    }
+    setPointKernelInstructionSet(detected);
+}
+
+void runKernelCheck(int pointCount) {
+    std::cout << "Points: " << pointCount << ", dispatched to " << getPointKernelInstructionSet()
+              << "; error is the largest relative difference from the scalar classes" << std::endl;
+    checkPointKernels<float>("float", pointCount);
+    checkPointKernels<double>("double", pointCount);
+}
+
+// Largest sinCos error against std::sin/std::cos (in long double) over N
+// evenly spaced angles in [low, high], and the time per call of both
+template <typename Scalar>
+void sweepSinCos(const char* scalarName, const char* rangeName, double low, double high, int angleCount) {
+    std::vector<Scalar> angles(angleCount);
+    for (int i = 0; i < angleCount; i++) {
+        angles[i] = static_cast<Scalar>(low + (high - low) * i / std::max(angleCount - 1, 1));
+    }
+    long double sinError = 0, cosError = 0;
+    Scalar worstAngle = 0;
+    for (Scalar angle : angles) {
+        SinCos<Scalar> got = sinCos(angle);
+        long double wantSin = std::sin(static_cast<long double>(angle));
+        long double wantCos = std::cos(static_cast<long double>(angle));
+        long double error = std::max(std::abs(got.sin - wantSin), std::abs(got.cos - wantCos));
+        if (error > std::max(sinError, cosError)) {
+            worstAngle = angle;
+        }
+        sinError = std::max(sinError, std::abs(got.sin - wantSin));
+        cosError = std::max(cosError, std::abs(got.cos - wantCos));
+    }
+    
+    auto timeCalls = [&](auto&& evaluate) {
+        Scalar sum = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (Scalar angle : angles) {
+            SinCos<Scalar> value = evaluate(angle);
+            sum += value.sin + value.cos;
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        volatile Scalar keep = sum;     // The loop must not be optimized away
+        (void)keep;
+        return seconds * 1e9 / angleCount;
+    };
+    double polynomialNs = timeCalls([](Scalar angle) { return sinCos(angle); });
+    double libmNs = timeCalls([](Scalar angle) { return SinCos<Scalar>{std::sin(angle), std::cos(angle)}; });
+    std::printf("  %-6s %-16s sin %.1e  cos %.1e  %5.1f ns/call, std %5.1f ns/call  (worst at %.6g)\n",
+                scalarName, rangeName, static_cast<double>(sinError), static_cast<double>(cosError),
+                polynomialNs, libmNs, static_cast<double>(worstAngle));
+}
+
+void runTrigCheck(int angleCount) {
+    // The widest arc any segment of the default humanoid may turn through
+    Body body(Vector2D(0.0, 0.0), 0.0);
+    double low = 0.0, high = 0.0;
+    for (size_t i = 0; i < body.getSegmentCount(); i++) {
+        low = std::min<double>(low, body.getSegmentAt(i).getMinAngle());
+        high = std::max<double>(high, body.getSegmentAt(i).getMaxAngle());
+    }
+    std::cout << "Angles: " << angleCount << " per range; joint limits span [" << low << ", " << high << "]"
+#ifdef OOCATCHER_LIBM_TRIG
+              << " (OOCATCHER_LIBM_TRIG: sinCos is std::sin/std::cos)"
+#endif
+              << std::endl;
+    sweepSinCos<float>("float", "joint limits", low, high, angleCount);
+    sweepSinCos<double>("double", "joint limits", low, high, angleCount);
+    sweepSinCos<float>("float", "|angle| <= 1e3", -1e3, 1e3, angleCount);
+    sweepSinCos<double>("double", "|angle| <= 1e3", -1e3, 1e3, angleCount);
+}
+
+// What one precision made of a walk-reach-catch and a throw
+template <typename Scalar>
+struct PrecisionOutcome {
+    bool caught;
+    bool hit;
+    BasicVector2D<Scalar> hand;         // Right hand after the reach
+    BasicVector2D<Scalar> snowball;     // Where the throw ended
+};
+
+// The walker and snowball scenario on the core types of one precision:
+// walk along hilly ground to arm's reach, reach with both arms as
+// WalkerStrategy does, then throw from the base as SnowballStrategy does
+template <typename Scalar>
+PrecisionOutcome<Scalar> runPrecisionScenario(const std::vector<double>& heights, double startX,
+                                              const BasicVector2D<double>& targetCenter) {
+    using Vec = BasicVector2D<Scalar>;
+    const Scalar walkSpeed = 5.0, spacing = 20.0, gravity = 9.81, snowballRadius = 10.0;
+    BasicTerrain<Scalar> terrain(0, spacing, std::vector<Scalar>(heights.begin(), heights.end()));
+    Scalar standing = static_cast<Scalar>(Body::kStandingHeight);
+    Scalar x = static_cast<Scalar>(startX);
+    BasicBody<Scalar> body(Vec(x, terrain.getHeightAt(x) - standing), terrain.getHeightAt(x));
+    body.setTerrain(terrain);
+    BasicCircle<Scalar> target(BasicVector2D<Scalar>(targetCenter), 20.0);
+    
+    Scalar reach = WalkerStrategy::getReachDistance(body);
+    while (target.getCenter().x - body.getBasePosition().x > reach) {
+        Scalar stride = std::min(walkSpeed, target.getCenter().x - body.getBasePosition().x - reach);
+        Scalar next = body.getBasePosition().x + stride;
+        body.moveBaseTo(Vec(next, terrain.getHeightAt(next) - standing));
+    }
+    for (size_t arm = 0; arm < WalkerStrategy::kArmCount; arm++) {
+        WalkerStrategy::reachWithArm(body, arm, target.getCenter());
+    }
+    
+    PrecisionOutcome<Scalar> outcome;
+    outcome.caught = body.canReachObject(target, WalkerStrategy::kArmCount);
+    outcome.hand = body.getSegment("right_hand")->getEnd();
+    outcome.hit = false;
+    
+    Vec position = body.getBasePosition() - Vec(0, 50);
+    Vec delta = target.getCenter() - position;
+    Scalar time = std::sqrt(2 * delta.x / gravity);
+    Vec velocity(delta.x / time, -gravity * time / 2 + delta.y / time);
+    Vec bottom(0, snowballRadius);
+    for (int step = 0; step < 1000; step++) {
+        Vec previous = position;
+        velocity.y += gravity * Scalar(0.1);
+        position = position + velocity * Scalar(0.1);
+        Scalar impact;
+        if (terrain.intersectSegment(previous + bottom, position + bottom, impact)) {
+            break;
+        }
+        if ((position - target.getCenter()).magnitude() <= snowballRadius + target.getRadius()) {
+            outcome.hit = true;
+            break;
+        }
+    }
+    outcome.snowball = position;
+    return outcome;
+}
+
+// Turn every segment to a random angle inside its joint limits (away from
+// the ends, so each angle can move both ways)
+void randomizePose(Body& body, std::mt19937& rng) {
+    std::uniform_real_distribution<double> inside(0.1, 0.9);
+    for (size_t i = 0; i < body.getSegmentCount(); i++) {
+        const Segment& segment = body.getSegmentAt(i);
+        double angle = segment.getMinAngle() + (segment.getMaxAngle() - segment.getMinAngle()) * inside(rng);
+        body.rotateSegmentTo(body.getSegmentName(i), static_cast<Real>(angle));
+    }
+}
+
+// Turn every segment by up to spread radians either way (within its limits)
+void perturbPose(Body& body, double spread, std::mt19937& rng) {
+    std::uniform_real_distribution<double> turn(-spread, spread);
+    for (size_t i = 0; i < body.getSegmentCount(); i++) {
+        Real angle = body.getSegmentAt(i).getAngle();
+        body.rotateSegmentTo(body.getSegmentName(i), angle + static_cast<Real>(turn(rng)));
+    }
+}
+
+// Solve one problem per lane: each lane starts from the same pose and
+// chases the effector positions of a reachable pose, either that pose
+// turned by up to spread radians per joint or (spread 0) a random one
+void checkIkBatch(const char* name, const std::vector<std::string>& effectors, double spread,
+                  int laneCount, std::mt19937& rng) {
+    Body initial(Vector2D(0.0, 360.0), 400.0);
+    std::mt19937 initialRng(52);
+    randomizePose(initial, initialRng);
+    std::vector<std::shared_ptr<Body>> bodies;
+    std::vector<Vector2D> goals;
+    for (int lane = 0; lane < laneCount; lane++) {
+        Body reference(Vector2D(0.0, 360.0), 400.0);
+        if (spread > 0) {
+            for (size_t i = 0; i < initial.getSegmentCount(); i++) {
+                reference.rotateSegmentTo(initial.getSegmentName(i), initial.getSegmentAt(i).getAngle());
+            }
+            perturbPose(reference, spread, rng);
+        } else {
+            randomizePose(reference, rng);
+        }
+        for (const std::string& effector : effectors) {
+            goals.push_back(reference.getSegment(effector)->getEnd());
+        }
+        bodies.push_back(std::make_shared<Body>(Vector2D(0.0, 360.0), 400.0));
+        for (size_t i = 0; i < initial.getSegmentCount(); i++) {
+            bodies.back()->rotateSegmentTo(initial.getSegmentName(i), initial.getSegmentAt(i).getAngle());
+        }
+    }
+    
+    BodyBatch batch(bodies);
+    IKSolver solver;
+    auto start = std::chrono::steady_clock::now();
+    std::vector<IKResult> results = solver.solveBatch(batch, effectors, goals);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    int converged = 0;
+    double iterations = 0.0, worstError = 0.0;
+    for (const IKResult& result : results) {
+        converged += result.converged ? 1 : 0;
+        iterations += result.iterations;
+        worstError = std::max(worstError, result.maxError);
+    }
+    std::printf("  %-14s %5d/%-5d converged  %5.1f iterations  worst error %.3g  (%.2f us/problem)\n",
+                name, converged, laneCount, iterations / laneCount, worstError, seconds * 1e6 / laneCount);
+}
+
+void runIkCheck(int poseCount) {
+    // Dual-number gradients against central differences of the same body
+    const std::vector<std::string> effectors = {"left_hand", "right_hand", "head", "left_foot"};
+    const Real step = std::is_same_v<Real, float> ? Real(1e-2) : Real(1e-5);
+    std::mt19937 rng(51);
+    double worstGradient = 0.0, largestGradient = 0.0;
+    for (int pose = 0; pose < poseCount; pose++) {
+        Body body(Vector2D(0.0, 360.0), 400.0);
+        randomizePose(body, rng);
+        std::vector<EndEffectorGradient> gradients = computeEndEffectorGradients(body, effectors);
+        for (const EndEffectorGradient& gradient : gradients) {
+            for (size_t j = 0; j < gradient.jointNames.size(); j++) {
+                const std::string& joint = gradient.jointNames[j];
+                Real angle = body.getSegment(joint)->getAngle();
+                body.rotateSegmentTo(joint, angle + step);
+                Vector2D ahead = body.getSegment(gradient.segmentName)->getEnd();
+                body.rotateSegmentTo(joint, angle - step);
+                Vector2D behind = body.getSegment(gradient.segmentName)->getEnd();
+                body.rotateSegmentTo(joint, angle);
+                Vector2D difference = (ahead - behind) / (2 * step);
+                worstGradient = std::max<double>(worstGradient, (difference - gradient.jointGradients[j]).magnitude());
+                largestGradient = std::max<double>(largestGradient, gradient.jointGradients[j].magnitude());
+            }
+        }
+    }
+    std::printf("Gradients: %d poses x %zu effectors; largest |d end / d angle| %.1f, "
+                "worst difference from central differences %.2g\n",
+                poseCount, effectors.size(), largestGradient, worstGradient);
+    
+    // Damped least squares on a batch, one problem per lane: goals near the
+    // start pose (tracking), then anywhere the skeleton can reach
+    const std::vector<std::string> oneHand = {"right_hand"};
+    const std::vector<std::string> bothHands = {"left_hand", "right_hand"};
+    const std::vector<std::string> handsAndFeet = {"left_hand", "right_hand", "left_foot", "right_foot"};
+    std::cout << "IK batches of " << poseCount << " lanes, goals from the start pose turned by up to 0.5 rad per joint:"
+              << std::endl;
+    checkIkBatch("right hand", oneHand, 0.5, poseCount, rng);
+    checkIkBatch("both hands", bothHands, 0.5, poseCount, rng);
+    checkIkBatch("hands and feet", handsAndFeet, 0.5, poseCount, rng);
+    std::cout << "IK batches of " << poseCount << " lanes, goals from random reachable poses "
+              << "(DLS is local: far goals can stall against the joint limits):" << std::endl;
+    checkIkBatch("right hand", oneHand, 0.0, poseCount, rng);
+    checkIkBatch("both hands", bothHands, 0.0, poseCount, rng);
+    checkIkBatch("hands and feet", handsAndFeet, 0.0, poseCount, rng);
+}
+
+// The same scenarios in float and in double: where do the outcomes part?
+void runPrecisionCheck(int scenarioCount) {
+    std::mt19937 random(53);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    int catches[2] = {0, 0}, hits[2] = {0, 0};
+    int catchDivergences = 0, hitDivergences = 0;
+    double maxHandError = 0.0, maxSnowballError = 0.0;
+    for (int i = 0; i < scenarioCount; i++) {
+        // Rolling ground, and a target around shoulder height where the
+        // walker will stop: some just in reach, some just out of it
+        std::vector<double> heights(100);
+        double phase = 6.3 * unit(random);
+        for (size_t k = 0; k < heights.size(); k++) {
+            heights[k] = 400.0 + 15.0 * std::sin(0.3 * k + phase);
+        }
+        double startX = 100.0 + 100.0 * unit(random);
+        double targetX = startX + 200.0 + 1000.0 * unit(random);
+        double shoulder = 400.0 + 15.0 * std::sin(0.3 * (targetX - 90.0) / 20.0 + phase) - Body::kStandingHeight - 60.0;
+        BasicVector2D<double> center(targetX, shoulder + 40.0 * (unit(random) - 0.5));
+        
+        PrecisionOutcome<float> single = runPrecisionScenario<float>(heights, startX, center);
+        PrecisionOutcome<double> full = runPrecisionScenario<double>(heights, startX, center);
+        catches[0] += single.caught;
+        catches[1] += full.caught;
+        hits[0] += single.hit;
+        hits[1] += full.hit;
+        catchDivergences += single.caught != full.caught;
+        hitDivergences += single.hit != full.hit;
+        maxHandError = std::max(maxHandError, (BasicVector2D<double>(single.hand) - full.hand).magnitude());
+        maxSnowballError = std::max(maxSnowballError, (BasicVector2D<double>(single.snowball) - full.snowball).magnitude());
+    }
+    std::cout << "Scenarios: " << scenarioCount << std::endl;
+    std::printf("  %-10s %8s %8s\n", "", "float", "double");
+    std::printf("  %-10s %8d %8d   (%d diverge)\n", "caught", catches[0], catches[1], catchDivergences);
+    std::printf("  %-10s %8d %8d   (%d diverge)\n", "hit", hits[0], hits[1], hitDivergences);
+    std::printf("  Largest position difference: hand %.2e, snowball %.2e\n", maxHandError, maxSnowballError);
+}
+
+// Run a crowd of walkers and snowball throwers in one world and time the ticks
+void runCrowd(int walkerCount, int ticks) {
+    // Bodies are created back to back, so a monotonic arena keeps each
+    // body's segments next to each other in memory
+    std::pmr::monotonic_buffer_resource arena;
+    World world(&arena);
+    const double groundLevel = 400.0;
+    
+    // Each walker chases its own target; every eighth body throws instead
+    std::vector<BodyHandle> throwers;
+    std::vector<CircleHandle> throwerTargets;
+    std::vector<CircleHandle> targets;
+    for (int i = 0; i < walkerCount; i++) {
+        double lane = 1000.0 * (i / 100);
+        double x = lane + 3.0 * (i % 100);
+        // Feet on the ground, the target at shoulder height where both hands can close on it
+        BodyHandle body = world.createBody(Vector2D(x, groundLevel - Body::kStandingHeight), groundLevel);
+        double shoulderHeight = groundLevel - Body::kStandingHeight - 60.0;
+        CircleHandle target = world.createCircle(Vector2D(x + 400.0 + (i % 7) * 20.0, shoulderHeight), 20.0);
+        targets.push_back(target);
+        if (i % 8 == 7) {
+            throwers.push_back(body);
+            throwerTargets.push_back(target);
+        } else {
+            world.addWalker(body, target);
+        }
+    }
+    
+    auto start = std::chrono::steady_clock::now();
+    for (int tick = 0; tick < ticks; tick++) {
+        // Throwers throw again once their snowball has landed
+        world.removeFinishedProjectiles();
+        if (world.getProjectileCount() == 0) {
+            for (size_t t = 0; t < throwers.size(); t++) {
+                world.throwSnowball(throwers[t], throwerTargets[t]);
+            }
+        }
+        world.step(0.1);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    WorldStats stats = world.getStats();
+    double entities = static_cast<double>(stats.walkers + throwers.size());
+    std::cout << "Bodies: " << stats.bodies << ", walkers: " << stats.walkers
+              << ", throwers: " << throwers.size() << ", ticks: " << ticks << std::endl;
+    std::cout << "Targets caught: " << stats.targetsCaught << " of " << stats.walkers << " ("
+              << (stats.walkers > 0 ? 100.0 * stats.targetsCaught / stats.walkers : 0.0) << "%)"
+              << ", walkers still moving: " << stats.walkersMoving
+              << ", snowball hits: " << stats.projectileHits << ", misses: " << stats.projectileMisses << std::endl;
+    std::cout << "Time per tick: " << seconds * 1e3 / ticks << " ms, per entity: "
+              << seconds * 1e9 / (ticks * entities) << " ns" << std::endl;
+    
+    // Which segments touch each target: grid rebuild plus one query per target
+    std::vector<SegmentRef> touching(64);
+    size_t contacts = 0;
+    start = std::chrono::steady_clock::now();
+    world.updateSpatialIndex();
+    for (CircleHandle target : targets) {
+        contacts += world.findSegmentsTouchingCircle(*world.getCircle(target), touching);
+    }
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Segment/target contacts: " << contacts << " (grid rebuild and " << targets.size()
+              << " queries: " << seconds * 1e3 << " ms)" << std::endl;
+}
+
+} // namespace
+
+void displayBenchmarkUsage() {
+    std::cout << "  --arena-report [N]         Run N scenarios in a ScenarioArena and report allocations" << std::endl;
+    std::cout << "  --crowd <N> [ticks]        Run N bodies (walkers and throwers) in one world" << std::endl;
+    std::cout << "  --contact-bench <N> [Q]    Time Q contact queries on a rig with N extra segments" << std::endl;
+    std::cout << "  --self-collision-bench [Q] Time Q self-collision checks on a moving humanoid" << std::endl;
+    std::cout << "  --move-bench [N]           Time N walking steps of a humanoid against the bare vector arithmetic" << std::endl;
+    std::cout << "  --path-bench [size] [N]    Time walking-path planning on a size x size grid with N obstacles" << std::endl;
+    std::cout << "  --route-bench [N]          Time ordering N scattered targets into one walker's route" << std::endl;
+    std::cout << "  --fight [N] [ticks]        Run a snowball fight between two teams of N fighters in all" << std::endl;
+    std::cout << "  --impact-bench [N]         Time N long throws stepped per tick and jumped impact to impact" << std::endl;
+    std::cout << "  --timer-bench [N] [ticks]  Time N repeating timers counted down per body and on a timing wheel" << std::endl;
+    std::cout << "  --ecs-bench [N]            Time a ballistic tick over N entities as objects and as archetype chunks" << std::endl;
+    std::cout << "  --jobs-bench [workers]     Time job submission, continuations and parallelFor on the job system" << std::endl;
+    std::cout << "  --tick-bench [N] [threads] Time world ticks of N bodies on 1 to threads threads and compare the results" << std::endl;
+    std::cout << "  --behaviour-bench [N] [ticks] Time N coroutine behaviours resumed by a scheduler" << std::endl;
+    std::cout << "  --command-bench [P] [N]    Time N key presses from P input threads, inline and through the command queue" << std::endl;
+    std::cout << "  --precision-check [N]      Run N walker and snowball scenarios in float and double and compare the outcomes" << std::endl;
+    std::cout << "  --kernel-check [N]         Check every point kernel path against the scalar classes and time it on N points" << std::endl;
+    std::cout << "  --trig-check [N]           Sweep sinCos against std::sin/std::cos over the joint limits on N angles" << std::endl;
+    std::cout << "  --ik-check [N]             Check the dual-number gradients and the batched IK solver on N random poses" << std::endl;
+}
+
+bool runBenchmark(int argc, char** argv, int i) {
+    if (strcmp(argv[i], "--crowd") == 0 && i + 1 < argc) {
+        int bodies = std::atoi(argv[i + 1]);
+        int ticks = (i + 2 < argc) ? std::atoi(argv[i + 2]) : 0;
+        runCrowd(bodies > 0 ? bodies : 100, ticks > 0 ? ticks : 200);
+        return true;
+    } else if (strcmp(argv[i], "--contact-bench") == 0 && i + 1 < argc) {
+        int segments = std::atoi(argv[i + 1]);
+        int queries = (i + 2 < argc) ? std::atoi(argv[i + 2]) : 0;
+        runContactBench(segments > 0 ? segments : 300, queries > 0 ? queries : 20000);
+        return true;
+    } else if (strcmp(argv[i], "--self-collision-bench") == 0) {
+        int checks = (i + 1 < argc) ? std::atoi(argv[i + 1]) : 0;
+        runSelfCollisionBench(checks > 0 ? checks : 1000000);
+        return true;
+    } else if (strcmp(argv[i], "--path-bench") == 0) {
+        int size = (i + 1 < argc) ? std::atoi(argv[i + 1]) : 0;
+        int obstacles = (i + 2 < argc) ? std::atoi(argv[i + 2]) : 0;
+        runPathBench(size > 0 ? size : 4096, obstacles > 0 ? obstacles : 2000);
+        return true;
+    } else if (strcmp(argv[i], "--route-bench") == 0) {
+        int targets = (i + 1 < argc) ? std::atoi(argv[i + 1]) : 0;
+        runRouteBench(targets > 0 ? targets : 5000);
+        return true;
+    } else if (strcmp(argv[i], "--fight") == 0) {
+        int fighters = (i + 1 < argc) ? std::atoi(argv[i + 1]) : 0;
+        int ticks = (i + 2 < argc) ? std::atoi(argv[i + 2]) : 0;
+        runFight(fighters > 0 ? fighters : 1000, ticks > 0 ? ticks : 600);
+        return true;
+    } else if (strcmp(argv[i], "--impact-bench") == 0) {
+        int projectiles = (i + 1 < argc) ? std::atoi(argv[i + 1]) : 0;
+        runImpactBench(projectiles > 0 ? projectiles : 1000);
+        return true;
+    } else if (strcmp(argv[i], "--timer-bench") == 0) {
+        int timers = (i + 1 < argc) ? std::atoi(argv[i + 1]) : 0;
+        int ticks = (i + 2 < argc) ? std::atoi(argv[i + 2]) : 0;
+        runTimerBench(timers > 0 ? timers : 100000, ticks > 0 ? ticks : 3600);
+        return true;
+    } else if (strcmp(argv[i], "--ecs-bench") == 0) {
+        int entities = (i + 1 < argc) ? std::atoi(argv[i + 1]) : 0;
+        runEcsBench(entities > 0 ? entities : 100000);
+        return true;
+    } else if (strcmp(argv[i], "--jobs-bench") == 0) {
+        int workers = (i + 1 < argc) ? std::atoi(argv[i + 1]) : -1;
+        runJobsBench(workers >= 0 ? workers : static_cast<int>(JobSystem::getDefaultWorkerCount()));
+        return true;
+    } else if (strcmp(argv[i], "--tick-bench") == 0) {
+        int bodies = (i + 1 < argc) ? std::atoi(argv[i + 1]) : 0;
+        int threads = (i + 2 < argc) ? std::atoi(argv[i + 2]) : 0;
+        int hardware = static_cast<int>(JobSystem::getDefaultWorkerCount()) + 1;
+        runTickBench(bodies > 0 ? bodies : 1000, threads > 0 ? threads : std::max(hardware, 4));
+        return true;
+    } else if (strcmp(argv[i], "--behaviour-bench") == 0) {
+        int behaviours = (i + 1 < argc) ? std::atoi(argv[i + 1]) : 0;
+        int ticks = (i + 2 < argc) ? std::atoi(argv[i + 2]) : 0;
+        runBehaviourBench(behaviours > 0 ? behaviours : 10000, ticks > 0 ? ticks : 1000);
+        return true;
+    } else if (strcmp(argv[i], "--command-bench") == 0) {
+        int producers = (i + 1 < argc) ? std::atoi(argv[i + 1]) : 0;
+        int commands = (i + 2 < argc) ? std::atoi(argv[i + 2]) : 0;
+        runCommandBench(producers > 0 ? producers : 2, commands > 0 ? commands : 2000);
+        return true;
+    } else if (strcmp(argv[i], "--precision-check") == 0) {
+        int scenarios = (i + 1 < argc) ? std::atoi(argv[i + 1]) : 0;
+        runPrecisionCheck(scenarios > 0 ? scenarios : 1000);
+        return true;
+    } else if (strcmp(argv[i], "--kernel-check") == 0) {
+        int points = (i + 1 < argc) ? std::atoi(argv[i + 1]) : 0;
+        runKernelCheck(points > 0 ? points : 4096);
+        return true;
+    } else if (strcmp(argv[i], "--move-bench") == 0) {
+        int moves = (i + 1 < argc) ? std::atoi(argv[i + 1]) : 0;
+        runMoveBench(moves > 0 ? moves : 2000000);
+        return true;
+    } else if (strcmp(argv[i], "--trig-check") == 0) {
+        int angles = (i + 1 < argc) ? std::atoi(argv[i + 1]) : 0;
+        runTrigCheck(angles > 0 ? angles : 1000000);
+        return true;
+    } else if (strcmp(argv[i], "--ik-check") == 0) {
+        int poses = (i + 1 < argc) ? std::atoi(argv[i + 1]) : 0;
+        runIkCheck(poses > 0 ? poses : 1000);
+        return true;
+    } else if (strcmp(argv[i], "--arena-report") == 0) {
+        int scenarios = (i + 1 < argc) ? std::atoi(argv[i + 1]) : 0;
+        runArenaReport(scenarios > 0 ? scenarios : 10);
+        return true;
+    }
+    return false;
+}
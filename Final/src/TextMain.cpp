@@ -2,6 +2,7 @@
 #include <string>
 #include <cstring>
 #include "TextSimulation.cpp" // Include directly since we're not compiling with SFML
+#include "../include/TextBenchmarks.h"
 
 void displayUsage(const char* programName) {
     std::cout << "Usage: " << programName << " [options]" << std::endl;
@@ -10,6 +11,7 @@ void displayUsage(const char* programName) {
     std::cout << "  -w, --walker               Start in Walker mode (default)" << std::endl;
     std::cout << "  -s, --snowball             Start in Snowball mode" << std::endl;
     std::cout << "  -c, --config <file>        Load configuration from file" << std::endl;
+    displayBenchmarkUsage();
     std::cout << std::endl;
 }
 
@@ -28,6 +30,8 @@ int main(int argc, char** argv) {
             simulationType = SimulationType::SNOWBALL;
         } else if ((strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "--config") == 0) && i + 1 < argc) {
             configFile = argv[++i];
+        } else if (runBenchmark(argc, argv, i)) {
+            return 0;
         } else {
             std::cerr << "Unknown option: " << argv[i] << std::endl;
             displayUsage(argv[0]);
@@ -3,6 +3,8 @@
 #include "../include/Walker.h"
 #include "../include/Snowball.h"
 #include "../include/Logger.h"
+#include "../include/World.h"
+#include "../include/SimulationCommand.h"
 #include <iostream>
 #include <string>
 #include <memory>
@@ -22,7 +24,7 @@ public:
           autoMode(false),
           simulationSpeed(1.0f),
           groundLevel(400.0),
-          initialBodyPosition(100.0, groundLevel),
+          initialBodyPosition(100.0, groundLevel - Body::kStandingHeight),   // Feet on the ground
           initialTargetPosition(500.0, groundLevel - 50.0),
           targetRadius(20.0),
           gravity(9.81) {
@@ -30,8 +32,8 @@ public:
         std::cout << "=== " << title << " ===" << std::endl;
         
         // Create shared objects
-        body = std::make_shared<Body>(initialBodyPosition, groundLevel);
-        targetObject = std::make_shared<Circle>(initialTargetPosition, targetRadius);
+        body = world.createBody(initialBodyPosition, groundLevel);
+        targetObject = world.createCircle(initialTargetPosition, targetRadius);
         logger = std::make_shared<Logger>("simulation_log.txt");
         
         // Log initialization
@@ -41,17 +43,19 @@ public:
     void configure(SimulationType type) {
         simulationType = type;
         
-        // Reset any existing objects
-        body = std::make_shared<Body>(initialBodyPosition, groundLevel);
+        // Reset any existing objects (handles to the old ones go stale)
+        world.destroyBody(body);
+        world.destroyCircle(targetObject);
+        body = world.createBody(initialBodyPosition, groundLevel);
         
         switch (simulationType) {
             case SimulationType::WALKER:
-                targetObject = std::make_shared<Circle>(initialTargetPosition, targetRadius);
+                targetObject = world.createCircle(initialTargetPosition, targetRadius);
                 logger->logMessage("Configured for Walker scenario");
                 break;
                 
             case SimulationType::SNOWBALL:
-                targetObject = std::make_shared<Circle>(
+                targetObject = world.createCircle(
                     Vector2D(initialBodyPosition.x + 300.0, groundLevel - 100.0),
                     targetRadius
                 );
@@ -94,6 +98,7 @@ public:
             std::cin >> command;
             
             processCommand(command);
+            processCommands();
             
             // Slight delay for readability
             std::this_thread::sleep_for(std::chrono::milliseconds(500));
@@ -106,22 +111,22 @@ public:
         if (simulationType == SimulationType::WALKER) {
             std::cout << "Mode: Walker" << std::endl;
             if (walker) {
-                std::cout << "Target position: (" << targetObject->getCenter().x << ", " 
-                          << targetObject->getCenter().y << ")" << std::endl;
-                std::cout << "Body position: (" << body->getBasePosition().x << ", " 
-                          << body->getBasePosition().y << ")" << std::endl;
-                std::cout << "Segments: " << body->getSegmentCount() << std::endl;
-                std::cout << "Ground contacts: " << body->countGroundContacts() << std::endl;
+                std::cout << "Target position: (" << getTarget()->getCenter().x << ", " 
+                          << getTarget()->getCenter().y << ")" << std::endl;
+                std::cout << "Body position: (" << getBody()->getBasePosition().x << ", " 
+                          << getBody()->getBasePosition().y << ")" << std::endl;
+                std::cout << "Segments: " << getBody()->getSegmentCount() << std::endl;
+                std::cout << "Ground contacts: " << getBody()->countGroundContacts() << std::endl;
                 std::cout << "Object caught: " << (walker->hasObjectBeenCaught() ? "Yes" : "No") << std::endl;
                 std::cout << "Sequence complete: " << (walker->isSequenceComplete() ? "Yes" : "No") << std::endl;
             }
         } else {
             std::cout << "Mode: Snowball" << std::endl;
             if (snowball) {
-                std::cout << "Target position: (" << targetObject->getCenter().x << ", " 
-                          << targetObject->getCenter().y << ")" << std::endl;
-                std::cout << "Body position: (" << body->getBasePosition().x << ", " 
-                          << body->getBasePosition().y << ")" << std::endl;
+                std::cout << "Target position: (" << getTarget()->getCenter().x << ", " 
+                          << getTarget()->getCenter().y << ")" << std::endl;
+                std::cout << "Body position: (" << getBody()->getBasePosition().x << ", " 
+                          << getBody()->getBasePosition().y << ")" << std::endl;
                 std::cout << "Snowball position: (" << snowball->getCircle().getCenter().x << ", " 
                           << snowball->getCircle().getCenter().y << ")" << std::endl;
                 std::cout << "Snowball thrown: " << (snowball->isActive() ? "Yes" : "No") << std::endl;
@@ -131,12 +136,18 @@ public:
         }
     }
     
+    // Simulation keys become queued commands (applied by processCommands at
+    // the tick boundary, as in the SFML front end); a and q stay local
     void processCommand(char command) {
+        SimulationCommand parsed;
+        if (parseCommand(command, parsed)) {
+            if (!commands.tryPush(parsed)) {
+                std::cerr << "Command queue full; dropped " << command << std::endl;
+            }
+            return;
+        }
+        
         switch (command) {
-            case 's': // Step
-                executeStep();
-                break;
-                
             case 'a': // Auto mode
                 autoExecute();
                 break;
@@ -146,26 +157,18 @@ public:
                 std::cout << "Quitting simulation..." << std::endl;
                 break;
                 
-            case 'w': // Switch to Walker
-                configure(SimulationType::WALKER);
-                initialize();
-                break;
-                
-            case 'b': // Switch to Snowball
-                configure(SimulationType::SNOWBALL);
-                initialize();
-                break;
-                
-            case 'r': // Reset
-                initialize();
-                std::cout << "Simulation reset" << std::endl;
-                break;
-                
             default:
                 std::cout << "Unknown command" << std::endl;
         }
     }
     
+    // Apply the queued commands, in order; returns the number applied
+    size_t processCommands() {
+        return commands.drain([this](const SimulationCommand& command) {
+            applyCommand(command);
+        }, commands.getCapacity());
+    }
+    
     void executeStep() {
         if (simulationType == SimulationType::WALKER && walker) {
             if (!walker->isSequenceComplete()) {
@@ -182,9 +185,9 @@ public:
             // For snowball, we've implemented a more direct approach
             if (!snowball->isActive() && !snowball->hasHitTarget() && !snowball->hasHitGround()) {
                 // Prepare and throw the snowball
-                Vector2D initialPos = body->getBasePosition();
+                Vector2D initialPos = getBody()->getBasePosition();
                 initialPos.y -= 50; // Offset from body base
-                Vector2D targetPos = targetObject->getCenter();
+                Vector2D targetPos = getTarget()->getCenter();
                 
                 // Calculate initial velocity (basic ballistic equation)
                 double dx = targetPos.x - initialPos.x;
@@ -251,9 +254,9 @@ public:
             // For snowball, we'll execute a single throw
             if (!snowball->isActive() && !snowball->hasHitTarget() && !snowball->hasHitGround()) {
                 // Prepare and throw the snowball
-                Vector2D initialPos = body->getBasePosition();
+                Vector2D initialPos = getBody()->getBasePosition();
                 initialPos.y -= 50; // Offset from body base
-                Vector2D targetPos = targetObject->getCenter();
+                Vector2D targetPos = getTarget()->getCenter();
                 
                 // Calculate initial velocity (basic ballistic equation)
                 double dx = targetPos.x - initialPos.x;
@@ -302,16 +305,39 @@ public:
     }
     
 private:
+    void applyCommand(const SimulationCommand& command) {
+        switch (command.type) {
+            case CommandType::STEP:
+                executeStep();
+                break;
+                
+            case CommandType::WALKER_MODE:
+                configure(SimulationType::WALKER);
+                initialize();
+                break;
+                
+            case CommandType::SNOWBALL_MODE:
+                configure(SimulationType::SNOWBALL);
+                initialize();
+                break;
+                
+            case CommandType::RESET:
+                initialize();
+                std::cout << "Simulation reset" << std::endl;
+                break;
+        }
+    }
+    
     void initializeWalker() {
         // Create a Walker with the body
-        walker = std::make_unique<Walker>(body);
+        walker = std::make_unique<Walker>(world, body);
         
         // Set target object and enable logging
         walker->setTargetObject(targetObject);
         walker->enableLogging(logger);
         
         // Plan catching sequence to the target object
-        walker->planCatchSequence(targetObject->getCenter());
+        walker->planCatchSequence(getTarget()->getCenter());
         
         logger->logMessage("Walker scenario initialized");
         std::cout << "Walker scenario initialized" << std::endl;
@@ -319,7 +345,7 @@ private:
     
     void initializeSnowball() {
         // Create a Snowball
-        snowball = std::make_unique<Snowball>();
+        snowball = std::make_unique<Snowball>(world);
         
         // Configure the snowball with thrower and target
         snowball->setThrower(body);
@@ -343,14 +369,25 @@ private:
         std::cout << "==========================================" << std::endl;
     }
     
-    std::shared_ptr<Body> body;                // The anthropomorphic body
-    std::shared_ptr<Circle> targetObject;      // Target object (for both scenarios)
+    // Resolve the handles (the world owns both entities)
+    Body* getBody() { return world.getBody(body); }
+    const Body* getBody() const { return world.getBody(body); }
+    Circle* getTarget() { return world.getCircle(targetObject); }
+    const Circle* getTarget() const { return world.getCircle(targetObject); }
+    
+    World world;                               // Owns the body and target
+    BodyHandle body;                           // The anthropomorphic body
+    CircleHandle targetObject;                 // Target object (for both scenarios)
     std::shared_ptr<Logger> logger;            // Logger for actions
     
     // Scenario-specific components
     std::unique_ptr<Walker> walker;            // Walker scenario
     std::unique_ptr<Snowball> snowball;        // Snowball scenario
     
+    // Keys waiting for the next tick boundary
+    static constexpr size_t kCommandCapacity = 64;
+    SimulationCommandQueue commands{kCommandCapacity};
+    
     SimulationType simulationType;             // Current scenario type
     bool simulationRunning;                    // Simulation state
     bool autoMode;                             // Auto-execute movement sequence
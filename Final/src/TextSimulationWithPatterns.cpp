@@ -3,6 +3,7 @@
 #include "../include/WalkerStrategy.h"
 #include "../include/SnowballStrategy.h"
 #include "../include/Logger.h"
+#include "../include/SimulationCommand.h"
 #include <iostream>
 #include <string>
 #include <memory>
@@ -19,8 +20,8 @@ public:
           autoMode(false),
           simulationSpeed(1.0f),
           groundLevel(400.0),
-          initialBodyPosition(100.0, 400.0),
-          initialTargetPosition(500.0, 350.0),
+          initialBodyPosition(100.0, 400.0 - Body::kStandingHeight),   // Feet on the ground
+          initialTargetPosition(500.0, 400.0 - Body::kStandingHeight - 60.0),   // Shoulder height
           targetRadius(20.0),
           gravity(9.8) {
         
@@ -30,14 +31,14 @@ public:
         logger = std::make_shared<Logger>("simulation_log.txt");
         
         // Create target object
-        targetObject = std::make_shared<Circle>(initialTargetPosition, targetRadius);
+        targetObject = world.createCircle(initialTargetPosition, targetRadius);
         
         // Create body using the Builder pattern
         BodyBuilder builder;
         body = builder.setBasePosition(initialBodyPosition)
                      .setGroundLevel(groundLevel)
                      .buildHumanoidBody()
-                     .build();
+                     .build(world);
         
         // Log initialization
         logger->logMessage("Text Simulation initialized");
@@ -63,6 +64,7 @@ public:
             std::cin >> command;
             
             processCommand(command);
+            processCommands();
         }
     }
     
@@ -76,16 +78,23 @@ private:
             logger->logMessage("Configured for Walker scenario");
         } else {
             initialTargetPosition = Vector2D(400.0, 300.0);
-            targetObject->setCenter(initialTargetPosition);
+            getTarget()->setCenter(initialTargetPosition);
             logger->logMessage("Configured for Snowball scenario");
         }
     }
     
+    // Simulation keys become queued commands (applied by processCommands at
+    // the tick boundary, as in the SFML front end); a and q stay local
     void processCommand(char command) {
+        SimulationCommand parsed;
+        if (parseCommand(command, parsed)) {
+            if (!commands.tryPush(parsed)) {
+                std::cerr << "Command queue full; dropped " << command << std::endl;
+            }
+            return;
+        }
+        
         switch (command) {
-            case 's':
-                executeStep();
-                break;
             case 'a':
                 autoExecute();
                 break;
@@ -93,21 +102,38 @@ private:
                 simulationRunning = false;
                 logger->logMessage("Simulation stopped by user");
                 break;
-            case 'w':
+            default:
+                std::cout << "Unknown command" << std::endl;
+        }
+    }
+    
+    // Apply the queued commands, in order; returns the number applied
+    size_t processCommands() {
+        return commands.drain([this](const SimulationCommand& command) {
+            applyCommand(command);
+        }, commands.getCapacity());
+    }
+    
+    void applyCommand(const SimulationCommand& command) {
+        switch (command.type) {
+            case CommandType::STEP:
+                executeStep();
+                break;
+            case CommandType::WALKER_MODE:
                 logger->logMessage("Configured for Walker scenario");
                 simulationType = SimulationType::WALKER;
                 initializeWalker();
                 logger->logMessage("Simulation started");
                 break;
-            case 'b':
+            case CommandType::SNOWBALL_MODE:
                 logger->logMessage("Configured for Snowball scenario");
                 simulationType = SimulationType::SNOWBALL;
                 initialTargetPosition = Vector2D(400.0, 300.0);
-                targetObject->setCenter(initialTargetPosition);
+                getTarget()->setCenter(initialTargetPosition);
                 initializeSnowball();
                 logger->logMessage("Simulation started");
                 break;
-            case 'r':
+            case CommandType::RESET:
                 logger->logMessage("Simulation reset");
                 if (simulationType == SimulationType::WALKER) {
                     initializeWalker();
@@ -115,8 +141,6 @@ private:
                     initializeSnowball();
                 }
                 break;
-            default:
-                std::cout << "Unknown command" << std::endl;
         }
     }
     
@@ -136,9 +160,9 @@ private:
             // For snowball, we've implemented a more direct approach
             if (!snowballStrategy->isActive() && !snowballStrategy->hasHitTarget() && !snowballStrategy->hasHitGround()) {
                 // Prepare and throw the snowball
-                Vector2D initialPos = body->getBasePosition();
+                Vector2D initialPos = getBody()->getBasePosition();
                 initialPos.y -= 50; // Offset from body base
-                Vector2D targetPos = targetObject->getCenter();
+                Vector2D targetPos = getTarget()->getCenter();
                 
                 // Calculate initial velocity (basic ballistic equation)
                 double dx = targetPos.x - initialPos.x;
@@ -205,9 +229,9 @@ private:
             // For snowball, we'll execute a single throw
             if (!snowballStrategy->isActive() && !snowballStrategy->hasHitTarget() && !snowballStrategy->hasHitGround()) {
                 // Prepare and throw the snowball
-                Vector2D initialPos = body->getBasePosition();
+                Vector2D initialPos = getBody()->getBasePosition();
                 initialPos.y -= 50; // Offset from body base
-                Vector2D targetPos = targetObject->getCenter();
+                Vector2D targetPos = getTarget()->getCenter();
                 
                 // Calculate initial velocity (basic ballistic equation)
                 double dx = targetPos.x - initialPos.x;
@@ -257,13 +281,13 @@ private:
     
     void initializeWalker() {
         // Create the Walker Strategy (Strategy pattern)
-        walkerStrategy = std::make_unique<WalkerStrategy>(body, targetObject);
+        walkerStrategy = std::make_unique<WalkerStrategy>(world, body, targetObject);
         
         // Enable logging
         walkerStrategy->enableLogging(logger);
         
         // Plan the sequence
-        walkerStrategy->planSequence(targetObject->getCenter());
+        walkerStrategy->planSequence(getTarget()->getCenter());
         
         // Clear snowball strategy
         snowballStrategy = nullptr;
@@ -274,7 +298,7 @@ private:
     
     void initializeSnowball() {
         // Create the Snowball Strategy (Strategy pattern)
-        snowballStrategy = std::make_unique<SnowballStrategy>(body, targetObject);
+        snowballStrategy = std::make_unique<SnowballStrategy>(world, body, targetObject);
         
         // Enable logging
         snowballStrategy->enableLogging(logger);
@@ -289,12 +313,12 @@ private:
     void displayStatus() const {
         std::cout << "\n----- Current Status -----" << std::endl;
         std::cout << "Mode: " << (simulationType == SimulationType::WALKER ? "Walker" : "Snowball") << std::endl;
-        std::cout << "Target position: " << targetObject->getCenter() << std::endl;
-        std::cout << "Body position: " << body->getBasePosition() << std::endl;
+        std::cout << "Target position: " << getTarget()->getCenter() << std::endl;
+        std::cout << "Body position: " << getBody()->getBasePosition() << std::endl;
         
         if (simulationType == SimulationType::WALKER && walkerStrategy) {
-            std::cout << "Segments: " << body->getSegmentCount() << std::endl;
-            std::cout << "Ground contacts: " << body->countGroundContacts() << std::endl;
+            std::cout << "Segments: " << getBody()->getSegmentCount() << std::endl;
+            std::cout << "Ground contacts: " << getBody()->countGroundContacts() << std::endl;
             std::cout << "Object caught: " << (walkerStrategy->hasObjectBeenCaught() ? "Yes" : "No") << std::endl;
             std::cout << "Sequence complete: " << (walkerStrategy->isSequenceComplete() ? "Yes" : "No") << std::endl;
         } else if (simulationType == SimulationType::SNOWBALL && snowballStrategy) {
@@ -317,14 +341,25 @@ private:
         std::cout << "==========================================" << std::endl;
     }
     
-    std::shared_ptr<Body> body;                // The anthropomorphic body
-    std::shared_ptr<Circle> targetObject;      // Target object (for both scenarios)
+    // Resolve the handles (the world owns both entities)
+    Body* getBody() { return world.getBody(body); }
+    const Body* getBody() const { return world.getBody(body); }
+    Circle* getTarget() { return world.getCircle(targetObject); }
+    const Circle* getTarget() const { return world.getCircle(targetObject); }
+    
+    World world;                               // Owns the body and target
+    BodyHandle body;                           // The anthropomorphic body
+    CircleHandle targetObject;                 // Target object (for both scenarios)
     std::shared_ptr<Logger> logger;            // Logger for actions (Singleton pattern)
     
     // Strategy pattern implementations
     std::unique_ptr<WalkerStrategy> walkerStrategy;      // Walker mode strategy
     std::unique_ptr<SnowballStrategy> snowballStrategy;  // Snowball mode strategy
     
+    // Keys waiting for the next tick boundary
+    static constexpr size_t kCommandCapacity = 64;
+    SimulationCommandQueue commands{kCommandCapacity};
+    
     SimulationType simulationType;             // Current scenario type
     bool simulationRunning;                    // Simulation state
     bool autoMode;                             // Auto-execute movement sequence
@@ -0,0 +1,210 @@
+/**
+ * @file TimingWheel.cpp
+ * @brief Implementation of the TimingWheel class
+ */
+#include "../include/TimingWheel.h"
+#include <algorithm>
+#include <bit>
+
+TimingWheel::TimingWheel(std::pmr::memory_resource* resource)
+    : timers(resource), occupied{}, expired(resource), currentTick(0) {
+    heads.fill(kNoTimer);
+    tails.fill(kNoTimer);
+}
+
+TimerHandle TimingWheel::schedule(uint64_t ticks, uint64_t payload) {
+    uint64_t delay = std::max<uint64_t>(ticks, 1);
+    uint64_t due = currentTick + std::min(delay, UINT64_MAX - currentTick);
+    TimerHandle handle = timers.create(Timer{due, payload, kNoTimer, kNoTimer, 0});
+    insert(handle.index);
+    return handle;
+}
+
+bool TimingWheel::cancel(TimerHandle timer) {
+    if (!timers.contains(timer)) {
+        return false;
+    }
+    unlink(timer.index);
+    return timers.destroy(timer);
+}
+
+void TimingWheel::clear() {
+    timers.clear();
+    heads.fill(kNoTimer);
+    tails.fill(kNoTimer);
+    occupied.fill(0);
+}
+
+void TimingWheel::advance(uint64_t ticks) {
+    advanceTo(currentTick + std::min(ticks, UINT64_MAX - currentTick));
+}
+
+void TimingWheel::advanceTo(uint64_t tick) {
+    expired.clear();
+    while (currentTick < tick) {
+        if (timers.size() == 0) {
+            currentTick = tick;
+            break;
+        }
+        // The next occupied slot of the first wheel before it comes round,
+        // else the tick it comes round and cascades
+        uint64_t next = (currentTick | (kSlots - 1)) + 1;
+        uint32_t first = static_cast<uint32_t>((currentTick + 1) & (kSlots - 1));
+        if (first != 0) {
+            uint64_t ahead = occupied[0] & (~uint64_t(0) << first);
+            if (ahead != 0) {
+                next = (currentTick & ~uint64_t(kSlots - 1)) + std::countr_zero(ahead);
+            }
+        }
+        if (next > tick) {
+            currentTick = tick;
+            break;
+        }
+        currentTick = next;
+        if ((currentTick & (kSlots - 1)) == 0) {
+            cascade();
+        }
+        expireSlot(static_cast<uint32_t>(currentTick & (kSlots - 1)));
+    }
+}
+
+std::span<const ExpiredTimer> TimingWheel::getExpired() const {
+    return expired;
+}
+
+uint64_t TimingWheel::getTick() const {
+    return currentTick;
+}
+
+size_t TimingWheel::size() const {
+    return timers.size();
+}
+
+bool TimingWheel::isPending(TimerHandle timer) const {
+    return timers.contains(timer);
+}
+
+uint64_t TimingWheel::getDue(TimerHandle timer) const {
+    const Timer* pending = timers.get(timer);
+    return pending ? pending->due : UINT64_MAX;
+}
+
+uint64_t TimingWheel::getEarliestDue() const {
+    if (timers.size() == 0) {
+        return UINT64_MAX;
+    }
+    // First-wheel timers are due within the next 64 ticks, in slot order
+    // starting after the current one
+    uint64_t earliest = UINT64_MAX;
+    if (occupied[0] != 0) {
+        uint32_t first = static_cast<uint32_t>((currentTick + 1) & (kSlots - 1));
+        uint64_t rotated = std::rotr(occupied[0], static_cast<int>(first));
+        earliest = currentTick + 1 + std::countr_zero(rotated);
+    }
+    // The rest come down no earlier than the first wheel's next turn
+    bool coarser = heads[kOverflow] != kNoTimer;
+    for (uint32_t level = 1; level < kLevels && !coarser; level++) {
+        coarser = occupied[level] != 0;
+    }
+    if (coarser) {
+        earliest = std::min(earliest, (currentTick | (kSlots - 1)) + 1);
+    }
+    return earliest;
+}
+
+Timer& TimingWheel::timerAt(uint32_t slot) {
+    return *timers.get(timers.handleAt(slot));
+}
+
+void TimingWheel::insert(uint32_t slot) {
+    // The finest wheel whose span covers the delay
+    Timer& timer = timerAt(slot);
+    uint64_t delay = timer.due - currentTick;
+    uint32_t bucket = kOverflow;
+    for (uint32_t level = 0; level < kLevels; level++) {
+        if (delay < (uint64_t(1) << (kSlotBits * (level + 1)))) {
+            uint32_t index = static_cast<uint32_t>((timer.due >> (kSlotBits * level)) & (kSlots - 1));
+            bucket = level * kSlots + index;
+            occupied[level] |= uint64_t(1) << index;
+            break;
+        }
+    }
+
+    timer.bucket = bucket;
+    timer.previous = tails[bucket];
+    timer.next = kNoTimer;
+    if (tails[bucket] != kNoTimer) {
+        timerAt(tails[bucket]).next = slot;
+    } else {
+        heads[bucket] = slot;
+    }
+    tails[bucket] = slot;
+}
+
+void TimingWheel::unlink(uint32_t slot) {
+    Timer& timer = timerAt(slot);
+    if (timer.previous != kNoTimer) {
+        timerAt(timer.previous).next = timer.next;
+    } else {
+        heads[timer.bucket] = timer.next;
+    }
+    if (timer.next != kNoTimer) {
+        timerAt(timer.next).previous = timer.previous;
+    } else {
+        tails[timer.bucket] = timer.previous;
+    }
+    if (heads[timer.bucket] == kNoTimer && timer.bucket != kOverflow) {
+        occupied[timer.bucket / kSlots] &= ~(uint64_t(1) << (timer.bucket % kSlots));
+    }
+}
+
+void TimingWheel::cascade() {
+    // The first wheel has come round: bring down the next wheel's slot for
+    // this turn, and the one above it if that wheel has come round too
+    uint32_t top = 1;
+    while (top < kLevels && (currentTick & ((uint64_t(1) << (kSlotBits * top)) - 1)) == 0) {
+        top++;
+    }
+    std::array<uint32_t, kLevels + 1> buckets;
+    size_t count = 0;
+    if (top == kLevels) {
+        buckets[count++] = kOverflow;
+    }
+    for (uint32_t level = top - 1; level >= 1; level--) {
+        uint32_t index = static_cast<uint32_t>((currentTick >> (kSlotBits * level)) & (kSlots - 1));
+        buckets[count++] = level * kSlots + index;
+    }
+    for (size_t i = 0; i < count; i++) {
+        uint32_t bucket = buckets[i];
+        uint32_t slot = heads[bucket];
+        heads[bucket] = kNoTimer;
+        tails[bucket] = kNoTimer;
+        if (bucket != kOverflow) {
+            occupied[bucket / kSlots] &= ~(uint64_t(1) << (bucket % kSlots));
+        }
+        while (slot != kNoTimer) {
+            uint32_t next = timerAt(slot).next;
+            insert(slot);
+            slot = next;
+        }
+    }
+}
+
+void TimingWheel::expireSlot(uint32_t bucket) {
+    uint32_t slot = heads[bucket];
+    heads[bucket] = kNoTimer;
+    tails[bucket] = kNoTimer;
+    occupied[0] &= ~(uint64_t(1) << bucket);
+    while (slot != kNoTimer) {
+        Timer& timer = timerAt(slot);
+        uint32_t next = timer.next;
+        TimerHandle handle = timers.handleAt(slot);
+        if (timer.due <= currentTick) {
+            expired.push_back(ExpiredTimer{handle, timer.payload});
+            timers.destroy(handle);
+        } else {
+            insert(slot);
+        }
+        slot = next;
+    }
+}
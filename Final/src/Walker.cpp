@@ -7,8 +7,9 @@
 #include <algorithm>
 #include <iostream>
 
-Walker::Walker(const std::shared_ptr<Body>& body, double walkSpeed)
-    : body(body),
+Walker::Walker(World& world, BodyHandle body, double walkSpeed)
+    : world(&world),
+      bodyHandle(body),
       currentMoveIndex(0),
       walkSpeed(walkSpeed),
       objectCaught(false) {
@@ -30,16 +31,21 @@ void Walker::planCatchSequence(const Vector2D& objectPosition) {
     currentMoveIndex = 0;
     objectCaught = false;
     
+    const Body* body = world->getBody(bodyHandle);
+    if (!body) {
+        return;
+    }
+    
     if (logger) {
         logger->logMessage("Planning catch sequence");
         logger->logMessage("Distance to object: " + std::to_string(body->getBasePosition().distance(objectPosition)));
     }
     
     // First, plan walking to get close to the object
-    addWalkingSequence(Vector2D(objectPosition.x - 50, body->getBasePosition().y));
+    addWalkingSequence(*body, Vector2D(objectPosition.x - 50, body->getBasePosition().y));
     
     // Then, plan reaching to catch the object
-    addReachingSequence(objectPosition);
+    addReachingSequence(*body, objectPosition);
     
     if (logger) {
         logger->logMessage("Total planned moves: " + std::to_string(sequence.size()));
@@ -52,13 +58,18 @@ void Walker::planThrowSequence(const Vector2D& targetPosition) {
     currentMoveIndex = 0;
     objectCaught = false;
     
+    const Body* body = world->getBody(bodyHandle);
+    if (!body) {
+        return;
+    }
+    
     if (logger) {
         logger->logMessage("Planning throw sequence");
         logger->logMessage("Distance to target: " + std::to_string(body->getBasePosition().distance(targetPosition)));
     }
     
     // Plan a throwing motion aimed at the target
-    addThrowingSequence(targetPosition);
+    addThrowingSequence(*body, targetPosition);
     
     if (logger) {
         logger->logMessage("Total planned moves: " + std::to_string(sequence.size()));
@@ -70,40 +81,58 @@ bool Walker::executeNextMove() {
         return false;
     }
     
+    // Resolve the body once per move (fails if it has been destroyed)
+    Body* body = world->getBody(bodyHandle);
+    if (!body) {
+        return false;
+    }
+    
     const SequenceMove& move = sequence[currentMoveIndex];
     bool moveComplete = false;
     
     // Execute different types of moves based on the type
     switch (move.type) {
         case MoveType::WALK_FORWARD:
-            moveComplete = executeWalkForward(move.parameter);
+            moveComplete = executeWalkForward(*body, move.parameter);
             break;
             
         case MoveType::WALK_BACKWARD:
-            moveComplete = executeWalkBackward(move.parameter);
+            moveComplete = executeWalkBackward(*body, move.parameter);
             break;
             
         case MoveType::REACH_UP:
-            moveComplete = executeReachUp(move.segmentName, move.parameter);
+            moveComplete = executeReachUp(*body, move.segmentName, move.parameter);
             break;
             
         case MoveType::REACH_DOWN:
-            moveComplete = executeReachDown(move.segmentName, move.parameter);
+            moveComplete = executeReachDown(*body, move.segmentName, move.parameter);
             break;
             
         case MoveType::REACH_LEFT:
-            moveComplete = executeReachLeft(move.segmentName, move.parameter);
+            moveComplete = executeReachLeft(*body, move.segmentName, move.parameter);
             break;
             
         case MoveType::REACH_RIGHT:
-            moveComplete = executeReachRight(move.segmentName, move.parameter);
+            moveComplete = executeReachRight(*body, move.segmentName, move.parameter);
             break;
             
         case MoveType::RESET_POSE:
-            moveComplete = executeResetPose();
+            moveComplete = executeResetPose(*body);
             break;
     }
     
+    // A reach only fails when rotateSegmentTo clamped it: the segment is
+    // already at its limit, so retrying would never get further and it
+    // counts as done
+    bool isReach = move.type == MoveType::REACH_UP || move.type == MoveType::REACH_DOWN ||
+                   move.type == MoveType::REACH_LEFT || move.type == MoveType::REACH_RIGHT;
+    if (!moveComplete && isReach) {
+        if (logger) {
+            logger->logMessage("Reach with " + move.segmentName + " stopped at its joint limit");
+        }
+        moveComplete = true;
+    }
+    
     // If move is complete, advance to the next move
     if (moveComplete) {
         currentMoveIndex++;
@@ -116,8 +145,8 @@ bool Walker::executeNextMove() {
         // Check if we've just completed a reaching sequence and should check for caught object
         if (isSequenceComplete() && !objectCaught) {
             // Check if we've caught the target object
-            if (auto target = targetObject.lock()) {
-                if (body->canReachObject(*target)) {
+            if (const Circle* target = world->getCircle(targetHandle)) {
+                if (body->canReachObject(*target, kReachingSegments)) {
                     objectCaught = true;
                     
                     if (logger) {
@@ -156,17 +185,17 @@ bool Walker::hasObjectBeenCaught() const {
     return objectCaught;
 }
 
-void Walker::setTargetObject(const std::shared_ptr<Circle>& object) {
-    targetObject = object;
+void Walker::setTargetObject(CircleHandle object) {
+    targetHandle = object;
 }
 
 void Walker::enableLogging(std::shared_ptr<Logger> newLogger) {
     logger = newLogger;
 }
 
-void Walker::addWalkingSequence(const Vector2D& destination) {
+void Walker::addWalkingSequence(const Body& body, const Vector2D& destination) {
     // Calculate how far to walk
-    double distance = destination.x - body->getBasePosition().x;
+    double distance = destination.x - body.getBasePosition().x;
     
     // Determine the move type
     MoveType moveType = (distance >= 0) ? MoveType::WALK_FORWARD : MoveType::WALK_BACKWARD;
@@ -195,34 +224,23 @@ void Walker::addWalkingSequence(const Vector2D& destination) {
     }
 }
 
-void Walker::addReachingSequence(const Vector2D& objectPosition) {
-    // Get body segments that might interact with the object
-    std::vector<std::string> segments = body->getSegmentNames();
-    
-    // Filter to only end segments that can potentially reach
-    std::vector<std::string> endSegments;
-    for (const auto& name : segments) {
-        if (body->isEndPoint(name)) {
-            endSegments.push_back(name);
-        }
-    }
-    
+void Walker::addReachingSequence(const Body& body, const Vector2D& objectPosition) {
     // Choose the main segments to use for reaching (typically arms)
     // In a real implementation, we might have labeled segments like "left_arm", "right_arm"
-    // Here, we'll just pick some end segments
-    std::vector<std::string> reachingSegments;
-    if (!endSegments.empty()) {
-        // Use the first few end segments for simplicity
-        size_t numToUse = std::min(size_t(2), endSegments.size());
-        for (size_t i = 0; i < numToUse; i++) {
-            reachingSegments.push_back(endSegments[i]);
+    // Here, we'll just pick the first few end segments (looked up by index, no copies)
+    std::string_view reachingSegments[kReachingSegments];
+    size_t reachingCount = 0;
+    for (size_t i = 0; i < body.getSegmentCount() && reachingCount < kReachingSegments; i++) {
+        if (body.isEndPoint(i)) {
+            reachingSegments[reachingCount++] = body.getSegmentName(i);
         }
     }
     
     // Create a simple reaching sequence using the selected segments
-    for (const auto& segmentName : reachingSegments) {
+    for (size_t r = 0; r < reachingCount; r++) {
+        std::string segmentName(reachingSegments[r]);
         // Reach up if object is higher than body base
-        if (objectPosition.y < body->getBasePosition().y) {
+        if (objectPosition.y < body.getBasePosition().y) {
             SequenceMove moveUp = {
                 MoveType::REACH_UP,
                 0.2,  // Small angle increment
@@ -232,7 +250,7 @@ void Walker::addReachingSequence(const Vector2D& objectPosition) {
         }
         
         // Reach forward (right) if object is to the right
-        if (objectPosition.x > body->getBasePosition().x) {
+        if (objectPosition.x > body.getBasePosition().x) {
             SequenceMove moveRight = {
                 MoveType::REACH_RIGHT,
                 0.2,  // Small angle increment
@@ -252,31 +270,28 @@ void Walker::addReachingSequence(const Vector2D& objectPosition) {
     }
     
     if (logger) {
-        logger->logMessage("Added reaching sequence: " + std::to_string(reachingSegments.size() * 2) + " moves");
+        logger->logMessage("Added reaching sequence: " + std::to_string(reachingCount * 2) + " moves");
     }
 }
 
-void Walker::addThrowingSequence(const Vector2D& targetPosition) {
+void Walker::addThrowingSequence(const Body& body, const Vector2D& targetPosition) {
     // Similar to reaching, but with the intent to throw
-    std::vector<std::string> segments = body->getSegmentNames();
-    
-    // Find arm-like segments to use for throwing
-    std::vector<std::string> throwingSegments;
-    for (const auto& name : segments) {
-        if (body->isEndPoint(name)) {
-            throwingSegments.push_back(name);
-            break; // Just use one arm for simplicity
+    // Find an arm-like segment to use for throwing (just one arm for simplicity)
+    std::string_view throwingSegment;
+    for (size_t i = 0; i < body.getSegmentCount() && throwingSegment.empty(); i++) {
+        if (body.isEndPoint(i)) {
+            throwingSegment = body.getSegmentName(i);
         }
     }
     
-    if (throwingSegments.empty()) {
+    if (throwingSegment.empty()) {
         if (logger) {
             logger->logMessage("No suitable segments found for throwing");
         }
         return;
     }
     
-    const std::string& armSegment = throwingSegments[0];
+    std::string armSegment(throwingSegment);
     
     // Wind up (move arm back)
     SequenceMove windUp = {
@@ -315,93 +330,91 @@ void Walker::addThrowingSequence(const Vector2D& targetPosition) {
     }
 }
 
-bool Walker::executeWalkForward(double distance) {
+bool Walker::executeWalkForward(Body& body, double distance) {
     // Move the body forward
-    Vector2D currentPos = body->getBasePosition();
+    Vector2D currentPos = body.getBasePosition();
     Vector2D newPos = currentPos + Vector2D(distance, 0);
-    body->moveBaseTo(newPos);
+    body.moveBaseTo(newPos);
     
     // Always complete the move in one step for simplicity
     return true;
 }
 
-bool Walker::executeWalkBackward(double distance) {
+bool Walker::executeWalkBackward(Body& body, double distance) {
     // Move the body backward
-    Vector2D currentPos = body->getBasePosition();
+    Vector2D currentPos = body.getBasePosition();
     Vector2D newPos = currentPos - Vector2D(distance, 0);
-    body->moveBaseTo(newPos);
+    body.moveBaseTo(newPos);
     
     // Always complete the move in one step for simplicity
     return true;
 }
 
-bool Walker::executeReachUp(const std::string& segmentName, double angle) {
+bool Walker::executeReachUp(Body& body, const std::string& segmentName, double angle) {
     if (segmentName.empty()) {
         return true; // Skip if no segment specified
     }
     
     // Rotate the segment upward (negative y is up, so rotation is negative)
-    Segment* segment = body->getSegment(segmentName);
+    Segment* segment = body.getSegment(segmentName);
     if (segment) {
         double currentAngle = segment->getAngle();
-        return body->rotateSegmentTo(segmentName, currentAngle - angle);
+        return body.rotateSegmentTo(segmentName, currentAngle - angle);
     }
     
     return true; // Complete the move if segment doesn't exist
 }
 
-bool Walker::executeReachDown(const std::string& segmentName, double angle) {
+bool Walker::executeReachDown(Body& body, const std::string& segmentName, double angle) {
     if (segmentName.empty()) {
         return true; // Skip if no segment specified
     }
     
     // Rotate the segment downward (positive y is down, so rotation is positive)
-    Segment* segment = body->getSegment(segmentName);
+    Segment* segment = body.getSegment(segmentName);
     if (segment) {
         double currentAngle = segment->getAngle();
-        return body->rotateSegmentTo(segmentName, currentAngle + angle);
+        return body.rotateSegmentTo(segmentName, currentAngle + angle);
     }
     
     return true; // Complete the move if segment doesn't exist
 }
 
-bool Walker::executeReachLeft(const std::string& segmentName, double angle) {
+bool Walker::executeReachLeft(Body& body, const std::string& segmentName, double angle) {
     if (segmentName.empty()) {
         return true; // Skip if no segment specified
     }
     
     // Rotate the segment left (negative x is left, target angle is PI)
-    Segment* segment = body->getSegment(segmentName);
+    Segment* segment = body.getSegment(segmentName);
     if (segment) {
         double currentAngle = segment->getAngle();
-        return body->rotateSegmentTo(segmentName, currentAngle + angle);
+        return body.rotateSegmentTo(segmentName, currentAngle + angle);
     }
     
     return true; // Complete the move if segment doesn't exist
 }
 
-bool Walker::executeReachRight(const std::string& segmentName, double angle) {
+bool Walker::executeReachRight(Body& body, const std::string& segmentName, double angle) {
     if (segmentName.empty()) {
         return true; // Skip if no segment specified
     }
     
     // Rotate the segment right (positive x is right, target angle is 0)
-    Segment* segment = body->getSegment(segmentName);
+    Segment* segment = body.getSegment(segmentName);
     if (segment) {
         double currentAngle = segment->getAngle();
-        return body->rotateSegmentTo(segmentName, currentAngle - angle);
+        return body.rotateSegmentTo(segmentName, currentAngle - angle);
     }
     
     return true; // Complete the move if segment doesn't exist
 }
 
-bool Walker::executeResetPose() {
+bool Walker::executeResetPose(Body& body) {
     // Reset all segments to their default angles
-    std::vector<std::string> segments = body->getSegmentNames();
-    
-    for (const auto& name : segments) {
+    for (size_t i = 0; i < body.getSegmentCount(); i++) {
         // Reset to a neutral position (0 degrees)
-        body->rotateSegmentTo(name, 0.0);
+        body.rotateSegmentTo(body.getSegmentName(i), 0.0);
     }
     
     // Always complete in one step for simplicity
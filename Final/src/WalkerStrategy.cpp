@@ -3,15 +3,19 @@
  * @brief Implementation of the WalkerStrategy class
  */
 #include "../include/WalkerStrategy.h"
+#include "../include/World.h"
+#include "../include/TargetScheduler.h"
 #include <cmath>
 #include <iostream>
 
-WalkerStrategy::WalkerStrategy(std::shared_ptr<Body> body, std::shared_ptr<Circle> target, double walkSpeed)
-    : MovementStrategy(body, target), walkSpeed(walkSpeed), objectCaught(false), 
-      currentMoveIndex(0), minGroundContacts(2), minObjectContacts(3) {
+WalkerStrategy::WalkerStrategy(World& world, BodyHandle body, CircleHandle target, double walkSpeed)
+    : MovementStrategy(world, body, target), walkSpeed(walkSpeed),
+      plannedMoves(world.getMemoryResource()), objectCaught(false), route(world.getMemoryResource()),
+      routeIndex(0), caughtCount(0), currentMoveIndex(0), minGroundContacts(2), minObjectContacts(kArmCount) {
 }
 
 void WalkerStrategy::planSequence() {
+    const Circle* target = getTarget();
     if (!target) {
         if (logger) logger->logMessage("Error: No target set for planning catch sequence");
         return;
@@ -23,46 +27,113 @@ void WalkerStrategy::planSequence(const Vector2D& objectPosition) {
     // Clear any existing moves
     plannedMoves.clear();
     objectCaught = false;
+    route.clear();
+    routeIndex = 0;
+    caughtCount = 0;
     currentMoveIndex = 0;
     
+    const Body* body = getBody();
+    if (!body) {
+        if (logger) logger->logMessage("Error: No body to plan a catch sequence for");
+        return;
+    }
+    addCatchSequence(*body, objectPosition);
+}
+
+size_t WalkerStrategy::planCollection(std::span<const CircleHandle> targets, double timeBudget) {
+    plannedMoves.clear();
+    objectCaught = false;
+    route.clear();
+    routeIndex = 0;
+    caughtCount = 0;
+    currentMoveIndex = 0;
+    
+    const Body* body = getBody();
+    if (!body) {
+        if (logger) logger->logMessage("Error: No body to plan a collection route for");
+        return targets.size();
+    }
+    
+    TargetScheduler scheduler(world->getMemoryResource());
+    scheduler.setTimeBudget(timeBudget);
+    std::vector<CircleHandle> order;
+    size_t unreachable = scheduler.planRoute(*world, *body, targets, order);
+    route.assign(order.begin(), order.end());
+    if (logger) {
+        logger->logMessage("Planned route through " + std::to_string(route.size()) + " targets (" +
+                           std::to_string(unreachable) + " unreachable), length " +
+                           std::to_string(scheduler.getTourLength()));
+    }
+    
+    startNextTarget(*body);
+    return unreachable;
+}
+
+void WalkerStrategy::addCatchSequence(const Body& body, const Vector2D& objectPosition) {
     if (logger) {
         logger->logMessage("Planning catch sequence");
-        double distance = (objectPosition - body->getBasePosition()).magnitude();
+        double distance = (objectPosition - body.getBasePosition()).magnitude();
         logger->logMessage("Distance to object: " + std::to_string(distance));
     }
     
     // Plan walking to get close to the object
-    addWalkingSequence(objectPosition);
+    addWalkingSequence(body, objectPosition);
     
     // Plan reaching to grab the object
-    addReachingSequence(objectPosition);
+    addReachingSequence(body, objectPosition);
     
     if (logger) {
         logger->logMessage("Total planned moves: " + std::to_string(plannedMoves.size()));
     }
 }
 
+bool WalkerStrategy::startNextTarget(const Body& body) {
+    // Targets destroyed since the route was planned are passed over
+    for (; routeIndex < route.size(); routeIndex++) {
+        if (const Circle* next = world->getCircle(route[routeIndex])) {
+            setTarget(route[routeIndex]);
+            addCatchSequence(body, next->getCenter());
+            return true;
+        }
+    }
+    return false;
+}
+
 bool WalkerStrategy::executeNextMove() {
+    bool success = executeMove();
+    continueRoute();
+    return success;
+}
+
+bool WalkerStrategy::executeMove() {
     if (isSequenceComplete()) {
         return false;
     }
     
+    // Resolve the handles once per move
+    Body* body = getBody();
+    const Circle* target = getTarget();
+    if (!body) {
+        return false;
+    }
+    
     bool success = false;
-    Move currentMove = plannedMoves.front();
+    const Move currentMove = plannedMoves.front();
     plannedMoves.pop_front();
     
     switch (currentMove.type) {
         case Move::Type::WALK:
-            success = executeWalkMove(currentMove);
+            success = executeWalkMove(*body, currentMove);
             break;
         case Move::Type::REACH:
-            success = executeReachMove(currentMove);
+            success = executeReachMove(*body, currentMove);
             break;
         case Move::Type::GRAB:
             // Execute grab action
             // Check if we're in position to grab
-            if (body->canReachObject(*target, minObjectContacts)) {
+            if (target && body->canReachObject(*target, minObjectContacts)) {
                 objectCaught = true;
+                caughtCount++;
                 if (logger) logger->logMessage("Object caught successfully!");
                 success = true;
             } else {
@@ -81,6 +152,17 @@ bool WalkerStrategy::executeNextMove() {
     return success;
 }
 
+void WalkerStrategy::continueRoute() {
+    // On to the next target of a collection route
+    if (!plannedMoves.empty() || routeIndex + 1 >= route.size()) {
+        return;
+    }
+    if (const Body* body = getBody()) {
+        routeIndex++;
+        startNextTarget(*body);
+    }
+}
+
 bool WalkerStrategy::isSequenceComplete() const {
     return plannedMoves.empty();
 }
@@ -89,6 +171,14 @@ bool WalkerStrategy::hasObjectBeenCaught() const {
     return objectCaught;
 }
 
+size_t WalkerStrategy::getCaughtCount() const {
+    return caughtCount;
+}
+
+const std::pmr::vector<CircleHandle>& WalkerStrategy::getRoute() const {
+    return route;
+}
+
 void WalkerStrategy::setWalkSpeed(double speed) {
     walkSpeed = speed;
 }
@@ -97,12 +187,24 @@ double WalkerStrategy::getWalkSpeed() const {
     return walkSpeed;
 }
 
-void WalkerStrategy::addWalkingSequence(const Vector2D& targetPos) {
-    // Calculate number of walking steps to reach close to the target
-    Vector2D startPos = body->getBasePosition();
-    double distance = (targetPos - startPos).magnitude();
-    double reachDistance = 50.0; // Distance at which we start reaching
-    double walkingDistance = distance - reachDistance;
+void WalkerStrategy::addWalkingSequence(const Body& body, const Vector2D& targetPos) {
+    // Around the obstacles when the level has a navigation grid
+    if (world->hasNavigationGrid()) {
+        std::vector<Vector2D> waypoints;
+        if (!world->planPath(body.getBasePosition(), targetPos, waypoints)) {
+            if (logger) logger->logMessage("No walkable path to the object");
+            return;
+        }
+        addWalkingPath(body, waypoints);
+        return;
+    }
+    
+    // Calculate number of walking steps to reach close to the target, along
+    // the ground (the body's feet stay on it; the arms reach the height)
+    Vector2D startPos = body.getBasePosition();
+    Vector2D groundPos(targetPos.x, startPos.y);
+    double distance = (groundPos - startPos).magnitude();
+    double walkingDistance = distance - getReachDistance(body);
     
     if (walkingDistance <= 0) {
         // Already close enough, no walking needed
@@ -110,7 +212,7 @@ void WalkerStrategy::addWalkingSequence(const Vector2D& targetPos) {
     }
     
     int numWalkingSteps = static_cast<int>(walkingDistance / walkSpeed);
-    Vector2D stepVector = (targetPos - startPos).normalize() * walkSpeed;
+    Vector2D stepVector = (groundPos - startPos).normalize() * walkSpeed;
     
     // Add walking moves
     for (int i = 0; i < numWalkingSteps; i++) {
@@ -125,31 +227,62 @@ void WalkerStrategy::addWalkingSequence(const Vector2D& targetPos) {
     }
 }
 
-void WalkerStrategy::addReachingSequence(const Vector2D& targetPos) {
-    // Add reaching moves for arms
-    std::vector<std::string> reachingSegments = {"left_lower_arm", "right_lower_arm", "left_hand", "right_hand"};
-    int reachingSteps = 0;
+void WalkerStrategy::addWalkingPath(const Body& body, const std::vector<Vector2D>& waypoints) {
+    // Steps of walkSpeed along the waypoints, stopping within reach of the last one
+    double reachDistance = getReachDistance(body);
+    double pathLength = 0.0;
+    Vector2D previous = body.getBasePosition();
+    for (const Vector2D& waypoint : waypoints) {
+        pathLength += (waypoint - previous).magnitude();
+        previous = waypoint;
+    }
+    double walkingDistance = pathLength - reachDistance;
+    if (walkingDistance <= 0) {
+        return;
+    }
+    
+    int numWalkingSteps = static_cast<int>(walkingDistance / walkSpeed);
+    Vector2D position = body.getBasePosition();
+    size_t next = 0;
+    for (int i = 0; i < numWalkingSteps; i++) {
+        double step = walkSpeed;
+        while (step > 0 && next < waypoints.size()) {
+            Vector2D toWaypoint = waypoints[next] - position;
+            double length = toWaypoint.magnitude();
+            if (length > step) {
+                position = position + toWaypoint * (step / length);
+                break;
+            }
+            position = waypoints[next++];
+            step -= length;
+        }
+        
+        Move walkMove;
+        walkMove.type = Move::Type::WALK;
+        walkMove.position = position;
+        plannedMoves.push_back(walkMove);
+    }
     
-    for (const auto& segmentName : reachingSegments) {
+    if (logger) {
+        logger->logMessage("Added walking path: " + std::to_string(numWalkingSteps) + " moves via " +
+                           std::to_string(waypoints.size()) + " waypoints");
+    }
+}
+
+void WalkerStrategy::addReachingSequence(const Body& body, const Vector2D& targetPos) {
+    // One move per arm, aimed when it runs (the walk has moved the shoulders)
+    int reachingSteps = 0;
+    for (size_t arm = 0; arm < kArmCount; arm++) {
+        if (body.getSegmentIndex(kArms[arm][0]) == Body::kNoSegment) {
+            continue;
+        }
+        
         Move reachMove;
         reachMove.type = Move::Type::REACH;
-        reachMove.segmentName = segmentName;
         reachMove.position = targetPos;
-        
-        // Calculate appropriate rotation to point toward the target
-        auto segment = body->getSegment(segmentName);
-        if (segment) {
-            Vector2D toTarget = targetPos - segment->getStart();
-            double targetAngle = std::atan2(toTarget.y, toTarget.x);
-            reachMove.rotationAmount = targetAngle - segment->getAngle();
-            
-            // Normalize rotation to be between -PI and PI
-            while (reachMove.rotationAmount > M_PI) reachMove.rotationAmount -= 2 * M_PI;
-            while (reachMove.rotationAmount < -M_PI) reachMove.rotationAmount += 2 * M_PI;
-            
-            plannedMoves.push_back(reachMove);
-            reachingSteps++;
-        }
+        reachMove.arm = arm;
+        plannedMoves.push_back(reachMove);
+        reachingSteps++;
     }
     
     // Finally, add a grab move
@@ -162,29 +295,78 @@ void WalkerStrategy::addReachingSequence(const Vector2D& targetPos) {
     }
 }
 
-bool WalkerStrategy::executeWalkMove(const Move& move) {
-    if (!body->hasMinimumGroundContacts(minGroundContacts)) {
+bool WalkerStrategy::executeWalkMove(Body& body, const Move& move) {
+    if (!body.hasMinimumGroundContacts(minGroundContacts)) {
         if (logger) logger->logMessage("Cannot move - insufficient ground contacts");
         return false;
     }
     
-    // Move the body base to the new position
-    body->moveBaseTo(move.position);
+    // Move the body base to the new position, keeping the base as high
+    // above the ground as it is now (over slopes too), so the feet stay down
+    Vector2D target = move.position;
+    const Terrain& terrain = body.getTerrain();
+    Vector2D base = body.getBasePosition();
+    target.y = terrain.getHeightAt(target.x) - (terrain.getHeightAt(base.x) - base.y);
+    body.moveBaseTo(target);
     return true;
 }
 
-bool WalkerStrategy::executeReachMove(const Move& move) {
-    if (!body->hasMinimumGroundContacts(minGroundContacts)) {
+bool WalkerStrategy::executeReachMove(Body& body, const Move& move) {
+    if (!body.hasMinimumGroundContacts(minGroundContacts)) {
         if (logger) logger->logMessage("Cannot reach - insufficient ground contacts");
         return false;
     }
     
-    auto segment = body->getSegment(move.segmentName);
-    if (!segment) {
-        if (logger) logger->logMessage("Segment not found: " + move.segmentName);
+    if (!reachWithArm(body, move.arm, move.position)) {
+        if (logger) logger->logMessage("Reach rejected - " + std::string(kArms[move.arm][0]) + " would collide");
+        return false;
+    }
+    return true;
+}
+
+template <typename Scalar>
+Scalar WalkerStrategy::getReachDistance(const BasicBody<Scalar>& body) {
+    Scalar length = 0;
+    for (size_t i = 0; i < kArmSegments; i++) {
+        const BasicSegment<Scalar>* segment = body.getSegment(kArms[kArmCount - 1][i]);
+        if (!segment) {
+            return 50.0;    // Not a humanoid: walk up close
+        }
+        length += (i + 1 < kArmSegments) ? segment->getLength() : segment->getLength() / 2;
+    }
+    return length;
+}
+
+template <typename Scalar>
+bool WalkerStrategy::reachWithArm(BasicBody<Scalar>& body, size_t arm, const BasicVector2D<Scalar>& target) {
+    const BasicSegment<Scalar>* shoulder = body.getSegment(kArms[arm][0]);
+    const BasicSegment<Scalar>* hand = body.getSegment(kArms[arm][kArmSegments - 1]);
+    if (!shoulder || !hand) {
         return false;
     }
     
-    // Rotate the segment toward the target
-    return body->rotateSegment(move.segmentName, move.rotationAmount);
-}
\ No newline at end of file
+    // Turning the segments one at a time would fold the arm over itself on
+    // the way, so the whole arm turns before the collision check
+    Scalar offset = hand->getLength() / 2;
+    BasicVector2D<Scalar> aim = target + BasicVector2D<Scalar>(0, arm == 0 ? -offset : offset);
+    BasicVector2D<Scalar> toAim = aim - shoulder->getStart();
+    Scalar angle = std::atan2(toAim.y, toAim.x);
+    size_t collisionsBefore = body.findSelfCollisions({});
+    Scalar previousAngles[kArmSegments];
+    for (size_t i = 0; i < kArmSegments; i++) {
+        previousAngles[i] = body.getSegment(kArms[arm][i])->getAngle();
+        body.rotateSegmentTo(kArms[arm][i], angle);
+    }
+    if (body.findSelfCollisions({}) > collisionsBefore) {
+        for (size_t i = 0; i < kArmSegments; i++) {
+            body.rotateSegmentTo(kArms[arm][i], previousAngles[i]);
+        }
+        return false;
+    }
+    return true;
+}
+
+template float WalkerStrategy::getReachDistance(const BasicBody<float>&);
+template double WalkerStrategy::getReachDistance(const BasicBody<double>&);
+template bool WalkerStrategy::reachWithArm(BasicBody<float>&, size_t, const BasicVector2D<float>&);
+template bool WalkerStrategy::reachWithArm(BasicBody<double>&, size_t, const BasicVector2D<double>&);
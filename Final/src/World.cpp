@@ -0,0 +1,816 @@
+/**
+ * @file World.cpp
+ * @brief Implementation of the World class
+ */
+#include "../include/World.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace {
+// Furthest ahead an impact is predicted; later ones are re-predicted on arrival
+constexpr uint64_t kMaxPredictedTicks = uint64_t(1) << 24;
+// Ticks scanned for a target impact before settling for a re-check then
+constexpr uint64_t kMaxTargetScanTicks = 1024;
+// Range sizes of the parallel tick phases (fixed, so results do not depend on the thread count)
+constexpr size_t kWalkerGrain = 4;              // Walkers; a move can test every segment pair
+constexpr size_t kIntegrateChunkGrain = 16;     // Projectile chunks
+constexpr size_t kDetectionGrain = 2048;        // Projectiles
+}
+
+World::World(std::pmr::memory_resource* resource)
+    : resource(resource), bodies(resource), circles(resource), walkers(resource),
+      projectiles(resource), obstacles(resource), jobs(&JobSystem::shared()), movingWalkers(resource),
+      bodyWalkers(resource), detectedImpacts(resource), segmentGrid(64.0, resource), projectileGrid(64.0, resource),
+      gridSegments(resource), circleTree(resource), circleLeaves(resource), spatialIndexStale(true), terrain(400.0), terrainSet(false),
+      navigationGrid(resource), pathPlanner(resource), navigationClearance(0.0),
+      impactEvents(resource), impacts(resource), impactEventsEnabled(false), impactEventsStale(false),
+      impactTimeStep(0.0), maxTargetSpeed(0.0), tickCount(0), processedImpactEvents(0), timers(resource),
+      gravity(9.8), projectileHits(0), projectileMisses(0) {
+}
+
+BodyHandle World::createBody(const Vector2D& basePosition, double groundLevel) {
+    spatialIndexStale = true;
+    BodyHandle handle = bodies.create(basePosition, groundLevel, resource);
+    if (terrainSet) {
+        bodies.get(handle)->setTerrain(terrain);
+    }
+    return handle;
+}
+
+CircleHandle World::createCircle(const Vector2D& center, double radius) {
+    spatialIndexStale = true;
+    CircleHandle handle = circles.create(center, radius);
+    
+    // Leaf box is set when the tree is next refitted
+    if (circleLeaves.size() <= handle.index) {
+        circleLeaves.resize(handle.index + 1, AabbTree::kNullNode);
+    }
+    circleLeaves[handle.index] = circleTree.insert(handle.index, Aabb::fromCircle(center, static_cast<Real>(radius)));
+    return handle;
+}
+
+bool World::destroyBody(BodyHandle handle) {
+    spatialIndexStale = true;
+    return bodies.destroy(handle);
+}
+
+bool World::destroyCircle(CircleHandle handle) {
+    spatialIndexStale = true;
+    if (!circles.destroy(handle)) {
+        return false;
+    }
+    circleTree.remove(circleLeaves[handle.index]);
+    circleLeaves[handle.index] = AabbTree::kNullNode;
+    return true;
+}
+
+ObstacleHandle World::createObstacle(const Obstacle& obstacle) {
+    ObstacleHandle handle = obstacles.create(obstacle);
+    navigationGrid.markObstacle(obstacle, static_cast<Real>(navigationClearance));
+    return handle;
+}
+
+bool World::destroyObstacle(ObstacleHandle handle) {
+    const Obstacle* obstacle = obstacles.get(handle);
+    if (!obstacle) {
+        return false;
+    }
+    Aabb oldBounds = getMarkedBounds(*obstacle);
+    obstacles.destroy(handle);
+    redrawObstacleCells(oldBounds);
+    return true;
+}
+
+bool World::moveObstacle(ObstacleHandle handle, const Vector2D& center) {
+    Obstacle* obstacle = obstacles.get(handle);
+    if (!obstacle) {
+        return false;
+    }
+    Aabb oldBounds = getMarkedBounds(*obstacle);
+    obstacle->center = center;
+    redrawObstacleCells(oldBounds);
+    navigationGrid.markObstacle(*obstacle, static_cast<Real>(navigationClearance));
+    return true;
+}
+
+void World::setNavigationGrid(const Vector2D& origin, double cellSize, int width, int height, double clearance) {
+    navigationClearance = clearance;
+    navigationGrid.resize(origin, static_cast<Real>(cellSize), width, height);
+    obstacles.forEach([&](ObstacleHandle, const Obstacle& obstacle) {
+        navigationGrid.markObstacle(obstacle, static_cast<Real>(navigationClearance));
+    });
+}
+
+const OccupancyGrid& World::getNavigationGrid() const {
+    return navigationGrid;
+}
+
+bool World::hasNavigationGrid() const {
+    return !navigationGrid.isEmpty();
+}
+
+bool World::planPath(const Vector2D& from, const Vector2D& to, std::vector<Vector2D>& waypoints) {
+    if (navigationGrid.isEmpty()) {
+        waypoints.assign(1, to);
+        return true;
+    }
+    return pathPlanner.planPath(navigationGrid, from, to, waypoints);
+}
+
+Aabb World::getMarkedBounds(const Obstacle& obstacle) const {
+    Aabb bounds = obstacle.getBounds();
+    Vector2D clearance(static_cast<Real>(navigationClearance), static_cast<Real>(navigationClearance));
+    return Aabb{bounds.min - clearance, bounds.max + clearance};
+}
+
+void World::redrawObstacleCells(const Aabb& box) {
+    if (navigationGrid.isEmpty()) {
+        return;
+    }
+    
+    // Cells partly inside box are cleared too, so restamp everything within a cell of it
+    navigationGrid.clearCells(box);
+    Vector2D cell(navigationGrid.getCellSize(), navigationGrid.getCellSize());
+    Aabb cleared{box.min - cell, box.max + cell};
+    obstacles.forEach([&](ObstacleHandle, const Obstacle& obstacle) {
+        if (getMarkedBounds(obstacle).overlaps(cleared)) {
+            navigationGrid.markObstacle(obstacle, static_cast<Real>(navigationClearance));
+        }
+    });
+}
+
+WalkerHandle World::addWalker(BodyHandle body, CircleHandle target, double walkSpeed) {
+    if (!isBodyFree(body)) {
+        return WalkerHandle{};
+    }
+    WalkerHandle handle = walkers.create(*this, body, target, walkSpeed);
+    bodyWalkers[body.index] = BodyWalker{body, handle};
+    walkers.get(handle)->planSequence();
+    return handle;
+}
+
+WalkerHandle World::addWalker(BodyHandle body, std::span<const CircleHandle> targets, double walkSpeed) {
+    if (!isBodyFree(body)) {
+        return WalkerHandle{};
+    }
+    WalkerHandle handle = walkers.create(*this, body, CircleHandle(), walkSpeed);
+    bodyWalkers[body.index] = BodyWalker{body, handle};
+    walkers.get(handle)->planCollection(targets);
+    return handle;
+}
+
+bool World::isBodyFree(BodyHandle body) {
+    // Walkers move in parallel, each writing only its own body
+    if (bodyWalkers.size() <= body.index) {
+        bodyWalkers.resize(body.index + 1);
+    }
+    const BodyWalker& entry = bodyWalkers[body.index];
+    if (entry.body == body && walkers.get(entry.walker)) {
+        std::cerr << "Body " << body.index << " already has a walker" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool World::removeWalker(WalkerHandle handle) {
+    return walkers.destroy(handle);
+}
+
+ProjectileHandle World::throwSnowball(BodyHandle thrower, CircleHandle target, double radius) {
+    const Body* body = getBody(thrower);
+    const Circle* targetCircle = getCircle(target);
+    if (!body || !targetCircle) {
+        return ProjectileHandle{};
+    }
+
+    spatialIndexStale = true;
+
+    // Released above the body base on a parabola through the target
+    // (same trajectory as SnowballStrategy)
+    Vector2D position(body->getBasePosition().x, body->getBasePosition().y - 50.0);
+    Vector2D targetPos = targetCircle->getCenter();
+    double dx = targetPos.x - position.x;
+    double dy = targetPos.y - position.y;
+    double time = std::sqrt(2 * std::abs(dx) / gravity);
+    if (time <= 0) {
+        time = 1.0;   // Target straight above or below: plain vertical throw
+    }
+    Vector2D velocity(dx / time, -gravity * time / 2 + dy / time);
+
+    return createProjectile(ProjectileState{position, velocity, static_cast<Real>(radius),
+                                            body->getGroundLevel(), target, thrower,
+                                            ProjectileStatus::FLYING});
+}
+
+ProjectileHandle World::createProjectile(const ProjectileState& state) {
+    spatialIndexStale = true;
+    ProjectileHandle handle = projectiles.create(state);
+    if (impactEventsEnabled) {
+        predictImpacts(projectiles.getIndex(handle));
+    }
+    return handle;
+}
+
+bool World::destroyProjectile(ProjectileHandle handle) {
+    spatialIndexStale = true;
+    return projectiles.destroy(handle);
+}
+
+std::optional<ProjectileState> World::getProjectile(ProjectileHandle handle) const {
+    return projectiles.get(handle);
+}
+
+size_t World::removeFinishedProjectiles() {
+    spatialIndexStale = true;
+    size_t removed = 0;
+
+    // Walk backwards so the swap-with-last removal never skips an entry
+    for (size_t i = projectiles.size(); i-- > 0;) {
+        if (projectiles.getStatusAt(i) != ProjectileStatus::FLYING) {
+            projectiles.destroy(projectiles.getHandleAt(i));
+            removed++;
+        }
+    }
+    return removed;
+}
+
+void World::step(double timeStep) {
+    spatialIndexStale = true;
+    impacts.clear();
+
+    moveWalkers();
+
+    // All projectiles in one pass over the packed arrays, then collisions
+    if (impactEventsEnabled && (impactEventsStale || timeStep != impactTimeStep)) {
+        impactTimeStep = timeStep;
+        rebuildImpactEvents();
+    }
+    Real dt = static_cast<Real>(timeStep);
+    Real g = static_cast<Real>(gravity);
+    jobs->parallelFor(0, projectiles.getTable().getChunkCount(), kIntegrateChunkGrain,
+                      [this, dt, g](size_t first, size_t last) { projectiles.integrate(dt, g, first, last); });
+    tickCount++;
+    if (impactEventsEnabled) {
+        processImpactEvents();
+    } else {
+        resolveProjectileHits(dt);
+    }
+    timers.advanceTo(tickCount);
+}
+
+uint64_t World::advanceToNextImpact(double timeStep, uint64_t maxTicks) {
+    if (!impactEventsEnabled || walkers.size() > 0 || maxTicks <= 1) {
+        step(timeStep);
+        return 1;
+    }
+    spatialIndexStale = true;
+    impacts.clear();
+    if (impactEventsStale || timeStep != impactTimeStep) {
+        impactTimeStep = timeStep;
+        rebuildImpactEvents();
+    }
+
+    // Nothing can happen before the next event or timer, so nothing is looked at
+    uint64_t next = std::min(impactEvents.getNextTick(), timers.getEarliestDue());
+    uint64_t ticks = next > tickCount ? std::min(next - tickCount, maxTicks) : 1;
+    projectiles.advance(static_cast<Real>(timeStep), static_cast<Real>(gravity), ticks);
+    tickCount += ticks;
+    processImpactEvents();
+    timers.advanceTo(tickCount);
+    return ticks;
+}
+
+TimerHandle World::scheduleTimer(uint64_t ticks, uint64_t payload) {
+    return timers.schedule(ticks, payload);
+}
+
+bool World::cancelTimer(TimerHandle timer) {
+    return timers.cancel(timer);
+}
+
+bool World::isTimerPending(TimerHandle timer) const {
+    return timers.isPending(timer);
+}
+
+std::span<const ExpiredTimer> World::getDueTimers() const {
+    return timers.getExpired();
+}
+
+uint64_t World::getTickCount() const {
+    return tickCount;
+}
+
+void World::enableImpactEvents(double maxTargetSpeed) {
+    impactEventsEnabled = true;
+    impactEventsStale = true;
+    this->maxTargetSpeed = maxTargetSpeed;
+}
+
+void World::disableImpactEvents() {
+    impactEventsEnabled = false;
+    impactEvents.clear();
+}
+
+bool World::usesImpactEvents() const {
+    return impactEventsEnabled;
+}
+
+size_t World::getPendingImpactEvents() const {
+    return impactEvents.size();
+}
+
+size_t World::getProcessedImpactEvents() const {
+    return processedImpactEvents;
+}
+
+std::span<const ProjectileImpact> World::getImpacts() const {
+    return impacts;
+}
+
+void World::setTerrain(const Terrain& terrain) {
+    this->terrain = terrain;
+    terrainSet = true;
+    impactEventsStale = true;
+    bodies.forEach([&](BodyHandle, Body& body) {
+        body.setTerrain(terrain);
+    });
+}
+
+const Terrain& World::getTerrain() const {
+    return terrain;
+}
+
+bool World::hasTerrain() const {
+    return terrainSet;
+}
+
+void World::moveWalkers() {
+    // Kinematics: each walker moves only its own body
+    movingWalkers.clear();
+    walkers.forEach([this](WalkerHandle, WalkerStrategy& walker) {
+        if (!walker.isSequenceComplete()) {
+            movingWalkers.push_back(&walker);
+        }
+    });
+    size_t grain = (resource == std::pmr::new_delete_resource()) ? kWalkerGrain : movingWalkers.size();
+    jobs->parallelFor(0, movingWalkers.size(), grain, [this](size_t first, size_t last) {
+        for (size_t i = first; i < last; i++) {
+            movingWalkers[i]->executeMove();
+        }
+    });
+
+    // Plan: walkers out of moves head for their next target, in slot order
+    for (WalkerStrategy* walker : movingWalkers) {
+        walker->continueRoute();
+    }
+}
+
+void World::resolveProjectileHits(Real timeStep) {
+    // Buffers sized up front, so detection never allocates from the resource
+    size_t rangeCount = (projectiles.size() + kDetectionGrain - 1) / kDetectionGrain;
+    if (detectedImpacts.size() < rangeCount) {
+        detectedImpacts.resize(rangeCount);
+    }
+    for (size_t range = 0; range < rangeCount; range++) {
+        detectedImpacts[range].clear();
+        detectedImpacts[range].reserve(kDetectionGrain);
+    }
+
+    // Detection: ground first, then the target (as Snowball::update)
+    jobs->parallelFor(0, projectiles.size(), kDetectionGrain, [this, timeStep](size_t first, size_t last) {
+        std::pmr::vector<DetectedImpact>& detected = detectedImpacts[first / kDetectionGrain];
+        for (size_t i = first; i < last; i++) {
+            if (projectiles.getStatusAt(i) != ProjectileStatus::FLYING) {
+                continue;
+            }
+            if (hasHitGround(i, timeStep)) {
+                detected.push_back(DetectedImpact{static_cast<uint32_t>(i), ProjectileStatus::HIT_GROUND});
+                continue;
+            }
+            const Circle* target = getCircle(projectiles.getTargetAt(i));
+            if (target && target->intersects(Circle(projectiles.getPositionAt(i), projectiles.getRadiusAt(i)))) {
+                detected.push_back(DetectedImpact{static_cast<uint32_t>(i), ProjectileStatus::HIT_TARGET});
+            }
+        }
+    });
+
+    // Resolution in range order: the impacts come out as from one pass
+    for (size_t range = 0; range < rangeCount; range++) {
+        for (const DetectedImpact& impact : detectedImpacts[range]) {
+            recordImpact(impact.index, impact.status);
+        }
+    }
+}
+
+bool World::hasHitGround(size_t index, Real timeStep) const {
+    Real x = projectiles.getPositionAt(index).x;
+    Real y = projectiles.getPositionAt(index).y;
+    Real radius = projectiles.getRadiusAt(index);
+    if (!terrainSet) {
+        return y + radius >= projectiles.getGroundLevelAt(index);
+    }
+
+    // Along the whole step: integrate() moved x by vx * dt and y by the
+    // velocity from before gravity was applied
+    Vector2D velocity = projectiles.getVelocityAt(index);
+    Vector2D bottom(x, y + radius);
+    Vector2D previous = bottom - Vector2D(velocity.x, velocity.y - gravity * timeStep) * timeStep;
+    Real impact;
+    // Or already under it, after advanceToNextImpact() landed a rounding past the crossing
+    return terrain.intersectSegment(previous, bottom, impact) || bottom.y >= terrain.getHeightAt(bottom.x);
+}
+
+void World::recordImpact(size_t index, ProjectileStatus status) {
+    projectiles.setStatusAt(index, status);
+    if (status == ProjectileStatus::HIT_TARGET) {
+        projectileHits++;
+    } else {
+        projectileMisses++;
+    }
+    ProjectileHandle handle = projectiles.getHandleAt(index);
+    impacts.push_back(ProjectileImpact{handle, projectiles.getTargetAt(index), projectiles.getThrowerAt(index), status});
+
+    // The other kind of impact can no longer happen (a destroyed projectile's
+    // events are left for the generation check instead)
+    impactEvents.cancel(handle.index * 2);
+    impactEvents.cancel(handle.index * 2 + 1);
+}
+
+void World::rebuildImpactEvents() {
+    impactEvents.clear();
+    impactEventsStale = false;
+    for (size_t i = 0; i < projectiles.size(); i++) {
+        if (projectiles.getStatusAt(i) == ProjectileStatus::FLYING) {
+            predictGroundImpact(i);
+            predictTargetImpact(i);
+        }
+    }
+}
+
+void World::predictImpacts(size_t index) {
+    // Nothing to predict with until step() has fixed the time step
+    if (impactEventsStale || impactTimeStep <= 0.0) {
+        impactEventsStale = true;
+        return;
+    }
+    predictGroundImpact(index);
+    predictTargetImpact(index);
+}
+
+void World::predictGroundImpact(size_t index) {
+    Real dt = static_cast<Real>(impactTimeStep);
+    Real g = static_cast<Real>(gravity);
+    Real x = projectiles.getPositionAt(index).x;
+    Real y = projectiles.getPositionAt(index).y;
+    Vector2D velocity = projectiles.getVelocityAt(index);
+    Real radius = projectiles.getRadiusAt(index);
+    auto schedule = [&](uint64_t ticks) {
+        scheduleImpact(index, true, ticks);
+    };
+
+    if (terrainSet && !terrain.isFlat()) {
+        // Tick by tick with the same arithmetic as integrate() and
+        // hasHitGround(), so the prediction is the tick stepping would find
+        Real vy = velocity.y;
+        for (uint64_t k = 1; k <= kMaxPredictedTicks; k++) {
+            x += velocity.x * dt;
+            y += vy * dt;
+            vy += g * dt;
+            Vector2D bottom(x, y + radius);
+            Vector2D previous = bottom - Vector2D(velocity.x, vy - g * dt) * dt;
+            Real impact;
+            if (terrain.intersectSegment(previous, bottom, impact)) {
+                schedule(k);
+                return;
+            }
+        }
+        schedule(kMaxPredictedTicks);
+        return;
+    }
+
+    // Flat: the first k >= 1 with y + vy k dt + g dt^2 k (k - 1) / 2 + radius >= ground
+    double ground = terrainSet ? terrain.getGroundLevel() : projectiles.getGroundLevelAt(index);
+    double a = 0.5 * gravity * impactTimeStep * impactTimeStep;
+    double b = velocity.y * impactTimeStep - a;
+    double c = y + radius - ground;
+    auto isDown = [&](double k) {
+        return (a * k + b) * k + c >= 0.0;
+    };
+    double k;
+    if (isDown(1.0)) {
+        k = 1.0;
+    } else if (a > 0.0) {
+        k = std::ceil((-b + std::sqrt(b * b - 4.0 * a * c)) / (2.0 * a));
+        k = std::clamp(k, 1.0, static_cast<double>(kMaxPredictedTicks));
+        while (k < kMaxPredictedTicks && !isDown(k)) {
+            k++;
+        }
+        while (k > 1.0 && isDown(k - 1.0)) {
+            k--;
+        }
+    } else if (b > 0.0) {
+        k = std::clamp(std::ceil(-c / b), 1.0, static_cast<double>(kMaxPredictedTicks));
+    } else {
+        return;     // Never comes down
+    }
+    // One tick early, so rounding between this and integrate() can never make it late
+    schedule(std::max<uint64_t>(static_cast<uint64_t>(k) - 1, 1));
+}
+
+void World::predictTargetImpact(size_t index) {
+    const Circle* target = getCircle(projectiles.getTargetAt(index));
+    if (!target) {
+        return;
+    }
+    // The target stays within maxTargetSpeed * t of where it is now, so the
+    // first tick at which the projectile's arc comes that close is the
+    // earliest it could hit. Scanning the arc in closed form is a few
+    // operations per tick, against a heap event for every shortfall.
+    double dt = impactTimeStep;
+    double x = projectiles.getPositionAt(index).x - target->getCenter().x;
+    double y = projectiles.getPositionAt(index).y - target->getCenter().y;
+    Vector2D velocity = projectiles.getVelocityAt(index);
+    double contact = (projectiles.getRadiusAt(index) + target->getRadius()) * 1.01;
+    // A little slack for the rounding of integrate() against the closed form
+    double drift = (std::abs(velocity.x) + std::abs(velocity.y) + maxTargetSpeed) * dt * 1e-3;
+    // No further than the tick after the ground event (which may be one early)
+    uint32_t slot = projectiles.getHandleAt(index).index;
+    uint64_t groundTick = impactEvents.getTick(slot * 2);
+    uint64_t limit = groundTick != UINT64_MAX ? std::min(groundTick + 1 - tickCount, kMaxTargetScanTicks)
+                                              : kMaxTargetScanTicks;
+    for (uint64_t ticks = 1; ticks <= limit; ticks++) {
+        double k = static_cast<double>(ticks);
+        double dx = x + velocity.x * k * dt;
+        double dy = y + velocity.y * k * dt + 0.5 * gravity * dt * dt * k * (k - 1.0);
+        double reach = contact + (maxTargetSpeed * dt + drift) * k;
+        if (dx * dx + dy * dy <= reach * reach) {
+            scheduleImpact(index, false, ticks);
+            return;
+        }
+    }
+    // Lands first: no target event at all
+    if (limit == kMaxTargetScanTicks) {
+        scheduleImpact(index, false, limit);
+    } else {
+        impactEvents.cancel(slot * 2 + 1);
+    }
+}
+
+void World::scheduleImpact(size_t index, bool ground, uint64_t ticks) {
+    ProjectileHandle handle = projectiles.getHandleAt(index);
+    impactEvents.schedule(handle.index * 2 + (ground ? 0 : 1), handle.generation, tickCount + ticks);
+}
+
+void World::processImpactEvents() {
+    Real timeStep = static_cast<Real>(impactTimeStep);
+    while (impactEvents.getNextTick() <= tickCount) {
+        EventQueue::Event event = impactEvents.pop();
+        processedImpactEvents++;
+
+        // Destroyed (its slot perhaps reused) or already down since the event was predicted
+        size_t index = projectiles.getIndex(ProjectileHandle{event.id / 2, event.generation});
+        if (index == projectiles.size() || projectiles.getStatusAt(index) != ProjectileStatus::FLYING) {
+            continue;
+        }
+        if (event.id % 2 == 0) {
+            if (hasHitGround(index, timeStep)) {
+                recordImpact(index, ProjectileStatus::HIT_GROUND);
+            } else {
+                // Landing later than thought may give the target a chance after all
+                predictGroundImpact(index);
+                if (!impactEvents.isScheduled(event.id + 1)) {
+                    predictTargetImpact(index);
+                }
+            }
+            continue;
+        }
+        const Circle* target = getCircle(projectiles.getTargetAt(index));
+        if (!target) {
+            continue;
+        }
+        Circle projectile(projectiles.getPositionAt(index), projectiles.getRadiusAt(index));
+        if (target->intersects(projectile)) {
+            recordImpact(index, ProjectileStatus::HIT_TARGET);
+        } else {
+            predictTargetImpact(index);
+        }
+    }
+}
+
+size_t World::getBodyBasePositions(std::span<Vector2D> out) const {
+    size_t count = 0;
+    bodies.forEach([&](BodyHandle, const Body& body) {
+        if (count < out.size()) {
+            out[count++] = body.getBasePosition();
+        }
+    });
+    return count;
+}
+
+size_t World::getProjectilePositions(std::span<Vector2D> out) const {
+    size_t count = 0;
+    projectiles.getTable().forEachChunk<Transform>([&](size_t chunkSize, const Transform* transforms) {
+        for (size_t i = 0; i < chunkSize && count < out.size(); i++) {
+            out[count++] = transforms[i].position;
+        }
+    });
+    return count;
+}
+
+size_t World::findSegmentsTouchingCircle(const Circle& circle, std::span<SegmentRef> out) {
+    ensureSpatialIndex();
+
+    Vector2D center = circle.getCenter();
+    Real radius = circle.getRadius();
+    size_t count = 0;
+    segmentGrid.query(center - Vector2D(radius, radius), center + Vector2D(radius, radius),
+                      [&](uint32_t value) {
+        const SegmentRef& ref = gridSegments[value];
+        const Body* body = bodies.get(ref.body);
+        if (count < out.size() && body->getSegmentAt(ref.segment).distanceToPoint(center) <= radius) {
+            out[count++] = ref;
+        }
+    });
+    return count;
+}
+
+size_t World::findCirclesNear(const Vector2D& point, double radius, std::span<CircleHandle> out) {
+    ensureSpatialIndex();
+
+    Circle probe(point, radius);
+    size_t count = 0;
+    circleTree.query(Aabb::fromCircle(point, probe.getRadius()), [&](uint32_t slot) {
+        CircleHandle handle = circleHandleAt(slot);
+        if (count < out.size() && circles.get(handle)->intersects(probe)) {
+            out[count++] = handle;
+        }
+    });
+    return count;
+}
+
+CircleHandle World::findClosestCircle(const Vector2D& point) {
+    ensureSpatialIndex();
+
+    // Distance to the edge (0 inside), the same measure the box distance bounds
+    uint32_t slot;
+    Real distance;
+    bool found = circleTree.findClosest(point, [&](uint32_t s) {
+        const Circle* circle = circles.get(circleHandleAt(s));
+        return std::max(Real(0), circle->getCenter().distance(point) - circle->getRadius());
+    }, slot, distance);
+    return found ? circleHandleAt(slot) : CircleHandle{};
+}
+
+CircleHandle World::rayCastCircles(const Vector2D& from, const Vector2D& to) {
+    ensureSpatialIndex();
+
+    Vector2D delta = to - from;
+    Real a = delta.lengthSquared();
+    CircleHandle hitCircle;
+    circleTree.rayCast(from, to, [&](uint32_t slot, Real maxFraction) {
+        // Smallest s with |from + s * delta - center| = radius (0 if from is inside)
+        const Circle* circle = circles.get(circleHandleAt(slot));
+        Vector2D offset = from - circle->getCenter();
+        Real c = offset.lengthSquared() - circle->getRadius() * circle->getRadius();
+        Real s = maxFraction;
+        if (c <= 0) {
+            s = 0;
+        } else if (a > 0) {
+            Real b = offset.dot(delta);
+            Real discriminant = b * b - a * c;
+            if (discriminant >= 0) {
+                s = (-b - std::sqrt(discriminant)) / a;
+            }
+        }
+        if (s >= 0 && s < maxFraction) {
+            hitCircle = circleHandleAt(slot);
+            return s;
+        }
+        return maxFraction;
+    });
+    return hitCircle;
+}
+
+size_t World::findProjectilesNear(const Vector2D& point, double radius, std::span<ProjectileHandle> out) {
+    ensureSpatialIndex();
+
+    Circle probe(point, radius);
+    Vector2D extent(probe.getRadius(), probe.getRadius());
+    size_t count = 0;
+    projectileGrid.query(point - extent, point + extent, [&](uint32_t value) {
+        if (count < out.size() && probe.contains(projectiles.getPositionAt(value))) {
+            out[count++] = projectiles.getHandleAt(value);
+        }
+    });
+    return count;
+}
+
+void World::updateSpatialIndex() {
+    // Segments by bounding box
+    segmentGrid.clear();
+    gridSegments.clear();
+    bodies.forEach([&](BodyHandle handle, const Body& body) {
+        for (size_t i = 0; i < body.getSegmentCount(); i++) {
+            const Segment& segment = body.getSegmentAt(i);
+            Vector2D start = segment.getStart();
+            Vector2D end = segment.getEnd();
+            segmentGrid.insert(static_cast<uint32_t>(gridSegments.size()),
+                               Vector2D(std::min(start.x, end.x), std::min(start.y, end.y)),
+                               Vector2D(std::max(start.x, end.x), std::max(start.y, end.y)));
+            gridSegments.push_back(SegmentRef{handle, static_cast<uint32_t>(i)});
+        }
+    });
+    segmentGrid.build();
+
+    // Circles: new leaf boxes and one refit (rebuilt if the tree has degraded)
+    circles.forEach([&](CircleHandle handle, const Circle& circle) {
+        circleTree.update(circleLeaves[handle.index], Aabb::fromCircle(circle.getCenter(), circle.getRadius()));
+    });
+    circleTree.refit();
+
+    // Projectile centers (values are packed indices)
+    projectileGrid.clear();
+    uint32_t value = 0;
+    projectiles.getTable().forEachChunk<Transform>([&](size_t chunkSize, const Transform* transforms) {
+        for (size_t i = 0; i < chunkSize; i++, value++) {
+            projectileGrid.insert(value, transforms[i].position, transforms[i].position);
+        }
+    });
+    projectileGrid.build();
+
+    spatialIndexStale = false;
+}
+
+CircleHandle World::circleHandleAt(uint32_t slot) const {
+    return circles.handleAt(slot);
+}
+
+void World::ensureSpatialIndex() {
+    if (spatialIndexStale) {
+        updateSpatialIndex();
+    }
+}
+
+WorldStats World::getStats() const {
+    WorldStats stats{bodies.size(), circles.size(), walkers.size(), 0, 0, 0, projectileHits, projectileMisses};
+    walkers.forEach([&](WalkerHandle, const WalkerStrategy& walker) {
+        stats.walkersMoving += walker.isSequenceComplete() ? 0 : 1;
+        stats.targetsCaught += walker.hasObjectBeenCaught() ? 1 : 0;
+    });
+    for (size_t i = 0; i < projectiles.size(); i++) {
+        stats.projectilesFlying += (projectiles.getStatusAt(i) == ProjectileStatus::FLYING) ? 1 : 0;
+    }
+    return stats;
+}
+
+size_t World::getBodyCount() const {
+    return bodies.size();
+}
+
+size_t World::getCircleCount() const {
+    return circles.size();
+}
+
+size_t World::getWalkerCount() const {
+    return walkers.size();
+}
+
+size_t World::getProjectileCount() const {
+    return projectiles.size();
+}
+
+size_t World::getObstacleCount() const {
+    return obstacles.size();
+}
+
+double World::getGravity() const {
+    return gravity;
+}
+
+void World::setGravity(double gravity) {
+    this->gravity = gravity;
+    impactEventsStale = true;
+}
+
+std::pmr::memory_resource* World::getMemoryResource() const {
+    return resource;
+}
+
+JobSystem* World::getJobSystem() const {
+    return jobs;
+}
+
+void World::setJobSystem(JobSystem* jobs) {
+    this->jobs = jobs;
+}
+
+double World::getGridCellSize() const {
+    return segmentGrid.getCellSize();
+}
+
+void World::setGridCellSize(double cellSize) {
+    segmentGrid.setCellSize(static_cast<Real>(cellSize));
+    projectileGrid.setCellSize(static_cast<Real>(cellSize));
+    spatialIndexStale = true;
+}